@@ -0,0 +1,183 @@
+#include "kernels.h"
+#include "perf_counters.h"
+
+#include "arviss/arviss.h"
+#include "arviss/blocks/blocks.h"
+#include "arviss/jit/jit.h"
+#include "arviss/platforms/basic/basic.h"
+#include "arviss/platforms/cow/cow.h"
+#include "arviss/platforms/flat/flat.h"
+#include "arviss/platforms/mapped/mapped.h"
+#include "arviss/remix/remix.h"
+#include "arviss/rv32/rv32.h"
+#include "arviss/sched/scheduler.h"
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+using namespace arviss;
+using namespace arviss::platforms;
+
+namespace
+{
+    constexpr size_t budget = 100000000; // More than any kernel needs to reach its ebreak.
+
+    // An RV32imf CPU whose dispatcher advances its program counter.
+    template<HasMemory Mem>
+    using Rv32imfSequentialCpu = Rv32imfDispatcher<Rv32imfExecutor<SequentialFloatCore<Mem>>>;
+
+    // An RV32imf CPU with stop events.
+    template<HasMemory Mem>
+    using Rv32imfPreemptibleCpu = Rv32imfDispatcher<Rv32imfExecutor<Preemptible<FloatCore<Mem>>>>;
+
+    // An RV32imf CPU that doesn't keep x0 at zero, for the Remix dispatchers.
+    template<HasMemory Mem>
+    using Rv32imfZeroSinkCpu = Rv32imfDispatcher<Rv32imfExecutor<ZeroSink<FloatCore<Mem>>>>;
+
+    template<typename Cpu>
+    auto Run(Cpu& cpu) -> void
+    {
+        cpu.ClearTraps();
+        cpu.SetNextPc(0);
+        sched::RunFor(cpu, budget);
+    }
+
+    template<typename Cpu>
+    auto Load(Cpu& cpu, const bench::Kernel& kernel) -> void
+    {
+#if ARVISS_HAS_FLAT_MEMORY
+        if constexpr (std::derived_from<Cpu, flat::Memory>)
+        {
+            cpu.Map(0, basic::MEM_SIZE);
+        }
+#endif
+        for (size_t i = 0; i < kernel.code.size(); i++)
+        {
+            cpu.Write32Unprotected(static_cast<Address>(i * 4), kernel.code[i]);
+        }
+        for (const auto& data : kernel.data)
+        {
+            cpu.LoadImage(data.address, data.bytes);
+        }
+    }
+
+    // Returns the number of instructions that `kernel` retires on `Cpu`, which must count them one at a time.
+    template<typename Cpu>
+    auto Count(const bench::Kernel& kernel) -> u64
+    {
+        auto cpu = std::make_unique<Cpu>();
+        Load(*cpu, kernel);
+        cpu->SetNextPc(0);
+        return sched::RunFor(*cpu, budget);
+    }
+
+    // Returns the number of instructions that `kernel` retires, counted by a reference interpreter. CPUs with their own
+    // run loops don't report an exact count.
+    auto InstructionsRetired(const bench::Kernel& kernel) -> u64
+    {
+        static std::map<const bench::Kernel*, u64> retired;
+        auto it = retired.find(&kernel);
+        if (it == retired.end())
+        {
+            const auto n = kernel.usesCompressed ? Count<Rv32icCpu<basic::MemoryNoIO>>(kernel) : Count<Rv32imfCpu<basic::MemoryNoIO>>(kernel);
+            it = retired.emplace(&kernel, n).first;
+        }
+        return it->second;
+    }
+
+    // Runs `kernel` on `Cpu` once per iteration.
+    template<typename Cpu>
+    auto RunKernel(benchmark::State& state, const bench::Kernel& kernel) -> void
+    {
+        const auto instructions = InstructionsRetired(kernel);
+        auto cpu = std::make_unique<Cpu>();
+        Load(*cpu, kernel);
+
+        bench::PerfCounters perf;
+        perf.Start();
+        for (auto _ : state)
+        {
+            Run(*cpu);
+        }
+        perf.Stop();
+
+        if (!cpu->IsTrapped() || cpu->TrapCause()->type_ != TrapType::Breakpoint || cpu->Rx(bench::a0) != kernel.expected)
+        {
+            state.SkipWithError("the kernel gave the wrong result");
+            return;
+        }
+
+        const auto retired = static_cast<double>(instructions) * static_cast<double>(state.iterations());
+        state.SetItemsProcessed(static_cast<int64_t>(retired));
+        state.counters["MIPS"] = benchmark::Counter(retired / 1e6, benchmark::Counter::kIsRate);
+        if (perf.IsAvailable())
+        {
+            state.counters["CPI"] = static_cast<double>(perf.Cycles()) / retired;
+            state.counters["misses/kI"] = 1000.0 * static_cast<double>(perf.CacheMisses()) / retired;
+        }
+    }
+
+    template<typename Cpu>
+    auto Register(const std::string& cpuName) -> void
+    {
+        for (const auto& kernel : bench::Kernels())
+        {
+            if ((!kernel.usesFloat || IsRv32fHandler<Cpu>) && (!kernel.usesCompressed || IsRv32cHandler<Cpu>))
+            {
+                benchmark::RegisterBenchmark((cpuName + "/" + kernel.name).c_str(), RunKernel<Cpu>, std::cref(kernel))->Unit(benchmark::kMillisecond);
+            }
+        }
+    }
+} // namespace
+
+// Run with `--benchmark_format=json` or `--benchmark_out=<file>` to keep results for comparison between releases, e.g.,
+// with Google Benchmark's `compare.py`. CPI (host cycles per guest instruction) and cache misses per thousand guest
+// instructions are only reported where the host's hardware performance counters are available.
+auto main(int argc, char** argv) -> int
+{
+    // Dispatchers.
+    Register<Rv32iCpu<basic::MemoryNoIO>>("Rv32iDispatcher");
+    Register<Rv32icCpu<basic::MemoryNoIO>>("Rv32icDispatcher");
+    Register<Rv32imfCpu<basic::MemoryNoIO>>("Rv32imfDispatcher");
+    Register<Rv32iTableCpu<basic::MemoryNoIO>>("Rv32iTableDispatcher");
+    Register<Rv32icTableCpu<basic::MemoryNoIO>>("Rv32icTableDispatcher");
+    Register<Rv32imfTableCpu<basic::MemoryNoIO>>("Rv32imfTableDispatcher");
+    Register<remix::RemixDispatcher<Rv32imfCpu<basic::MemoryNoIO>>>("RemixDispatcher");
+    Register<remix::ThreadedRemixDispatcher<Rv32imfCpu<basic::MemoryNoIO>>>("ThreadedRemixDispatcher");
+    Register<remix::TailCallRemixDispatcher<Rv32imfCpu<basic::MemoryNoIO>>>("TailCallRemixDispatcher");
+    Register<blocks::BlockCacheDispatcher<Rv32imfCpu<basic::MemoryNoIO>>>("BlockCacheDispatcher");
+#if ARVISS_HAS_X86_64_JIT
+    Register<jit::JitDispatcher<Rv32imfCpu<basic::MemoryNoIO>>>("JitDispatcher");
+#endif
+
+    // Cores.
+    Register<Rv32imfSequentialCpu<basic::MemoryNoIO>>("Rv32imfDispatcher<SequentialCore>");
+    Register<remix::TailCallRemixDispatcher<Rv32imfSequentialCpu<basic::MemoryNoIO>>>("TailCallRemixDispatcher<SequentialCore>");
+    Register<Rv32imfPreemptibleCpu<basic::MemoryNoIO>>("Rv32imfDispatcher<Preemptible>");
+    Register<remix::TailCallRemixDispatcher<Rv32imfPreemptibleCpu<basic::MemoryNoIO>>>("TailCallRemixDispatcher<Preemptible>");
+    Register<remix::ThreadedRemixDispatcher<Rv32imfZeroSinkCpu<basic::MemoryNoIO>>>("ThreadedRemixDispatcher<ZeroSink>");
+    Register<remix::TailCallRemixDispatcher<Rv32imfZeroSinkCpu<basic::MemoryNoIO>>>("TailCallRemixDispatcher<ZeroSink>");
+
+    // Memory models.
+    Register<Rv32imfCpu<basic::NonThrowingMemoryNoIO>>("Rv32imfDispatcher<NonThrowingMemory>");
+    Register<Rv32imfCpu<cow::MemoryNoIO>>("Rv32imfDispatcher<cow::Memory>");
+    Register<remix::ThreadedRemixDispatcher<Rv32imfCpu<cow::MemoryNoIO>>>("ThreadedRemixDispatcher<cow::Memory>");
+    Register<Rv32imfCpu<mapped::BasicMemoryNoIO>>("Rv32imfDispatcher<mapped::BasicMemory>");
+    Register<remix::ThreadedRemixDispatcher<Rv32imfCpu<mapped::BasicMemoryNoIO>>>("ThreadedRemixDispatcher<mapped::BasicMemory>");
+#if ARVISS_HAS_FLAT_MEMORY
+    Register<Rv32imfCpu<flat::Memory>>("Rv32imfDispatcher<flat::Memory>");
+    Register<remix::ThreadedRemixDispatcher<Rv32imfCpu<flat::Memory>>>("ThreadedRemixDispatcher<flat::Memory>");
+#endif
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "arviss/arviss.h"
+
+#include <optional>
+#include <vector>
+
+namespace arviss::bench
+{
+    // Register names.
+    enum : Reg
+    {
+        zero = 0,
+        ra = 1,
+        sp = 2,
+        t0 = 5,
+        t1 = 6,
+        t2 = 7,
+        s0 = 8,
+        s1 = 9,
+        a0 = 10,
+        a1 = 11,
+        a2 = 12,
+        a3 = 13,
+        a4 = 14,
+        s2 = 18,
+        s3 = 19,
+    };
+
+    // Floating point register names.
+    enum : Reg
+    {
+        ft0 = 0,
+        ft1 = 1,
+        ft2 = 2,
+    };
+
+    // Just enough of an RV32imf assembler to write the benchmark kernels without a cross toolchain. Code starts at
+    // address 0. Branches and jumps can refer to labels before they're bound, and are patched by Finish().
+    class Assembler
+    {
+        struct Fixup
+        {
+            size_t index; // The index of the branch or jump.
+            size_t label;
+        };
+
+        std::vector<u32> code_{};
+        std::vector<std::optional<Address>> labels_{};
+        std::vector<Fixup> fixups_{};
+
+        auto Emit(u32 ins) -> void { code_.push_back(ins); }
+
+        auto R(u32 opcode, u32 funct3, u32 funct7, Reg rd, Reg rs1, Reg rs2) -> void
+        {
+            Emit((funct7 << 25) | (u32{rs2} << 20) | (u32{rs1} << 15) | (funct3 << 12) | (u32{rd} << 7) | opcode);
+        }
+
+        auto I(u32 opcode, u32 funct3, Reg rd, Reg rs1, i32 imm) -> void
+        {
+            Emit((static_cast<u32>(imm) << 20) | (u32{rs1} << 15) | (funct3 << 12) | (u32{rd} << 7) | opcode);
+        }
+
+        auto S(u32 opcode, u32 funct3, Reg rs1, Reg rs2, i32 imm) -> void
+        {
+            const auto i = static_cast<u32>(imm);
+            Emit(((i >> 5) << 25) | (u32{rs2} << 20) | (u32{rs1} << 15) | (funct3 << 12) | ((i & 0x1f) << 7) | opcode);
+        }
+
+        static auto BImm(i32 offset) -> u32
+        {
+            const auto i = static_cast<u32>(offset);
+            return (((i >> 12) & 1) << 31) | (((i >> 5) & 0x3f) << 25) | (((i >> 1) & 0xf) << 8) | (((i >> 11) & 1) << 7);
+        }
+
+        static auto JImm(i32 offset) -> u32
+        {
+            const auto i = static_cast<u32>(offset);
+            return (((i >> 20) & 1) << 31) | (((i >> 1) & 0x3ff) << 21) | (((i >> 11) & 1) << 20) | (((i >> 12) & 0xff) << 12);
+        }
+
+        auto B(u32 funct3, Reg rs1, Reg rs2, size_t label) -> void
+        {
+            fixups_.push_back({.index = code_.size(), .label = label});
+            Emit((u32{rs2} << 20) | (u32{rs1} << 15) | (funct3 << 12) | 0x63);
+        }
+
+    public:
+        // Labels.
+
+        auto NewLabel() -> size_t
+        {
+            labels_.emplace_back();
+            return labels_.size() - 1;
+        }
+
+        auto Bind(size_t label) -> void { labels_[label] = static_cast<Address>(code_.size() * 4); }
+
+        // Returns the code with every branch and jump patched.
+        auto Finish() -> std::vector<u32>
+        {
+            for (const auto& f : fixups_)
+            {
+                const auto offset = static_cast<i32>(*labels_[f.label]) - static_cast<i32>(f.index * 4);
+                code_[f.index] |= (code_[f.index] & 0x7f) == 0x6f ? JImm(offset) : BImm(offset);
+            }
+            return code_;
+        }
+
+        // RV32i.
+
+        auto Lui(Reg rd, u32 uimm) -> void { Emit((uimm & 0xfffff000) | (u32{rd} << 7) | 0x37); }
+        auto Jal(Reg rd, size_t label) -> void
+        {
+            fixups_.push_back({.index = code_.size(), .label = label});
+            Emit((u32{rd} << 7) | 0x6f);
+        }
+        auto Beq(Reg rs1, Reg rs2, size_t label) -> void { B(0b000, rs1, rs2, label); }
+        auto Bne(Reg rs1, Reg rs2, size_t label) -> void { B(0b001, rs1, rs2, label); }
+        auto Lw(Reg rd, Reg rs1, i32 imm) -> void { I(0x03, 0b010, rd, rs1, imm); }
+        auto Lbu(Reg rd, Reg rs1, i32 imm) -> void { I(0x03, 0b100, rd, rs1, imm); }
+        auto Sw(Reg rs1, Reg rs2, i32 imm) -> void { S(0x23, 0b010, rs1, rs2, imm); }
+        auto Addi(Reg rd, Reg rs1, i32 imm) -> void { I(0x13, 0b000, rd, rs1, imm); }
+        auto Xori(Reg rd, Reg rs1, i32 imm) -> void { I(0x13, 0b100, rd, rs1, imm); }
+        auto Andi(Reg rd, Reg rs1, i32 imm) -> void { I(0x13, 0b111, rd, rs1, imm); }
+        auto Slli(Reg rd, Reg rs1, u32 shamt) -> void { I(0x13, 0b001, rd, rs1, static_cast<i32>(shamt)); }
+        auto Srli(Reg rd, Reg rs1, u32 shamt) -> void { I(0x13, 0b101, rd, rs1, static_cast<i32>(shamt)); }
+        auto Add(Reg rd, Reg rs1, Reg rs2) -> void { R(0x33, 0b000, 0, rd, rs1, rs2); }
+        auto Sub(Reg rd, Reg rs1, Reg rs2) -> void { R(0x33, 0b000, 0b0100000, rd, rs1, rs2); }
+        auto Xor(Reg rd, Reg rs1, Reg rs2) -> void { R(0x33, 0b100, 0, rd, rs1, rs2); }
+        auto And(Reg rd, Reg rs1, Reg rs2) -> void { R(0x33, 0b111, 0, rd, rs1, rs2); }
+        auto Ebreak() -> void { Emit(0x00100073); }
+
+        // Loads a 32-bit constant.
+        auto Li(Reg rd, u32 value) -> void
+        {
+            const auto lo = static_cast<i32>(value << 20) >> 20; // The low 12 bits, sign extended.
+            if (static_cast<i32>(value) == lo)
+            {
+                Addi(rd, zero, lo);
+                return;
+            }
+            Lui(rd, value - static_cast<u32>(lo));
+            if (lo != 0)
+            {
+                Addi(rd, rd, lo);
+            }
+        }
+
+        // RV32f.
+
+        auto Flw(Reg rd, Reg rs1, i32 imm) -> void { I(0x07, 0b010, rd, rs1, imm); }
+        auto Fsw(Reg rs1, Reg rs2, i32 imm) -> void { S(0x27, 0b010, rs1, rs2, imm); }
+        auto Fmv_w_x(Reg rd, Reg rs1) -> void { R(0x53, 0b000, 0b1111000, rd, rs1, 0); }
+        auto Fmadd_s(Reg rd, Reg rs1, Reg rs2, Reg rs3) -> void
+        {
+            Emit((u32{rs3} << 27) | (u32{rs2} << 20) | (u32{rs1} << 15) | (0b111 << 12) | (u32{rd} << 7) | 0x43);
+        }
+    };
+} // namespace arviss::bench
@@ -0,0 +1,334 @@
+#pragma once
+
+#include "assembler.h"
+
+#include "arviss/arviss.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace arviss::bench
+{
+    // Where a kernel's data goes in guest memory.
+    struct Data
+    {
+        Address address;
+        std::vector<u8> bytes;
+    };
+
+    // A guest kernel. Its code is loaded at address 0, and it ends with an ebreak, leaving its result in a0.
+    struct Kernel
+    {
+        std::string name;
+        bool usesFloat;         // True if it needs RV32f.
+        bool usesCompressed;    // True if it needs RV32c.
+        std::vector<u32> code;  // The kernel itself.
+        std::vector<Data> data; // Its input, or for a prebuilt image, the image itself.
+        u32 expected;           // What it should leave in a0.
+    };
+
+    namespace impl
+    {
+        constexpr Address src = 0x4000; // Inputs start at the bottom of RAM.
+        constexpr Address dst = 0x5000; // Outputs go above them.
+
+        // 4KiB of pseudo-random words.
+        inline auto Pattern() -> std::vector<u8>
+        {
+            std::vector<u8> bytes(4096);
+            for (u32 i = 0; i < bytes.size() / 4; i++)
+            {
+                const u32 word = i * 2654435761u;
+                std::memcpy(&bytes[i * 4], &word, sizeof(word));
+            }
+            return bytes;
+        }
+
+        // Integer ALU work in a tight loop.
+        inline auto IntegerLoop() -> Kernel
+        {
+            constexpr u32 n = 100000;
+            Assembler a;
+            auto loop = a.NewLabel();
+            a.Li(t0, n);
+            a.Li(a0, 0);
+            a.Bind(loop);
+            a.Slli(t1, t0, 3);
+            a.Xor(t1, t1, t0);
+            a.Add(a0, a0, t1);
+            a.Srli(t2, a0, 7);
+            a.Xor(a0, a0, t2);
+            a.Addi(t0, t0, -1);
+            a.Bne(t0, zero, loop);
+            a.Ebreak();
+
+            u32 result = 0;
+            for (u32 i = n; i != 0; i--)
+            {
+                result += (i << 3) ^ i;
+                result ^= result >> 7;
+            }
+            return {.name = "integer", .usesFloat = false, .usesCompressed = false, .code = a.Finish(), .data = {}, .expected = result};
+        }
+
+        // Copies 4KiB a word at a time, 64 times over.
+        inline auto Memcpy() -> Kernel
+        {
+            Assembler a;
+            auto outer = a.NewLabel();
+            auto inner = a.NewLabel();
+            a.Li(s0, 64);
+            a.Bind(outer);
+            a.Li(a1, src);
+            a.Li(a2, dst);
+            a.Li(a3, src + 4096);
+            a.Bind(inner);
+            a.Lw(t0, a1, 0);
+            a.Lw(t1, a1, 4);
+            a.Sw(a2, t0, 0);
+            a.Sw(a2, t1, 4);
+            a.Addi(a1, a1, 8);
+            a.Addi(a2, a2, 8);
+            a.Bne(a1, a3, inner);
+            a.Addi(s0, s0, -1);
+            a.Bne(s0, zero, outer);
+            a.Lw(a0, a2, -4);
+            a.Ebreak();
+
+            const auto pattern = Pattern();
+            u32 last;
+            std::memcpy(&last, &pattern[pattern.size() - 4], sizeof(last));
+            return {.name = "memcpy",
+                    .usesFloat = false,
+                    .usesCompressed = false,
+                    .code = a.Finish(),
+                    .data = {{.address = src, .bytes = pattern}},
+                    .expected = last};
+        }
+
+        // A bit at a time CRC-32 of 1KiB, 8 times over.
+        inline auto Crc32() -> Kernel
+        {
+            constexpr u32 size = 1024;
+            constexpr u32 poly = 0xedb88320;
+            Assembler a;
+            auto outer = a.NewLabel();
+            auto byte = a.NewLabel();
+            auto bit = a.NewLabel();
+            a.Li(s0, 8);
+            a.Li(s1, poly);
+            a.Bind(outer);
+            a.Li(a1, src);
+            a.Li(a3, src + size);
+            a.Li(a0, 0xffffffff);
+            a.Bind(byte);
+            a.Lbu(t0, a1, 0);
+            a.Xor(a0, a0, t0);
+            a.Li(t2, 8);
+            a.Bind(bit);
+            a.Andi(t1, a0, 1);
+            a.Sub(t1, zero, t1);
+            a.And(t1, t1, s1);
+            a.Srli(a0, a0, 1);
+            a.Xor(a0, a0, t1);
+            a.Addi(t2, t2, -1);
+            a.Bne(t2, zero, bit);
+            a.Addi(a1, a1, 1);
+            a.Bne(a1, a3, byte);
+            a.Xori(a0, a0, -1);
+            a.Addi(s0, s0, -1);
+            a.Bne(s0, zero, outer);
+            a.Ebreak();
+
+            auto pattern = Pattern();
+            pattern.resize(size);
+            u32 crc = 0xffffffff;
+            for (const auto b : pattern)
+            {
+                crc ^= b;
+                for (int i = 0; i < 8; i++)
+                {
+                    crc = (crc >> 1) ^ (poly & (0 - (crc & 1)));
+                }
+            }
+            return {.name = "crc32",
+                    .usesFloat = false,
+                    .usesCompressed = false,
+                    .code = a.Finish(),
+                    .data = {{.address = src, .bytes = pattern}},
+                    .expected = ~crc};
+        }
+
+        // Multiplies two 16x16 matrices of floats, 4 times over. The inputs are small integers so that the result is
+        // exact, whether or not the multiply-adds are fused.
+        inline auto Matmul() -> Kernel
+        {
+            constexpr u32 n = 16;
+            constexpr Address matA = src;
+            constexpr Address matB = src + n * n * 4;
+            constexpr Address matC = dst;
+            Assembler a;
+            auto rep = a.NewLabel();
+            auto iloop = a.NewLabel();
+            auto jloop = a.NewLabel();
+            auto kloop = a.NewLabel();
+            a.Li(s0, 4);
+            a.Bind(rep);
+            a.Li(s1, 0); // i
+            a.Bind(iloop);
+            a.Li(s2, 0); // j
+            a.Bind(jloop);
+            a.Fmv_w_x(ft0, zero);
+            a.Slli(a1, s1, 6); // &A[i][0]
+            a.Li(t0, matA);
+            a.Add(a1, a1, t0);
+            a.Slli(a2, s2, 2); // &B[0][j]
+            a.Li(t0, matB);
+            a.Add(a2, a2, t0);
+            a.Li(s3, n); // k
+            a.Bind(kloop);
+            a.Flw(ft1, a1, 0);
+            a.Flw(ft2, a2, 0);
+            a.Fmadd_s(ft0, ft1, ft2, ft0);
+            a.Addi(a1, a1, 4);
+            a.Addi(a2, a2, n * 4);
+            a.Addi(s3, s3, -1);
+            a.Bne(s3, zero, kloop);
+            a.Slli(t0, s1, 6); // &C[i][j]
+            a.Slli(t1, s2, 2);
+            a.Add(t0, t0, t1);
+            a.Li(t1, matC);
+            a.Add(t0, t0, t1);
+            a.Fsw(t0, ft0, 0);
+            a.Addi(s2, s2, 1);
+            a.Li(t1, n);
+            a.Bne(s2, t1, jloop);
+            a.Addi(s1, s1, 1);
+            a.Bne(s1, t1, iloop);
+            a.Addi(s0, s0, -1);
+            a.Bne(s0, zero, rep);
+            a.Li(t0, matC + ((n * n) - 1) * 4); // C[n - 1][n - 1]
+            a.Lw(a0, t0, 0);
+            a.Ebreak();
+
+            std::vector<f32> matrices(2 * n * n);
+            for (u32 i = 0; i < n; i++)
+            {
+                for (u32 j = 0; j < n; j++)
+                {
+                    matrices[i * n + j] = static_cast<f32>(static_cast<i32>((i + j) % 7) - 3);
+                    matrices[n * n + i * n + j] = static_cast<f32>(static_cast<i32>((i * j) % 5) - 2);
+                }
+            }
+            f32 last = 0.0f;
+            for (u32 k = 0; k < n; k++)
+            {
+                last += matrices[(n - 1) * n + k] * matrices[n * n + k * n + (n - 1)];
+            }
+            std::vector<u8> bytes(matrices.size() * 4);
+            std::memcpy(bytes.data(), matrices.data(), bytes.size());
+            u32 expected;
+            std::memcpy(&expected, &last, sizeof(expected));
+            return {.name = "matmul",
+                    .usesFloat = true,
+                    .usesCompressed = false,
+                    .code = a.Finish(),
+                    .data = {{.address = matA, .bytes = bytes}},
+                    .expected = expected};
+        }
+
+        // Counts the Collatz steps for 1 to 2000, which is all data-dependent branches.
+        inline auto Branchy() -> Kernel
+        {
+            constexpr u32 n = 2000;
+            Assembler a;
+            auto outer = a.NewLabel();
+            auto step = a.NewLabel();
+            auto even = a.NewLabel();
+            auto next = a.NewLabel();
+            auto done = a.NewLabel();
+            a.Li(s0, 1);
+            a.Li(s1, n + 1);
+            a.Li(a0, 0);
+            a.Li(t2, 1);
+            a.Bind(outer);
+            a.Add(t0, s0, zero);
+            a.Bind(step);
+            a.Beq(t0, t2, done);
+            a.Andi(t1, t0, 1);
+            a.Beq(t1, zero, even);
+            a.Slli(t1, t0, 1); // 3x + 1
+            a.Add(t0, t0, t1);
+            a.Addi(t0, t0, 1);
+            a.Jal(zero, next);
+            a.Bind(even);
+            a.Srli(t0, t0, 1);
+            a.Bind(next);
+            a.Addi(a0, a0, 1);
+            a.Jal(zero, step);
+            a.Bind(done);
+            a.Addi(s0, s0, 1);
+            a.Bne(s0, s1, outer);
+            a.Ebreak();
+
+            u32 steps = 0;
+            for (u32 i = 1; i <= n; i++)
+            {
+                for (u32 x = i; x != 1; steps++)
+                {
+                    x = (x & 1) != 0 ? 3 * x + 1 : x >> 1;
+                }
+            }
+            return {.name = "branchy", .usesFloat = false, .usesCompressed = false, .code = a.Finish(), .data = {}, .expected = steps};
+        }
+    } // namespace impl
+
+    // Returns the prebuilt workloads listed in `dir`/expected.txt, i.e., those in riscv-examples/images, or nothing if
+    // there's no such file.
+    inline auto Workloads(const std::string& dir) -> std::vector<Kernel>
+    {
+        std::vector<Kernel> workloads;
+        std::ifstream expected(dir + "/expected.txt");
+        std::string line;
+        while (std::getline(expected, line))
+        {
+            std::istringstream fields(line);
+            std::string image;
+            std::string needs;
+            u32 checksum;
+            if (line.starts_with('#') || !(fields >> image >> needs >> std::hex >> checksum))
+            {
+                continue;
+            }
+            std::ifstream file(dir + "/" + image, std::ios::binary);
+            std::vector<u8> bytes{std::istreambuf_iterator<char>(file), {}};
+            workloads.push_back({.name = image,
+                                 .usesFloat = needs.find('f') != std::string::npos,
+                                 .usesCompressed = needs.find('c') != std::string::npos,
+                                 .code = {},
+                                 .data = {{.address = 0, .bytes = bytes}},
+                                 .expected = checksum});
+        }
+        return workloads;
+    }
+
+    // Returns all of the kernels, followed by the prebuilt workloads if they can be found.
+    inline auto Kernels() -> const std::vector<Kernel>&
+    {
+        static const std::vector<Kernel> kernels = [] {
+            std::vector<Kernel> all = {impl::IntegerLoop(), impl::Memcpy(), impl::Crc32(), impl::Matmul(), impl::Branchy()};
+#if defined(ARVISS_WORKLOADS_DIR)
+            for (auto& workload : Workloads(ARVISS_WORKLOADS_DIR))
+            {
+                all.push_back(std::move(workload));
+            }
+#endif
+            return all;
+        }();
+        return kernels;
+    }
+} // namespace arviss::bench
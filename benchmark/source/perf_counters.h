@@ -0,0 +1,122 @@
+#pragma once
+
+#include "arviss/arviss.h"
+
+#include <array>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace arviss::bench
+{
+    // Counts the host's CPU cycles and cache misses for this thread while it's running. On anything other than Linux, or
+    // where the kernel won't let us use the hardware counters, e.g., in a VM or with a high perf_event_paranoid, it
+    // counts nothing and IsAvailable() returns false.
+    class PerfCounters
+    {
+        static constexpr size_t cycles = 0;
+        static constexpr size_t cacheMisses = 1;
+
+        std::array<int, 2> fds_{-1, -1};
+
+#if defined(__linux__)
+        static auto Open(u64 config) -> int
+        {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+
+        auto Read(size_t counter) const -> u64
+        {
+            u64 value = 0;
+            if (fds_[counter] >= 0 && read(fds_[counter], &value, sizeof(value)) != sizeof(value))
+            {
+                value = 0;
+            }
+            return value;
+        }
+#endif
+
+    public:
+        PerfCounters()
+        {
+#if defined(__linux__)
+            fds_[cycles] = Open(PERF_COUNT_HW_CPU_CYCLES);
+            fds_[cacheMisses] = Open(PERF_COUNT_HW_CACHE_MISSES);
+#endif
+        }
+
+        ~PerfCounters()
+        {
+#if defined(__linux__)
+            for (const auto fd : fds_)
+            {
+                if (fd >= 0)
+                {
+                    close(fd);
+                }
+            }
+#endif
+        }
+
+        PerfCounters(const PerfCounters&) = delete;
+        auto operator=(const PerfCounters&) -> PerfCounters& = delete;
+
+        auto IsAvailable() const -> bool { return fds_[cycles] >= 0 && fds_[cacheMisses] >= 0; }
+
+        auto Start() -> void
+        {
+#if defined(__linux__)
+            for (const auto fd : fds_)
+            {
+                if (fd >= 0)
+                {
+                    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+                }
+            }
+#endif
+        }
+
+        auto Stop() -> void
+        {
+#if defined(__linux__)
+            for (const auto fd : fds_)
+            {
+                if (fd >= 0)
+                {
+                    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+                }
+            }
+#endif
+        }
+
+        auto Cycles() const -> u64
+        {
+#if defined(__linux__)
+            return Read(cycles);
+#else
+            return 0;
+#endif
+        }
+
+        auto CacheMisses() const -> u64
+        {
+#if defined(__linux__)
+            return Read(cacheMisses);
+#else
+            return 0;
+#endif
+        }
+    };
+} // namespace arviss::bench
@@ -46,12 +46,7 @@ auto main(int argc, char* argv[]) -> int
         Cpu cpu{};
 
         // Populate its memory with the contents of the image.
-        Address addr = 0;
-        for (auto b : buf)
-        {
-            cpu.Write8Unprotected(addr, b);
-            ++addr;
-        }
+        cpu.LoadImage(0, buf);
 
         // Execute some instructions.
         for (int i = 0; i < 100000; i++)
@@ -1,4 +1,5 @@
 #include "arviss/arviss.h"
+#include "arviss/elf/elf.h"
 #include "arviss/platforms/basic/basic.h"
 #include "arviss/rv32/rv32.h"
 
@@ -43,17 +44,16 @@ auto main(int argc, char* argv[]) -> int
         using Cpu = Rv32imfCpu<platforms::basic::MemoryNoIO>;
         Cpu cpu{};
 
-        // Populate its memory with the contents of the image.
-        Address addr = 0;
-        for (auto b : buf)
+        // Populate its memory with the contents of the image. If it's an ELF file then load its segments and start at its
+        // entry point, otherwise treat it as a raw image that starts at address 0.
+        if (!elf::Load(cpu, buf))
         {
-            cpu.Write8(addr, b);
-            ++addr;
+            cpu.LoadImage(0, buf);
+            cpu.SetNextPc(0);
         }
 
         // Execute some instructions.
         cpu.ClearTraps();
-        cpu.SetNextPc(0);
         Run(cpu, 10000);
 
         if (cpu.IsTrapped())
@@ -0,0 +1,39 @@
+#include "arviss/aot/translator.h"
+#include "arviss/arviss.h"
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+using namespace arviss;
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        if (argc < 3)
+        {
+            std::cerr << "Usage: translator <image> <namespace>\n";
+            return 2;
+        }
+
+        // Read the image into a buffer.
+        const char* filename = argv[1];
+        std::ifstream fileHandle(filename, std::ios::in | std::ios::binary | std::ios::ate);
+        const std::streampos fileSize = fileHandle.tellg();
+        fileHandle.seekg(0, std::ios::beg);
+        std::vector<u8> buf(static_cast<size_t>(fileSize));
+        fileHandle.read(reinterpret_cast<char*>(buf.data()), fileSize);
+        fileHandle.close();
+
+        // Translate it to C++, assuming that it's loaded at address zero and that execution starts there.
+        aot::Translator translator(0, buf);
+        translator.Emit(std::cout, argv[2]);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Exited with: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "arviss/aot/runtime.h"
+#include "arviss/aot/translator.h"
+#include "arviss/arviss.h"
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "arviss/arviss.h"
+#include "arviss/rv32/concepts.h"
+
+#include <concepts>
+#include <cstddef>
+
+namespace arviss::aot
+{
+    // Sets pc and nextPc as the fetch cycle would for the instruction at `pc`. Translated code calls this before each
+    // handler so that handlers and traps see the same values as they would if the instruction had been interpreted.
+    template<IsIntegerCore Cpu>
+    inline auto At(Cpu& cpu, Address pc) -> void
+    {
+        cpu.SetNextPc(pc);
+        cpu.Transfer();
+        cpu.SetNextPc(pc + 4);
+    }
+
+    // T is an image that was translated ahead of time by Translator, and that can be executed by Cpu.
+    template<typename T, typename Cpu>
+    concept IsTranslatedImage = requires(Cpu& cpu, Address pc, std::size_t count) {
+        {
+            T::Execute(cpu, pc, count)
+        } -> std::same_as<std::size_t>;
+    };
+
+    // Executes up to `count` instructions, stopping early if the CPU traps. Translated blocks are executed where there
+    // are any, and everything else is interpreted a single instruction at a time.
+    template<typename Image, IsRv32imfCpu Cpu>
+        requires IsTranslatedImage<Image, Cpu>
+    auto Run(Cpu& cpu, std::size_t count) -> void
+    {
+        while (count > 0 && !cpu.IsTrapped())
+        {
+            const auto pc = cpu.Transfer();
+            cpu.SetNextPc(pc);
+            if (const auto executed = Image::Execute(cpu, pc, count); executed > 0)
+            {
+                count -= executed;
+            }
+            else
+            {
+                auto ins = cpu.Fetch();
+                cpu.Dispatch(ins);
+                --count;
+            }
+        }
+    }
+} // namespace arviss::aot
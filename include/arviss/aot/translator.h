@@ -0,0 +1,322 @@
+#pragma once
+
+#include "arviss/arviss.h"
+#include "arviss/blocks/decoder.h"
+#include "arviss/rv32/concepts.h"
+#include "arviss/rv32/dispatchers.h"
+
+#include <format>
+#include <optional>
+#include <ostream>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace arviss::aot
+{
+    // An Rv32imf instruction handler that translates an instruction into a C++ statement that calls the handler for it on
+    // a CPU named `cpu`.
+    class Rv32imfTranslatingHandler
+    {
+        template<typename... Args>
+        static auto Call(std::string_view name, Args... args) -> std::string
+        {
+            auto result = std::format("cpu.{}(", name);
+            [[maybe_unused]] auto separator = "";
+            ((result += std::format("{}{:#x}", separator, args), separator = ", "), ...);
+            return result + ");";
+        }
+
+    public:
+        using Item = std::string;
+
+        // Illegal instruction.
+
+        auto Illegal(u32 ins) -> Item { return Call("Illegal", ins); }
+
+        // B-type instructions.
+
+        auto Beq(Reg rs1, Reg rs2, u32 bimm) -> Item { return Call("Beq", rs1, rs2, bimm); }
+        auto Bne(Reg rs1, Reg rs2, u32 bimm) -> Item { return Call("Bne", rs1, rs2, bimm); }
+        auto Blt(Reg rs1, Reg rs2, u32 bimm) -> Item { return Call("Blt", rs1, rs2, bimm); }
+        auto Bge(Reg rs1, Reg rs2, u32 bimm) -> Item { return Call("Bge", rs1, rs2, bimm); }
+        auto Bltu(Reg rs1, Reg rs2, u32 bimm) -> Item { return Call("Bltu", rs1, rs2, bimm); }
+        auto Bgeu(Reg rs1, Reg rs2, u32 bimm) -> Item { return Call("Bgeu", rs1, rs2, bimm); }
+
+        // I-type instructions.
+
+        auto Lb(Reg rd, Reg rs1, u32 iimm) -> Item { return Call("Lb", rd, rs1, iimm); }
+        auto Lh(Reg rd, Reg rs1, u32 iimm) -> Item { return Call("Lh", rd, rs1, iimm); }
+        auto Lw(Reg rd, Reg rs1, u32 iimm) -> Item { return Call("Lw", rd, rs1, iimm); }
+        auto Lbu(Reg rd, Reg rs1, u32 iimm) -> Item { return Call("Lbu", rd, rs1, iimm); }
+        auto Lhu(Reg rd, Reg rs1, u32 iimm) -> Item { return Call("Lhu", rd, rs1, iimm); }
+        auto Addi(Reg rd, Reg rs1, u32 iimm) -> Item { return Call("Addi", rd, rs1, iimm); }
+        auto Slti(Reg rd, Reg rs1, u32 iimm) -> Item { return Call("Slti", rd, rs1, iimm); }
+        auto Sltiu(Reg rd, Reg rs1, u32 iimm) -> Item { return Call("Sltiu", rd, rs1, iimm); }
+        auto Xori(Reg rd, Reg rs1, u32 iimm) -> Item { return Call("Xori", rd, rs1, iimm); }
+        auto Ori(Reg rd, Reg rs1, u32 iimm) -> Item { return Call("Ori", rd, rs1, iimm); }
+        auto Andi(Reg rd, Reg rs1, u32 iimm) -> Item { return Call("Andi", rd, rs1, iimm); }
+        auto Jalr(Reg rd, Reg rs1, u32 iimm) -> Item { return Call("Jalr", rd, rs1, iimm); }
+
+        // S-type instructions.
+
+        auto Sb(Reg rs1, Reg rs2, u32 simm) -> Item { return Call("Sb", rs1, rs2, simm); }
+        auto Sh(Reg rs1, Reg rs2, u32 simm) -> Item { return Call("Sh", rs1, rs2, simm); }
+        auto Sw(Reg rs1, Reg rs2, u32 simm) -> Item { return Call("Sw", rs1, rs2, simm); }
+
+        // U-type instructions.
+
+        auto Auipc(Reg rd, u32 uimm) -> Item { return Call("Auipc", rd, uimm); }
+        auto Lui(Reg rd, u32 uimm) -> Item { return Call("Lui", rd, uimm); }
+
+        // J-type instructions.
+
+        auto Jal(Reg rd, u32 jimm) -> Item { return Call("Jal", rd, jimm); }
+
+        // Arithmetic instructions.
+
+        auto Add(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Add", rd, rs1, rs2); }
+        auto Sub(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Sub", rd, rs1, rs2); }
+        auto Sll(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Sll", rd, rs1, rs2); }
+        auto Slt(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Slt", rd, rs1, rs2); }
+        auto Sltu(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Sltu", rd, rs1, rs2); }
+        auto Xor(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Xor", rd, rs1, rs2); }
+        auto Srl(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Srl", rd, rs1, rs2); }
+        auto Sra(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Sra", rd, rs1, rs2); }
+        auto Or(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Or", rd, rs1, rs2); }
+        auto And(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("And", rd, rs1, rs2); }
+
+        // Immediate shift instructions.
+
+        auto Slli(Reg rd, Reg rs1, u32 shamt) -> Item { return Call("Slli", rd, rs1, shamt); }
+        auto Srli(Reg rd, Reg rs1, u32 shamt) -> Item { return Call("Srli", rd, rs1, shamt); }
+        auto Srai(Reg rd, Reg rs1, u32 shamt) -> Item { return Call("Srai", rd, rs1, shamt); }
+
+        // Fence instructions.
+
+        auto Fence(u32 fm, Reg rd, Reg rs1) -> Item { return Call("Fence", fm, rd, rs1); }
+
+        // System instructions.
+
+        auto Ecall() -> Item { return Call("Ecall"); }
+        auto Ebreak() -> Item { return Call("Ebreak"); }
+
+        // Rv32m instructions.
+
+        auto Mul(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Mul", rd, rs1, rs2); }
+        auto Mulh(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Mulh", rd, rs1, rs2); }
+        auto Mulhsu(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Mulhsu", rd, rs1, rs2); }
+        auto Mulhu(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Mulhu", rd, rs1, rs2); }
+        auto Div(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Div", rd, rs1, rs2); }
+        auto Divu(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Divu", rd, rs1, rs2); }
+        auto Rem(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Rem", rd, rs1, rs2); }
+        auto Remu(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Remu", rd, rs1, rs2); }
+
+        // Rv32f instructions.
+
+        auto Fmv_x_w(Reg rd, Reg rs1) -> Item { return Call("Fmv_x_w", rd, rs1); }
+        auto Fclass_s(Reg rd, Reg rs1) -> Item { return Call("Fclass_s", rd, rs1); }
+        auto Fmv_w_x(Reg rd, Reg rs1) -> Item { return Call("Fmv_w_x", rd, rs1); }
+
+        auto Fsqrt_s(Reg rd, Reg rs1, u32 rm) -> Item { return Call("Fsqrt_s", rd, rs1, rm); }
+        auto Fcvt_w_s(Reg rd, Reg rs1, u32 rm) -> Item { return Call("Fcvt_w_s", rd, rs1, rm); }
+        auto Fcvt_wu_s(Reg rd, Reg rs1, u32 rm) -> Item { return Call("Fcvt_wu_s", rd, rs1, rm); }
+        auto Fcvt_s_w(Reg rd, Reg rs1, u32 rm) -> Item { return Call("Fcvt_s_w", rd, rs1, rm); }
+        auto Fcvt_s_wu(Reg rd, Reg rs1, u32 rm) -> Item { return Call("Fcvt_s_wu", rd, rs1, rm); }
+
+        auto Fsgnj_s(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Fsgnj_s", rd, rs1, rs2); }
+        auto Fsgnjn_s(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Fsgnjn_s", rd, rs1, rs2); }
+        auto Fsgnjx_s(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Fsgnjx_s", rd, rs1, rs2); }
+        auto Fmin_s(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Fmin_s", rd, rs1, rs2); }
+        auto Fmax_s(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Fmax_s", rd, rs1, rs2); }
+        auto Fle_s(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Fle_s", rd, rs1, rs2); }
+        auto Flt_s(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Flt_s", rd, rs1, rs2); }
+        auto Feq_s(Reg rd, Reg rs1, Reg rs2) -> Item { return Call("Feq_s", rd, rs1, rs2); }
+
+        auto Fadd_s(Reg rd, Reg rs1, Reg rs2, u32 rm) -> Item { return Call("Fadd_s", rd, rs1, rs2, rm); }
+        auto Fsub_s(Reg rd, Reg rs1, Reg rs2, u32 rm) -> Item { return Call("Fsub_s", rd, rs1, rs2, rm); }
+        auto Fmul_s(Reg rd, Reg rs1, Reg rs2, u32 rm) -> Item { return Call("Fmul_s", rd, rs1, rs2, rm); }
+        auto Fdiv_s(Reg rd, Reg rs1, Reg rs2, u32 rm) -> Item { return Call("Fdiv_s", rd, rs1, rs2, rm); }
+
+        auto Flw(Reg rd, Reg rs1, u32 imm) -> Item { return Call("Flw", rd, rs1, imm); }
+
+        auto Fsw(Reg rs1, Reg rs2, u32 imm) -> Item { return Call("Fsw", rs1, rs2, imm); }
+
+        auto Fmadd_s(Reg rd, Reg rs1, Reg rs2, Reg rs3, u32 rm) -> Item { return Call("Fmadd_s", rd, rs1, rs2, rs3, rm); }
+        auto Fmsub_s(Reg rd, Reg rs1, Reg rs2, Reg rs3, u32 rm) -> Item { return Call("Fmsub_s", rd, rs1, rs2, rs3, rm); }
+        auto Fnmsub_s(Reg rd, Reg rs1, Reg rs2, Reg rs3, u32 rm) -> Item { return Call("Fnmsub_s", rd, rs1, rs2, rs3, rm); }
+        auto Fnmadd_s(Reg rd, Reg rs1, Reg rs2, Reg rs3, u32 rm) -> Item { return Call("Fnmadd_s", rd, rs1, rs2, rs3, rm); }
+    };
+
+    static_assert(IsRv32imfHandler<Rv32imfTranslatingHandler>);
+
+    // Translates a raw Rv32imf image into C++ ahead of time. Code is discovered by following control flow from the entry
+    // points, and each basic block becomes a function that calls the CPU's handlers directly, so there's nothing left to
+    // fetch or decode at runtime. Code that can't be found statically, e.g., code that is only reached by an indirect
+    // jump, is left to the interpreter. See aot::Run().
+    class Translator
+    {
+        Address base_;
+        std::vector<u8> image_;
+        std::vector<Address> entryPoints_{};
+        Rv32imfDispatcher<blocks::Rv32imfPredecoder> decoder_{};
+        Rv32imfDispatcher<Rv32imfTranslatingHandler> translator_{};
+
+        auto Fetch32(Address address) const -> std::optional<u32>
+        {
+            if (address < base_ || address - base_ + 4 > image_.size() || (address & 3) != 0)
+            {
+                return {};
+            }
+            const auto offset = address - base_;
+            return static_cast<u32>(image_[offset]) | (static_cast<u32>(image_[offset + 1]) << 8) | (static_cast<u32>(image_[offset + 2]) << 16)
+                    | (static_cast<u32>(image_[offset + 3]) << 24);
+        }
+
+        // Returns true if the handler for `opc` can raise a trap, so that the translated code has to check for it.
+        static auto CanTrap(remix::Opcode opc) -> bool
+        {
+            switch (opc)
+            {
+            case remix::Opcode::Illegal:
+            case remix::Opcode::Lb:
+            case remix::Opcode::Lh:
+            case remix::Opcode::Lw:
+            case remix::Opcode::Lbu:
+            case remix::Opcode::Lhu:
+            case remix::Opcode::Sb:
+            case remix::Opcode::Sh:
+            case remix::Opcode::Sw:
+            case remix::Opcode::Ecall:
+            case remix::Opcode::Ebreak:
+            case remix::Opcode::Flw:
+            case remix::Opcode::Fsw:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        // Returns the start address of every basic block that can be reached from the entry points.
+        auto FindLeaders() -> std::set<Address>
+        {
+            std::set<Address> leaders;
+            auto pending = entryPoints_;
+            while (!pending.empty())
+            {
+                auto pc = pending.back();
+                pending.pop_back();
+                if (!Fetch32(pc) || !leaders.insert(pc).second)
+                {
+                    continue;
+                }
+                while (auto ins = Fetch32(pc))
+                {
+                    const auto op = decoder_.Dispatch(*ins);
+                    if (blocks::EndsBlock(op.opc))
+                    {
+                        switch (op.opc)
+                        {
+                        case remix::Opcode::Beq:
+                        case remix::Opcode::Bne:
+                        case remix::Opcode::Blt:
+                        case remix::Opcode::Bge:
+                        case remix::Opcode::Bltu:
+                        case remix::Opcode::Bgeu:
+                            pending.push_back(pc + op.imm);
+                            pending.push_back(pc + 4);
+                            break;
+                        case remix::Opcode::Jal:
+                            pending.push_back(pc + op.imm);
+                            if (op.rd != 0)
+                            {
+                                // It's a call, so expect it to return.
+                                pending.push_back(pc + 4);
+                            }
+                            break;
+                        case remix::Opcode::Jalr:
+                            if (op.rd != 0)
+                            {
+                                pending.push_back(pc + 4);
+                            }
+                            break;
+                        case remix::Opcode::Ecall:
+                            pending.push_back(pc + 4);
+                            break;
+                        default:
+                            break;
+                        }
+                        break;
+                    }
+                    pc += 4;
+                }
+            }
+            return leaders;
+        }
+
+    public:
+        // Creates a translator for an image that is loaded at `base`, and whose entry point is `base`.
+        Translator(Address base, std::span<const u8> image) : base_{base}, image_(image.begin(), image.end()), entryPoints_{base} {}
+
+        // Adds another address that execution may start from, e.g., an interrupt handler.
+        auto AddEntryPoint(Address address) -> void { entryPoints_.push_back(address); }
+
+        // Writes the translated image to `out` as a header that defines `name::Image`, for use with aot::Run().
+        auto Emit(std::ostream& out, std::string_view name) -> void
+        {
+            const auto leaders = FindLeaders();
+            std::vector<std::pair<Address, size_t>> blockSizes;
+
+            out << "// Generated by arviss::aot::Translator. Do not edit.\n\n";
+            out << "#pragma once\n\n";
+            out << "#include \"arviss/aot/runtime.h\"\n\n";
+            out << "#include <cstddef>\n\n";
+            out << std::format("namespace {}\n{{\n", name);
+            for (const auto start : leaders)
+            {
+                // A block runs up to and including the next control transfer, or until it runs into another block. It returns
+                // the number of instructions that it executed, which is fewer than its size if one of them traps. Like the
+                // interpreter, it counts the instruction that trapped.
+                out << "    template<typename Cpu>\n";
+                out << std::format("    auto Block_{:08x}(Cpu& cpu) -> std::size_t\n    {{\n", start);
+                size_t size = 0;
+                for (auto pc = start; auto ins = Fetch32(pc); pc += 4)
+                {
+                    const auto opc = decoder_.Dispatch(*ins).opc;
+                    const auto isLast = blocks::EndsBlock(opc) || leaders.contains(pc + 4) || !Fetch32(pc + 4);
+                    out << std::format("        arviss::aot::At(cpu, {:#x});\n", pc);
+                    out << std::format("        {}\n", translator_.Dispatch(*ins));
+                    ++size;
+                    if (isLast)
+                    {
+                        break;
+                    }
+                    if (CanTrap(opc))
+                    {
+                        out << std::format("        if (cpu.IsTrapped())\n        {{\n            return {};\n        }}\n", size);
+                    }
+                }
+                out << std::format("        return {};\n    }}\n\n", size);
+                blockSizes.emplace_back(start, size);
+            }
+
+            out << "    struct Image\n    {\n";
+            out << "        // Executes the block at `pc` and returns the number of instructions that it executed, stopping early if one of\n";
+            out << "        // them traps. Returns 0 if there's no translated block at `pc`, or if the block has more than `count`\n";
+            out << "        // instructions.\n";
+            out << "        template<typename Cpu>\n";
+            out << "        static auto Execute(Cpu& cpu, arviss::Address pc, std::size_t count) -> std::size_t\n        {\n";
+            out << "            switch (pc)\n            {\n";
+            for (const auto& [start, size] : blockSizes)
+            {
+                out << std::format("            case {:#x}:\n", start);
+                out << std::format("                if (count < {})\n                {{\n                    return 0;\n                }}\n", size);
+                out << std::format("                return Block_{:08x}(cpu);\n", start);
+            }
+            out << "            default:\n                return 0;\n            }\n        }\n    };\n";
+            out << std::format("}} // namespace {}\n", name);
+        }
+    };
+} // namespace arviss::aot
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <concepts>
 #include <cstdint>
 #include <exception>
 #include <optional>
+#include <span>
 
 namespace arviss
 {
@@ -28,6 +30,13 @@ namespace arviss
         SP = 2
     };
 
+    // Reasons for a run loop to stop, as returned by a core's Events().
+    enum StopEvents : u32
+    {
+        TRAP_RAISED = 1 << 0,    // A trap has been raised.
+        STOP_REQUESTED = 1 << 1, // Something, possibly on another thread, has asked the CPU to stop.
+    };
+
     enum class TrapType
     {
         // Non-interrupt traps.
@@ -117,6 +126,29 @@ namespace arviss
 
     } // namespace impl
 
+    // T has a program counter that the dispatcher can move on by itself. Only jumps and taken branches call SetNextPc(),
+    // so a dispatcher that knows that an instruction can't have jumped can call Advance() instead of Transfer().
+    template<typename T>
+    concept HasSequentialPc = impl::HasFetch<T> && requires(T t, Address a) {
+        a = t.Advance(); // Moves the program counter past the current instruction and returns it.
+    };
+
+    // T has a single word of stop events, so that a run loop can find out whether it should stop with one load rather
+    // than checking for traps and stop requests separately.
+    template<typename T>
+    concept HasStopEvents = requires(T t, u32 e, bool b) {
+        e = t.Events();          // Returns the pending StopEvents, or zero if there are none.
+        t.RequestStop();         // Asks the CPU to stop. It can be called from any thread.
+        b = t.TakeStopRequest(); // Clears STOP_REQUESTED and returns true if it was set.
+    };
+
+    // T has a 33rd integer register, SINK, which takes the results of instructions whose destination is x0. Its Wx()
+    // doesn't put x0 back to zero, so it relies on the dispatcher never writing to x0.
+    template<typename T>
+    concept HasSinkRegister = requires {
+        requires T::SINK == 32; // The sink comes after x31.
+    };
+
     // T supports writing to memory without checking if it's allowed to. The use case for this is being able to write
     // to "ROM" that isn't available to the VM.
     template<typename T>
@@ -126,6 +158,39 @@ namespace arviss
         t.Write32Unprotected(Address{}, u32{}); // Writes a word to an address, even if it's read-only for the VM.
     };
 
+    // T supports copying a whole image into memory at once, e.g., when loading a program. Like an unprotected write, the
+    // image can be written to "ROM".
+    template<typename T>
+    concept HasImageLoading = requires(T t, std::span<const u8> image) {
+        t.LoadImage(Address{}, image); // Copies an image to an address, even if it's read-only for the VM.
+    };
+
+    // The part of a memory that's plain host memory, laid out as the guest sees it, so that it can be loaded from and
+    // stored to directly rather than through the memory's accessors.
+    struct MemoryWindow
+    {
+        u8* base;           // The host address of guest address 0.
+        Address readEnd;    // Loads from [0, readEnd) can read from base + address.
+        Address writeStart; // Stores to [writeStart, writeEnd) can write to base + address.
+        Address writeEnd;
+
+        auto operator==(const MemoryWindow&) const -> bool = default;
+    };
+
+    // T has a memory window, e.g., for a JIT to access without calling back into T. Anything outside of the window has
+    // to go through T's accessors.
+    template<typename T>
+    concept HasMemoryWindow = requires(T t, MemoryWindow w) {
+        w = t.Window(); // Returns the window. It stays the same for as long as T isn't moved or reassigned.
+    };
+
+    // T has state that has to be cleaned up by unwinding if a memory access fails, e.g., a dispatcher that owns the
+    // block that it's decoding. It can't be used with a memory that recovers from faults by jumping out of them.
+    template<typename T>
+    concept NeedsUnwinding = requires {
+        requires T::needsUnwinding; // True if T can't be jumped out of.
+    };
+
     // T supports reading from and writing to memory.
     template<typename T>
     concept HasMemory = requires(T t, u8 b, u16 h, u32 w) {
@@ -137,6 +202,18 @@ namespace arviss
         t.Write32(Address{}, u32{}); // Writes a word to an address.
     };
 
+    // T supports reading from and writing to memory without throwing. A bad access is reported by returning nothing from
+    // a read, or false from a write, so that it can be raised as a trap rather than unwinding through the caller.
+    template<typename T>
+    concept HasNonThrowingMemory = requires(T t, std::optional<u8> b, std::optional<u16> h, std::optional<u32> w, bool ok) {
+        b = t.TryRead8(Address{});           // Reads a byte from an address.
+        h = t.TryRead16(Address{});          // Reads a halfword from an address.
+        w = t.TryRead32(Address{});          // Reads a word from an address.
+        ok = t.TryWrite8(Address{}, u8{});   // Writes a byte to an address.
+        ok = t.TryWrite16(Address{}, u16{}); // Writes a halfword to an address.
+        ok = t.TryWrite32(Address{}, u32{}); // Writes a word to an address.
+    };
+
     // T has all the pieces of an integer core.
     template<typename T>
     concept IsIntegerCore = impl::HasTraps<T> // It has traps.
@@ -156,7 +233,7 @@ namespace arviss
         Address pc_{};
         Address nextPc_{};
         std::optional<TrapState> trap_{};
-        std::array<u32, 32> xreg_{};
+        std::array<u32, 33> xreg_{}; // x0 to x31, then a sink for writes to x0. See ZeroSink.
 
     public:
         auto Run(size_t count) -> void
@@ -236,6 +313,164 @@ namespace arviss
         auto Wf(Reg rd, f32 val) -> void { freg_[rd] = val; }
     };
 
+    // An integer core where only a change in the flow of control sets the next program counter. IntegerCore writes
+    // nextPc_ on every fetch, only for a jump or a taken branch to overwrite it. Here, SetNextPc() records a target and
+    // flags that it's been taken, and Transfer() either follows it or steps over the current instruction. A dispatcher
+    // that knows that an instruction can't jump can call Advance(), which is just an add, so straight-line code never
+    // reads or writes the target. With any other dispatcher it's no faster than IntegerCore, because every Transfer()
+    // has to check for a jump.
+    template<HasMemory Mem, bool supports_compact_instructions = false>
+    class SequentialCore : public Mem
+    {
+    protected:
+        Address pc_{};
+        Address target_{};   // Where to go next, if jumped_ is set.
+        bool jumped_{true};  // True if SetNextPc() has been called since the last transfer.
+        u8 size_{4};         // The size of the current instruction.
+        std::optional<TrapState> trap_{};
+        std::array<u32, 33> xreg_{}; // x0 to x31, then a sink for writes to x0. See ZeroSink.
+
+    public:
+        auto Rx(Reg rs) -> u32 { return xreg_[rs]; }
+
+        auto Wx(Reg rd, u32 val) -> void
+        {
+            xreg_[rd] = val;
+            xreg_[0] = 0;
+        }
+
+        auto Pc() const -> Address { return pc_; }
+
+        auto Advance() -> Address
+        {
+            if constexpr (supports_compact_instructions)
+            {
+                pc_ += size_;
+            }
+            else
+            {
+                pc_ += 4;
+            }
+            return pc_;
+        }
+
+        auto Transfer() -> Address
+        {
+            if (jumped_)
+            {
+                jumped_ = false;
+                pc_ = target_;
+                return pc_;
+            }
+            return Advance();
+        }
+
+        auto Fetch() -> u32
+        {
+            auto pc = Transfer();
+            auto ins = Fetch32(pc);
+            if constexpr (supports_compact_instructions)
+            {
+                if ((ins & 0b11) == 0b11)
+                {
+                    // 32-bit instruction.
+                    size_ = 4;
+                }
+                else
+                {
+                    // 16-bit compressed instruction.
+                    size_ = 2;
+                    ins = ins & 0xffff;
+                }
+            }
+
+            return ins;
+        }
+
+        auto SetNextPc(Address address) -> void
+        {
+            target_ = address;
+            jumped_ = true;
+        }
+
+        auto Fetch32(Address address) -> u32
+        {
+            auto& mem = static_cast<Mem&>(*this);
+            return mem.Read32(address);
+        }
+
+        auto IsTrapped() const -> bool { return trap_.has_value(); }
+        auto TrapCause() const -> std::optional<TrapState> { return trap_; }
+        auto RaiseTrap(TrapType type, u32 context = 0) { trap_ = {.type_ = type, .context_ = context}; }
+        auto ClearTraps() { trap_ = {}; }
+    };
+
+    template<HasMemory Mem, bool supports_compact_instructions = false>
+    class SequentialFloatCore : public SequentialCore<Mem, supports_compact_instructions>
+    {
+    protected:
+        std::array<f32, 32> freg_{};
+
+    public:
+        auto Rf(Reg rs) -> f32 { return freg_[rs]; }
+        auto Wf(Reg rd, f32 val) -> void { freg_[rd] = val; }
+    };
+
+    // Adds stop events to a core. Raising a trap sets TRAP_RAISED, and RequestStop() sets STOP_REQUESTED from any
+    // thread, so a run loop can check for either with a single load, and a scheduler can preempt a CPU that is running
+    // on another thread. It goes between the core and the executor, e.g., Rv32iExecutor<Preemptible<IntegerCore<Mem>>>,
+    // so that it sees every trap that the executor raises.
+    template<IsIntegerCore Core>
+    class Preemptible : public Core
+    {
+        std::atomic<u32> events_{};
+
+    public:
+        using Core::Core;
+
+        Preemptible() = default;
+
+        Preemptible(const Preemptible& other) : Core(other), events_{other.Events()} {}
+
+        auto operator=(const Preemptible& other) -> Preemptible&
+        {
+            Core::operator=(other);
+            events_.store(other.Events(), std::memory_order_relaxed);
+            return *this;
+        }
+
+        auto Events() const -> u32 { return events_.load(std::memory_order_relaxed); }
+        auto RequestStop() -> void { events_.fetch_or(STOP_REQUESTED, std::memory_order_relaxed); }
+        auto TakeStopRequest() -> bool { return (events_.fetch_and(~u32{STOP_REQUESTED}, std::memory_order_relaxed) & STOP_REQUESTED) != 0; }
+
+        auto RaiseTrap(TrapType type, u32 context = 0) -> void
+        {
+            Core::RaiseTrap(type, context);
+            events_.fetch_or(TRAP_RAISED, std::memory_order_relaxed);
+        }
+
+        auto ClearTraps() -> void
+        {
+            Core::ClearTraps();
+            events_.fetch_and(~u32{TRAP_RAISED}, std::memory_order_relaxed);
+        }
+    };
+
+    // Makes Wx() a single store by not putting x0 back to zero after every write. That's only safe with a dispatcher
+    // that never writes to x0, i.e., one of the Remix dispatchers, which turn instructions that only write to x0 into
+    // Nops when they're transcoded, and send the results of jumps and loads whose destination is x0 to SINK. Don't use
+    // it with the RV32 dispatchers, the block cache, or the JIT, which all rely on Wx() to keep x0 at zero.
+    template<IsIntegerCore Core>
+    class ZeroSink : public Core
+    {
+    public:
+        static constexpr Reg SINK = 32;
+
+        using Core::Core;
+
+        auto Wx(Reg rd, u32 val) -> void { this->xreg_[rd] = val; }
+    };
+
     namespace impl
     {
 
@@ -255,6 +490,15 @@ namespace arviss
 
         static_assert(IsIntegerCore<IntegerCore<impl::NullMem>>);
         static_assert(IsFloatCore<FloatCore<impl::NullMem>>);
+        static_assert(IsIntegerCore<SequentialCore<impl::NullMem>>);
+        static_assert(IsFloatCore<SequentialFloatCore<impl::NullMem>>);
+        static_assert(HasSequentialPc<SequentialCore<impl::NullMem>>);
+        static_assert(!HasSequentialPc<IntegerCore<impl::NullMem>>);
+        static_assert(IsFloatCore<Preemptible<FloatCore<impl::NullMem>>>);
+        static_assert(HasStopEvents<Preemptible<IntegerCore<impl::NullMem>>>);
+        static_assert(IsFloatCore<ZeroSink<FloatCore<impl::NullMem>>>);
+        static_assert(HasSinkRegister<ZeroSink<SequentialCore<impl::NullMem>>>);
+        static_assert(!HasSinkRegister<IntegerCore<impl::NullMem>>);
     } // namespace impl
 
 } // namespace arviss
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "arviss/arviss.h"
+#include "arviss/blocks/decoder.h"
+#include "arviss/blocks/executors.h"
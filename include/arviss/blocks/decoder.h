@@ -0,0 +1,295 @@
+#pragma once
+
+#include "arviss/arviss.h"
+#include "arviss/remix/encoder.h"
+#include "arviss/rv32/concepts.h"
+
+#include <vector>
+
+namespace arviss::blocks
+{
+    // Instructions are identified by their Remix opcodes, as that's already a dense enumeration of every handler.
+    using remix::Opcode;
+
+    /*
+
+    A DecodedOp is an RV32 instruction that has been decoded once, ahead of time, so that executing it is a matter of
+    switching on `opc` and passing the pre-extracted fields to a handler.
+
+    +-----+----+-----+-----+-----+
+    | opc | rd | rs1 | rs2 | imm |
+    |   8 |  8 |   8 |   8 |  32 |
+    +-----+----+-----+-----+-----+
+
+    where:
+    - rd, rs1 and rs2 are only meaningful if the instruction has them.
+    - imm holds whatever else the instruction needs, e.g., a sign-extended immediate, a shift amount, a rounding mode,
+      or the original instruction for an illegal instruction.
+
+    For instructions with more operands than that, e.g., fmadd.s, imm holds rs3 in bits 4:0 and rm in bits 7:5.
+
+    A fused op stands for a pair of instructions. It replaces the first of the pair, and the second is left where it was
+    so that there's still one op per instruction. Fused ops are laid out as follows:
+
+    - Lui_addi (lui rd, hi; addi rd, rd, lo): rd, and imm holds hi + lo.
+    - Auipc_jalr (auipc rs1, hi; jalr rd, lo(rs1)): rd, rs1, and imm holds hi + lo.
+    - Auipc_lw (auipc rs1, hi; lw rd, lo(rs1)): rd, rs1, and imm holds hi + lo.
+    - Addi_bne (addi rd, rs1, i; bne rd, rs2, b): rd, rs1, rs2, and imm holds i in bits 31:20 and b in bits 12:0.
+
+    As lo is a sign-extended 12-bit immediate and hi is a multiple of 4096, both can be recovered from hi + lo.
+
+    */
+
+    struct DecodedOp
+    {
+        Opcode opc : 8;
+        u8 rd;
+        u8 rs1;
+        u8 rs2;
+        u32 imm;
+
+        auto rs3() const -> u32 { return imm & 0x1f; }
+        auto rm() const -> u32 { return (imm >> 5) & 0x7; }
+    };
+    static_assert(sizeof(DecodedOp) == 2 * sizeof(u32));
+
+    // Returns true if the op ends a basic block, i.e., it may transfer control somewhere other than the next instruction.
+    inline auto EndsBlock(Opcode opc) -> bool
+    {
+        switch (opc)
+        {
+        case Opcode::Illegal:
+        case Opcode::Beq:
+        case Opcode::Bne:
+        case Opcode::Blt:
+        case Opcode::Bge:
+        case Opcode::Bltu:
+        case Opcode::Bgeu:
+        case Opcode::Jal:
+        case Opcode::Jalr:
+        case Opcode::Ecall:
+        case Opcode::Ebreak:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Returns true if the op is a fused pair of instructions.
+    inline auto IsFused(Opcode opc) -> bool
+    {
+        switch (opc)
+        {
+        case Opcode::Lui_addi:
+        case Opcode::Auipc_jalr:
+        case Opcode::Auipc_lw:
+        case Opcode::Addi_bne:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Returns the sign-extended low 12 bits of hi + lo, i.e., lo.
+    inline auto LowPart(u32 sum) -> u32 { return u32(i32(sum << 20) >> 20); }
+
+    // Returns the first instruction of a fused op on its own.
+    inline auto FirstOf(const DecodedOp& op) -> DecodedOp
+    {
+        switch (op.opc)
+        {
+        case Opcode::Lui_addi:
+            return {.opc = Opcode::Lui, .rd = op.rd, .rs1 = 0, .rs2 = 0, .imm = op.imm - LowPart(op.imm)};
+        case Opcode::Auipc_jalr:
+        case Opcode::Auipc_lw:
+            return {.opc = Opcode::Auipc, .rd = op.rs1, .rs1 = 0, .rs2 = 0, .imm = op.imm - LowPart(op.imm)};
+        case Opcode::Addi_bne:
+            return {.opc = Opcode::Addi, .rd = op.rd, .rs1 = op.rs1, .rs2 = 0, .imm = u32(i32(op.imm) >> 20)};
+        default:
+            return op;
+        }
+    }
+
+    // Replaces the first op of each pair of ops that commonly go together with a fused op that does the work of both.
+    inline auto Fuse(std::vector<DecodedOp>& ops) -> void
+    {
+        for (size_t i = 0; i + 1 < ops.size(); i++)
+        {
+            auto& first = ops[i];
+            auto second = ops[i + 1];
+            if (first.opc == Opcode::Lui && second.opc == Opcode::Addi && second.rd == first.rd && second.rs1 == first.rd)
+            {
+                // li rd, imm32
+                first = {.opc = Opcode::Lui_addi, .rd = first.rd, .rs1 = 0, .rs2 = 0, .imm = first.imm + second.imm};
+            }
+            else if (first.opc == Opcode::Auipc && second.opc == Opcode::Jalr && second.rs1 == first.rd)
+            {
+                // call / tail to a pc-relative address.
+                first = {.opc = Opcode::Auipc_jalr, .rd = second.rd, .rs1 = first.rd, .rs2 = 0, .imm = first.imm + second.imm};
+            }
+            else if (first.opc == Opcode::Auipc && second.opc == Opcode::Lw && second.rs1 == first.rd)
+            {
+                // Load a word from a pc-relative address.
+                first = {.opc = Opcode::Auipc_lw, .rd = second.rd, .rs1 = first.rd, .rs2 = 0, .imm = first.imm + second.imm};
+            }
+            else if (first.opc == Opcode::Addi && second.opc == Opcode::Bne && (second.rs1 == first.rd || second.rs2 == first.rd))
+            {
+                // Step a loop counter and branch back. bne is symmetric, so the counter can be either of its operands.
+                const auto rs2 = second.rs1 == first.rd ? second.rs2 : second.rs1;
+                first = {.opc = Opcode::Addi_bne, .rd = first.rd, .rs1 = first.rs1, .rs2 = rs2, .imm = (first.imm << 20) | (second.imm & 0x1fff)};
+            }
+            else
+            {
+                continue;
+            }
+            i++;
+        }
+    }
+
+    // An Rv32i instruction handler that decodes instructions to DecodedOps.
+    class Rv32iPredecoder
+    {
+    protected:
+        static auto Op(Opcode opc, u32 rd = 0, u32 rs1 = 0, u32 rs2 = 0, u32 imm = 0) -> DecodedOp
+        {
+            return {.opc = opc, .rd = u8(rd), .rs1 = u8(rs1), .rs2 = u8(rs2), .imm = imm};
+        }
+
+    public:
+        using Item = DecodedOp;
+
+        // Illegal instruction.
+
+        auto Illegal(u32 ins) -> Item { return Op(Opcode::Illegal, 0, 0, 0, ins); }
+
+        // B-type instructions.
+
+        auto Beq(Reg rs1, Reg rs2, u32 bimm) -> Item { return Op(Opcode::Beq, 0, rs1, rs2, bimm); }
+        auto Bne(Reg rs1, Reg rs2, u32 bimm) -> Item { return Op(Opcode::Bne, 0, rs1, rs2, bimm); }
+        auto Blt(Reg rs1, Reg rs2, u32 bimm) -> Item { return Op(Opcode::Blt, 0, rs1, rs2, bimm); }
+        auto Bge(Reg rs1, Reg rs2, u32 bimm) -> Item { return Op(Opcode::Bge, 0, rs1, rs2, bimm); }
+        auto Bltu(Reg rs1, Reg rs2, u32 bimm) -> Item { return Op(Opcode::Bltu, 0, rs1, rs2, bimm); }
+        auto Bgeu(Reg rs1, Reg rs2, u32 bimm) -> Item { return Op(Opcode::Bgeu, 0, rs1, rs2, bimm); }
+
+        // I-type instructions.
+
+        auto Lb(Reg rd, Reg rs1, u32 iimm) -> Item { return Op(Opcode::Lb, rd, rs1, 0, iimm); }
+        auto Lh(Reg rd, Reg rs1, u32 iimm) -> Item { return Op(Opcode::Lh, rd, rs1, 0, iimm); }
+        auto Lw(Reg rd, Reg rs1, u32 iimm) -> Item { return Op(Opcode::Lw, rd, rs1, 0, iimm); }
+        auto Lbu(Reg rd, Reg rs1, u32 iimm) -> Item { return Op(Opcode::Lbu, rd, rs1, 0, iimm); }
+        auto Lhu(Reg rd, Reg rs1, u32 iimm) -> Item { return Op(Opcode::Lhu, rd, rs1, 0, iimm); }
+        auto Addi(Reg rd, Reg rs1, u32 iimm) -> Item { return Op(Opcode::Addi, rd, rs1, 0, iimm); }
+        auto Slti(Reg rd, Reg rs1, u32 iimm) -> Item { return Op(Opcode::Slti, rd, rs1, 0, iimm); }
+        auto Sltiu(Reg rd, Reg rs1, u32 iimm) -> Item { return Op(Opcode::Sltiu, rd, rs1, 0, iimm); }
+        auto Xori(Reg rd, Reg rs1, u32 iimm) -> Item { return Op(Opcode::Xori, rd, rs1, 0, iimm); }
+        auto Ori(Reg rd, Reg rs1, u32 iimm) -> Item { return Op(Opcode::Ori, rd, rs1, 0, iimm); }
+        auto Andi(Reg rd, Reg rs1, u32 iimm) -> Item { return Op(Opcode::Andi, rd, rs1, 0, iimm); }
+        auto Jalr(Reg rd, Reg rs1, u32 iimm) -> Item { return Op(Opcode::Jalr, rd, rs1, 0, iimm); }
+
+        // S-type instructions.
+
+        auto Sb(Reg rs1, Reg rs2, u32 simm) -> Item { return Op(Opcode::Sb, 0, rs1, rs2, simm); }
+        auto Sh(Reg rs1, Reg rs2, u32 simm) -> Item { return Op(Opcode::Sh, 0, rs1, rs2, simm); }
+        auto Sw(Reg rs1, Reg rs2, u32 simm) -> Item { return Op(Opcode::Sw, 0, rs1, rs2, simm); }
+
+        // U-type instructions.
+
+        auto Auipc(Reg rd, u32 uimm) -> Item { return Op(Opcode::Auipc, rd, 0, 0, uimm); }
+        auto Lui(Reg rd, u32 uimm) -> Item { return Op(Opcode::Lui, rd, 0, 0, uimm); }
+
+        // J-type instructions.
+
+        auto Jal(Reg rd, u32 jimm) -> Item { return Op(Opcode::Jal, rd, 0, 0, jimm); }
+
+        // Arithmetic instructions.
+
+        auto Add(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Add, rd, rs1, rs2); }
+        auto Sub(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Sub, rd, rs1, rs2); }
+        auto Sll(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Sll, rd, rs1, rs2); }
+        auto Slt(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Slt, rd, rs1, rs2); }
+        auto Sltu(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Sltu, rd, rs1, rs2); }
+        auto Xor(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Xor, rd, rs1, rs2); }
+        auto Srl(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Srl, rd, rs1, rs2); }
+        auto Sra(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Sra, rd, rs1, rs2); }
+        auto Or(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Or, rd, rs1, rs2); }
+        auto And(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::And, rd, rs1, rs2); }
+
+        // Immediate shift instructions.
+
+        auto Slli(Reg rd, Reg rs1, u32 shamt) -> Item { return Op(Opcode::Slli, rd, rs1, 0, shamt); }
+        auto Srli(Reg rd, Reg rs1, u32 shamt) -> Item { return Op(Opcode::Srli, rd, rs1, 0, shamt); }
+        auto Srai(Reg rd, Reg rs1, u32 shamt) -> Item { return Op(Opcode::Srai, rd, rs1, 0, shamt); }
+
+        // Fence instructions.
+
+        auto Fence(u32 fm, Reg rd, Reg rs1) -> Item { return Op(Opcode::Fence, rd, rs1, 0, fm); }
+
+        // System instructions.
+
+        auto Ecall() -> Item { return Op(Opcode::Ecall); }
+        auto Ebreak() -> Item { return Op(Opcode::Ebreak); }
+    };
+
+    static_assert(IsRv32iHandler<Rv32iPredecoder>);
+
+    // An Rv32im instruction handler that decodes instructions to DecodedOps.
+    class Rv32imPredecoder : public Rv32iPredecoder
+    {
+    public:
+        using Item = Rv32iPredecoder::Item;
+
+        auto Mul(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Mul, rd, rs1, rs2); }
+        auto Mulh(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Mulh, rd, rs1, rs2); }
+        auto Mulhsu(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Mulhsu, rd, rs1, rs2); }
+        auto Mulhu(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Mulhu, rd, rs1, rs2); }
+        auto Div(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Div, rd, rs1, rs2); }
+        auto Divu(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Divu, rd, rs1, rs2); }
+        auto Rem(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Rem, rd, rs1, rs2); }
+        auto Remu(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Remu, rd, rs1, rs2); }
+    };
+
+    static_assert(IsRv32imHandler<Rv32imPredecoder>);
+
+    // An Rv32imf instruction handler that decodes instructions to DecodedOps.
+    class Rv32imfPredecoder : public Rv32imPredecoder
+    {
+    public:
+        using Item = Rv32imPredecoder::Item;
+
+        auto Fmv_x_w(Reg rd, Reg rs1) -> Item { return Op(Opcode::Fmv_x_w, rd, rs1); }
+        auto Fclass_s(Reg rd, Reg rs1) -> Item { return Op(Opcode::Fclass_s, rd, rs1); }
+        auto Fmv_w_x(Reg rd, Reg rs1) -> Item { return Op(Opcode::Fmv_w_x, rd, rs1); }
+
+        auto Fsqrt_s(Reg rd, Reg rs1, u32 rm) -> Item { return Op(Opcode::Fsqrt_s, rd, rs1, 0, rm << 5); }
+        auto Fcvt_w_s(Reg rd, Reg rs1, u32 rm) -> Item { return Op(Opcode::Fcvt_w_s, rd, rs1, 0, rm << 5); }
+        auto Fcvt_wu_s(Reg rd, Reg rs1, u32 rm) -> Item { return Op(Opcode::Fcvt_wu_s, rd, rs1, 0, rm << 5); }
+        auto Fcvt_s_w(Reg rd, Reg rs1, u32 rm) -> Item { return Op(Opcode::Fcvt_s_w, rd, rs1, 0, rm << 5); }
+        auto Fcvt_s_wu(Reg rd, Reg rs1, u32 rm) -> Item { return Op(Opcode::Fcvt_s_wu, rd, rs1, 0, rm << 5); }
+
+        auto Fsgnj_s(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Fsgnj_s, rd, rs1, rs2); }
+        auto Fsgnjn_s(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Fsgnjn_s, rd, rs1, rs2); }
+        auto Fsgnjx_s(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Fsgnjx_s, rd, rs1, rs2); }
+        auto Fmin_s(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Fmin_s, rd, rs1, rs2); }
+        auto Fmax_s(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Fmax_s, rd, rs1, rs2); }
+        auto Fle_s(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Fle_s, rd, rs1, rs2); }
+        auto Flt_s(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Flt_s, rd, rs1, rs2); }
+        auto Feq_s(Reg rd, Reg rs1, Reg rs2) -> Item { return Op(Opcode::Feq_s, rd, rs1, rs2); }
+
+        auto Fadd_s(Reg rd, Reg rs1, Reg rs2, u32 rm) -> Item { return Op(Opcode::Fadd_s, rd, rs1, rs2, rm << 5); }
+        auto Fsub_s(Reg rd, Reg rs1, Reg rs2, u32 rm) -> Item { return Op(Opcode::Fsub_s, rd, rs1, rs2, rm << 5); }
+        auto Fmul_s(Reg rd, Reg rs1, Reg rs2, u32 rm) -> Item { return Op(Opcode::Fmul_s, rd, rs1, rs2, rm << 5); }
+        auto Fdiv_s(Reg rd, Reg rs1, Reg rs2, u32 rm) -> Item { return Op(Opcode::Fdiv_s, rd, rs1, rs2, rm << 5); }
+
+        auto Flw(Reg rd, Reg rs1, u32 imm) -> Item { return Op(Opcode::Flw, rd, rs1, 0, imm); }
+
+        auto Fsw(Reg rs1, Reg rs2, u32 imm) -> Item { return Op(Opcode::Fsw, 0, rs1, rs2, imm); }
+
+        auto Fmadd_s(Reg rd, Reg rs1, Reg rs2, Reg rs3, u32 rm) -> Item { return Op(Opcode::Fmadd_s, rd, rs1, rs2, (rm << 5) | rs3); }
+        auto Fmsub_s(Reg rd, Reg rs1, Reg rs2, Reg rs3, u32 rm) -> Item { return Op(Opcode::Fmsub_s, rd, rs1, rs2, (rm << 5) | rs3); }
+        auto Fnmsub_s(Reg rd, Reg rs1, Reg rs2, Reg rs3, u32 rm) -> Item { return Op(Opcode::Fnmsub_s, rd, rs1, rs2, (rm << 5) | rs3); }
+        auto Fnmadd_s(Reg rd, Reg rs1, Reg rs2, Reg rs3, u32 rm) -> Item { return Op(Opcode::Fnmadd_s, rd, rs1, rs2, (rm << 5) | rs3); }
+    };
+
+    static_assert(IsRv32imfHandler<Rv32imfPredecoder>);
+
+} // namespace arviss::blocks
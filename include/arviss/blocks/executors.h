@@ -0,0 +1,650 @@
+#pragma once
+
+#include "arviss/arviss.h"
+#include "arviss/blocks/decoder.h"
+#include "arviss/rv32/concepts.h"
+#include "arviss/rv32/dispatchers.h"
+
+#include <array>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace arviss::blocks
+{
+    // Compressed instructions aren't supported, because a block assumes that every instruction is four bytes long.
+    template<typename T>
+    concept IsBlockDispatchable = IsRv32iHandler<T> && (!IsRv32cHandler<T>) && IsIntegerCore<T> && std::same_as<void, typename T::Item>;
+
+    namespace
+    {
+        template<typename T>
+            requires IsRv32iHandler<T>  // T is a handler for Rv32i.
+                && (!IsRv32mHandler<T>) // T is NOT a handler for Rv32m.
+                && (!IsRv32fHandler<T>) // T is NOT a handler for Rv32f.
+        auto PredecoderFor() -> Rv32iDispatcher<Rv32iPredecoder>;
+
+        template<typename T>
+            requires IsRv32iHandler<T>  // T is a handler for Rv32i.
+                && IsRv32mHandler<T>    // T is a handler for Rv32m.
+                && (!IsRv32fHandler<T>) // T is NOT a handler for Rv32f.
+        auto PredecoderFor() -> Rv32imDispatcher<Rv32imPredecoder>;
+
+        template<typename T>
+            requires IsRv32iHandler<T> // T is a handler for Rv32i.
+                && IsRv32mHandler<T>   // T is a handler for Rv32m.
+                && IsRv32fHandler<T>   // T is a handler for Rv32f.
+        auto PredecoderFor() -> Rv32imfDispatcher<Rv32imfPredecoder>;
+
+    } // namespace
+
+    // A dispatcher that decodes straight-line runs of instructions up to and including the next branch or jump into
+    // blocks of DecodedOps, caches them by guest address, and executes them from the cache. Blocks are invalidated when a
+    // guest store hits a page that contains cached code.
+    template<IsBlockDispatchable T>
+    class BlockCacheDispatcher : public T
+    {
+        auto Self() -> T& { return static_cast<T&>(*this); }
+
+        using PredecoderType = decltype(PredecoderFor<T>());
+
+        static constexpr size_t recentSize = 1024; // The number of entries in the direct-mapped lookup table.
+
+    protected:
+        static constexpr size_t maxBlockOps = 64; // The maximum number of instructions in a block.
+        static constexpr u32 pageShift = 12;      // Code is tracked in 4KiB pages.
+
+        struct Block
+        {
+            Address start;
+            std::vector<DecodedOp> ops;
+            u32 executions{}; // How many times the block has been entered. Higher tiers use this to find hot blocks.
+            void* native{};   // The block's compiled form, if a higher tier has compiled it.
+        };
+
+    private:
+        // A direct-mapped cache in front of `blocks_`. It points into `blocks_`, so a copy of the dispatcher, e.g., a fork
+        // of a snapshot, starts with it empty rather than pointing into the original's blocks.
+        struct RecentBlocks
+        {
+            std::array<Block*, recentSize> entries{};
+
+            RecentBlocks() = default;
+            RecentBlocks(const RecentBlocks&) {}
+
+            auto operator=(const RecentBlocks&) -> RecentBlocks&
+            {
+                entries.fill(nullptr);
+                return *this;
+            }
+        };
+
+        PredecoderType predecoder_{};
+        std::unordered_map<Address, Block> blocks_{};                   // Blocks, keyed by their start address.
+        std::unordered_map<Address, std::vector<Address>> pageBlocks_{}; // The start addresses of the blocks on each page.
+        std::vector<u8> codePages_{};                                   // Non-zero for each page that contains cached code.
+        RecentBlocks recent_{};
+        std::vector<Address> dirtyPages_{};                             // Code pages that have been written to.
+
+        auto IsCodePage(Address page) const -> bool { return page < codePages_.size() && codePages_[page] != 0; }
+
+        auto Decode(Address pc) -> Block
+        {
+            auto& self = Self();
+            Block block{.start = pc, .ops = {}};
+
+            // Let the first fetch fault in the usual way. Any later fault just ends the block early, leaving it to be
+            // raised if and when execution gets that far.
+            auto op = predecoder_.Dispatch(self.Fetch32(pc));
+            block.ops.push_back(op);
+            while (!EndsBlock(op.opc) && block.ops.size() < maxBlockOps)
+            {
+                pc += 4;
+                try
+                {
+                    op = predecoder_.Dispatch(self.Fetch32(pc));
+                }
+                catch (const TrappedException&)
+                {
+                    break;
+                }
+                block.ops.push_back(op);
+            }
+            Fuse(block.ops);
+            return block;
+        }
+
+        // Returns the pages that a block's instructions are on.
+        static auto PagesOf(const Block& block) -> std::pair<Address, Address>
+        {
+            return {block.start >> pageShift, (block.start + 4 * static_cast<u32>(block.ops.size()) - 1) >> pageShift};
+        }
+
+        // Called before a guest store of `size` bytes to `address`, which may straddle two pages.
+        auto CheckStore(Address address, u32 size) -> void
+        {
+            for (const Address page : {address >> pageShift, (address + size - 1) >> pageShift})
+            {
+                if (IsCodePage(page))
+                {
+                    codePages_[page] = 0;
+                    dirtyPages_.push_back(page);
+                }
+            }
+        }
+
+    protected:
+        auto HasDirtyPages() const -> bool { return !dirtyPages_.empty(); }
+
+        // Returns a table with a non-zero byte for each page that contains cached code, covering at least the pages below
+        // `end`. A store to one of those pages has to go through Execute() so that the page's blocks are thrown away. The
+        // table moves when a block is decoded on a page beyond its end.
+        auto CodePages(Address end) -> const u8*
+        {
+            const auto pages = (u64{end} + (1u << pageShift) - 1) >> pageShift;
+            if (pages > codePages_.size())
+            {
+                codePages_.resize(pages);
+            }
+            return codePages_.data();
+        }
+
+        // Returns the block that starts at `pc`, decoding it if it isn't already in the cache.
+        auto Lookup(Address pc) -> Block&
+        {
+            auto& recent = recent_.entries[(pc >> 2) % recentSize];
+            if (recent != nullptr && recent->start == pc)
+            {
+                return *recent;
+            }
+            auto it = blocks_.find(pc);
+            if (it == blocks_.end())
+            {
+                it = blocks_.emplace(pc, Decode(pc)).first;
+                const auto [firstPage, lastPage] = PagesOf(it->second);
+                for (auto page = firstPage; page <= lastPage; page++)
+                {
+                    if (page >= codePages_.size())
+                    {
+                        codePages_.resize(page + 1);
+                    }
+                    codePages_[page] = 1;
+                    pageBlocks_[page].push_back(pc);
+                }
+            }
+            recent = &it->second;
+            return it->second;
+        }
+
+        // Throws away any blocks on pages that have been written to. A block that is also on another page is taken off
+        // that page's list too, so that the lists don't collect stale entries when the block is decoded again.
+        auto FlushDirtyPages() -> void
+        {
+            for (auto page : dirtyPages_)
+            {
+                auto it = pageBlocks_.find(page);
+                if (it == pageBlocks_.end())
+                {
+                    continue;
+                }
+                const auto starts = std::move(it->second);
+                pageBlocks_.erase(it);
+                for (auto start : starts)
+                {
+                    auto block = blocks_.find(start);
+                    if (block == blocks_.end())
+                    {
+                        continue;
+                    }
+                    const auto [firstPage, lastPage] = PagesOf(block->second);
+                    for (auto other = firstPage; other <= lastPage; other++)
+                    {
+                        if (auto list = pageBlocks_.find(other); list != pageBlocks_.end())
+                        {
+                            std::erase(list->second, start);
+                            if (list->second.empty())
+                            {
+                                pageBlocks_.erase(list);
+                                codePages_[other] = 0;
+                            }
+                        }
+                    }
+                    blocks_.erase(block);
+                }
+            }
+            dirtyPages_.clear();
+            recent_.entries.fill(nullptr);
+        }
+
+        // Moves on from the first instruction of a fused pair to the second.
+        auto Advance() -> void
+        {
+            auto& self = Self();
+            self.SetNextPc(self.Transfer() + 4);
+        }
+
+        // Executes a single op. A fused op executes both of its instructions.
+        auto Execute(const DecodedOp& op) -> void
+        {
+            auto& self = Self();
+
+            switch (op.opc)
+            {
+            // --- RV32i.
+
+            // B-type instructions.
+            case Opcode::Beq:
+                return self.Beq(op.rs1, op.rs2, op.imm);
+            case Opcode::Bne:
+                return self.Bne(op.rs1, op.rs2, op.imm);
+            case Opcode::Blt:
+                return self.Blt(op.rs1, op.rs2, op.imm);
+            case Opcode::Bge:
+                return self.Bge(op.rs1, op.rs2, op.imm);
+            case Opcode::Bltu:
+                return self.Bltu(op.rs1, op.rs2, op.imm);
+            case Opcode::Bgeu:
+                return self.Bgeu(op.rs1, op.rs2, op.imm);
+
+            // I-type instructions.
+            case Opcode::Lb:
+                return self.Lb(op.rd, op.rs1, op.imm);
+            case Opcode::Lh:
+                return self.Lh(op.rd, op.rs1, op.imm);
+            case Opcode::Lw:
+                return self.Lw(op.rd, op.rs1, op.imm);
+            case Opcode::Lbu:
+                return self.Lbu(op.rd, op.rs1, op.imm);
+            case Opcode::Lhu:
+                return self.Lhu(op.rd, op.rs1, op.imm);
+            case Opcode::Addi:
+                return self.Addi(op.rd, op.rs1, op.imm);
+            case Opcode::Slti:
+                return self.Slti(op.rd, op.rs1, op.imm);
+            case Opcode::Sltiu:
+                return self.Sltiu(op.rd, op.rs1, op.imm);
+            case Opcode::Xori:
+                return self.Xori(op.rd, op.rs1, op.imm);
+            case Opcode::Ori:
+                return self.Ori(op.rd, op.rs1, op.imm);
+            case Opcode::Andi:
+                return self.Andi(op.rd, op.rs1, op.imm);
+            case Opcode::Jalr:
+                return self.Jalr(op.rd, op.rs1, op.imm);
+
+            // S-type instructions.
+            case Opcode::Sb:
+                CheckStore(self.Rx(op.rs1) + op.imm, 1);
+                return self.Sb(op.rs1, op.rs2, op.imm);
+            case Opcode::Sh:
+                CheckStore(self.Rx(op.rs1) + op.imm, 2);
+                return self.Sh(op.rs1, op.rs2, op.imm);
+            case Opcode::Sw:
+                CheckStore(self.Rx(op.rs1) + op.imm, 4);
+                return self.Sw(op.rs1, op.rs2, op.imm);
+
+            // U-type instructions.
+            case Opcode::Auipc:
+                return self.Auipc(op.rd, op.imm);
+            case Opcode::Lui:
+                return self.Lui(op.rd, op.imm);
+
+            // J-type instructions.
+            case Opcode::Jal:
+                return self.Jal(op.rd, op.imm);
+
+            // Arithmetic instructions.
+            case Opcode::Add:
+                return self.Add(op.rd, op.rs1, op.rs2);
+            case Opcode::Sub:
+                return self.Sub(op.rd, op.rs1, op.rs2);
+            case Opcode::Sll:
+                return self.Sll(op.rd, op.rs1, op.rs2);
+            case Opcode::Slt:
+                return self.Slt(op.rd, op.rs1, op.rs2);
+            case Opcode::Sltu:
+                return self.Sltu(op.rd, op.rs1, op.rs2);
+            case Opcode::Xor:
+                return self.Xor(op.rd, op.rs1, op.rs2);
+            case Opcode::Srl:
+                return self.Srl(op.rd, op.rs1, op.rs2);
+            case Opcode::Sra:
+                return self.Sra(op.rd, op.rs1, op.rs2);
+            case Opcode::Or:
+                return self.Or(op.rd, op.rs1, op.rs2);
+            case Opcode::And:
+                return self.And(op.rd, op.rs1, op.rs2);
+
+            // Immediate shift instructions.
+            case Opcode::Slli:
+                return self.Slli(op.rd, op.rs1, op.imm);
+            case Opcode::Srli:
+                return self.Srli(op.rd, op.rs1, op.imm);
+            case Opcode::Srai:
+                return self.Srai(op.rd, op.rs1, op.imm);
+
+            // System instructions.
+            case Opcode::Fence:
+                return self.Fence(op.imm, op.rd, op.rs1);
+            case Opcode::Ecall:
+                return self.Ecall();
+            case Opcode::Ebreak:
+                return self.Ebreak();
+
+            // --- RV32m.
+
+            // Integer multiply and divide instructions.
+            case Opcode::Mul:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    return self.Mul(op.rd, op.rs1, op.rs2);
+                }
+                [[fallthrough]];
+            case Opcode::Mulh:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    return self.Mulh(op.rd, op.rs1, op.rs2);
+                }
+                [[fallthrough]];
+            case Opcode::Mulhsu:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    return self.Mulhsu(op.rd, op.rs1, op.rs2);
+                }
+                [[fallthrough]];
+            case Opcode::Mulhu:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    return self.Mulhu(op.rd, op.rs1, op.rs2);
+                }
+                [[fallthrough]];
+            case Opcode::Div:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    return self.Div(op.rd, op.rs1, op.rs2);
+                }
+                [[fallthrough]];
+            case Opcode::Divu:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    return self.Divu(op.rd, op.rs1, op.rs2);
+                }
+                [[fallthrough]];
+            case Opcode::Rem:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    return self.Rem(op.rd, op.rs1, op.rs2);
+                }
+                [[fallthrough]];
+            case Opcode::Remu:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    return self.Remu(op.rd, op.rs1, op.rs2);
+                }
+                [[fallthrough]];
+
+            // --- RV32f.
+
+            // Floating point instructions.
+            case Opcode::Fmv_x_w:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fmv_x_w(op.rd, op.rs1);
+                }
+                [[fallthrough]];
+            case Opcode::Fclass_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fclass_s(op.rd, op.rs1);
+                }
+                [[fallthrough]];
+            case Opcode::Fmv_w_x:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fmv_w_x(op.rd, op.rs1);
+                }
+                [[fallthrough]];
+            case Opcode::Fsqrt_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fsqrt_s(op.rd, op.rs1, op.rm());
+                }
+                [[fallthrough]];
+            case Opcode::Fcvt_w_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fcvt_w_s(op.rd, op.rs1, op.rm());
+                }
+                [[fallthrough]];
+            case Opcode::Fcvt_wu_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fcvt_wu_s(op.rd, op.rs1, op.rm());
+                }
+                [[fallthrough]];
+            case Opcode::Fcvt_s_w:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fcvt_s_w(op.rd, op.rs1, op.rm());
+                }
+                [[fallthrough]];
+            case Opcode::Fcvt_s_wu:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fcvt_s_wu(op.rd, op.rs1, op.rm());
+                }
+                [[fallthrough]];
+            case Opcode::Fsgnj_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fsgnj_s(op.rd, op.rs1, op.rs2);
+                }
+                [[fallthrough]];
+            case Opcode::Fsgnjn_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fsgnjn_s(op.rd, op.rs1, op.rs2);
+                }
+                [[fallthrough]];
+            case Opcode::Fsgnjx_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fsgnjx_s(op.rd, op.rs1, op.rs2);
+                }
+                [[fallthrough]];
+            case Opcode::Fmin_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fmin_s(op.rd, op.rs1, op.rs2);
+                }
+                [[fallthrough]];
+            case Opcode::Fmax_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fmax_s(op.rd, op.rs1, op.rs2);
+                }
+                [[fallthrough]];
+            case Opcode::Fle_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fle_s(op.rd, op.rs1, op.rs2);
+                }
+                [[fallthrough]];
+            case Opcode::Flt_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Flt_s(op.rd, op.rs1, op.rs2);
+                }
+                [[fallthrough]];
+            case Opcode::Feq_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Feq_s(op.rd, op.rs1, op.rs2);
+                }
+                [[fallthrough]];
+            case Opcode::Fadd_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fadd_s(op.rd, op.rs1, op.rs2, op.rm());
+                }
+                [[fallthrough]];
+            case Opcode::Fsub_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fsub_s(op.rd, op.rs1, op.rs2, op.rm());
+                }
+                [[fallthrough]];
+            case Opcode::Fmul_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fmul_s(op.rd, op.rs1, op.rs2, op.rm());
+                }
+                [[fallthrough]];
+            case Opcode::Fdiv_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fdiv_s(op.rd, op.rs1, op.rs2, op.rm());
+                }
+                [[fallthrough]];
+            case Opcode::Flw:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Flw(op.rd, op.rs1, op.imm);
+                }
+                [[fallthrough]];
+            case Opcode::Fsw:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    CheckStore(self.Rx(op.rs1) + op.imm, 4);
+                    return self.Fsw(op.rs1, op.rs2, op.imm);
+                }
+                [[fallthrough]];
+            case Opcode::Fmadd_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fmadd_s(op.rd, op.rs1, op.rs2, op.rs3(), op.rm());
+                }
+                [[fallthrough]];
+            case Opcode::Fmsub_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fmsub_s(op.rd, op.rs1, op.rs2, op.rs3(), op.rm());
+                }
+                [[fallthrough]];
+            case Opcode::Fnmsub_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fnmsub_s(op.rd, op.rs1, op.rs2, op.rs3(), op.rm());
+                }
+                [[fallthrough]];
+            case Opcode::Fnmadd_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    return self.Fnmadd_s(op.rd, op.rs1, op.rs2, op.rs3(), op.rm());
+                }
+                [[fallthrough]];
+
+            // --- Fused pairs.
+
+            // Each pair runs its instructions one after the other, moving on to the second just as the fetch cycle would,
+            // so if the second one traps then it does so at its own address with the first one's effects in place.
+            case Opcode::Lui_addi:
+                self.Lui(op.rd, op.imm - LowPart(op.imm));
+                Advance();
+                return self.Addi(op.rd, op.rd, LowPart(op.imm));
+            case Opcode::Auipc_jalr:
+                self.Auipc(op.rs1, op.imm - LowPart(op.imm));
+                Advance();
+                return self.Jalr(op.rd, op.rs1, LowPart(op.imm));
+            case Opcode::Auipc_lw:
+                self.Auipc(op.rs1, op.imm - LowPart(op.imm));
+                Advance();
+                return self.Lw(op.rd, op.rs1, LowPart(op.imm));
+            case Opcode::Addi_bne:
+                self.Addi(op.rd, op.rs1, u32(i32(op.imm) >> 20));
+                Advance();
+                return self.Bne(op.rd, op.rs2, u32(i32(op.imm << 19) >> 19));
+
+            // The predecoder only emits ops that T can handle, so anything else is an illegal instruction.
+            default:
+                return self.Illegal(op.imm);
+            }
+        }
+
+        // Interprets `block` from its start, stopping early if `count` runs out, the CPU traps, or a store hits cached code.
+        auto Interpret(const Block& block, size_t& count) -> void
+        {
+            auto& self = Self();
+            const auto& ops = block.ops;
+            for (size_t i = 0; i < ops.size(); i++)
+            {
+                // Keep pc / nextPc exactly as the fetch cycle would so that handlers and traps see the right values.
+                const auto pc = self.Transfer();
+                self.SetNextPc(pc + 4);
+                if (!IsFused(ops[i].opc))
+                {
+                    Execute(ops[i]);
+                }
+                else if (count >= 2)
+                {
+                    // The fused op covers the next op too.
+                    Execute(ops[i++]);
+                    --count;
+                }
+                else
+                {
+                    // There's only enough left to run the first instruction of the pair.
+                    Execute(FirstOf(ops[i]));
+                }
+                --count;
+                if (count == 0 || self.IsTrapped())
+                {
+                    break;
+                }
+                if (!dirtyPages_.empty())
+                {
+                    // A store hit cached code, possibly this block, so stop executing it.
+                    break;
+                }
+            }
+        }
+
+    public:
+        using Item = typename T::Item;
+
+        // Decoding a block fetches from guest memory into a vector that it owns, and stops at a fetch that fails by
+        // catching the TrappedException, so a fault can't be recovered by jumping out of it. See NeedsUnwinding.
+        static constexpr bool needsUnwinding = true;
+
+        // Executes up to `count` instructions, a block at a time, stopping early if the CPU traps.
+        auto Run(size_t count) -> void
+        {
+            auto& self = Self();
+            if (!dirtyPages_.empty())
+            {
+                // A store that hit cached code faulted on the way out of the last run.
+                FlushDirtyPages();
+            }
+            while (count > 0 && !self.IsTrapped())
+            {
+                const auto& block = Lookup(self.Transfer());
+                self.SetNextPc(block.start);
+                Interpret(block, count);
+                if (!dirtyPages_.empty())
+                {
+                    FlushDirtyPages();
+                }
+            }
+        }
+
+        // Throws away all cached blocks, e.g., after the host has written new code with unprotected writes.
+        auto Invalidate() -> void
+        {
+            blocks_.clear();
+            pageBlocks_.clear();
+            codePages_.clear();
+            dirtyPages_.clear();
+            recent_.entries.fill(nullptr);
+        }
+    };
+} // namespace arviss::blocks
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "arviss/arviss.h"
+#include "arviss/file.h"
+#include "arviss/platforms/flat/flat.h"
+
+#include <algorithm>
+#include <optional>
+#include <span>
+#include <vector>
+
+#if ARVISS_HAS_FLAT_MEMORY
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace arviss::elf
+{
+    // A loadable segment of an ELF file.
+    struct Segment
+    {
+        Address address;   // Where it's loaded in the guest.
+        u32 offset;        // Where its contents start in the file.
+        u32 fileSize;      // The size of its contents in the file.
+        u32 memSize;       // Its size in memory. Anything beyond `fileSize` is .bss, and reads as zero.
+        bool isWritable;   // True if the guest can write to it.
+        bool isExecutable; // True if it holds code.
+    };
+
+    // The parts of an ELF executable that are needed to run it.
+    struct Program
+    {
+        Address entry;
+        std::vector<Segment> segments;
+    };
+
+    namespace impl
+    {
+        constexpr u32 ehdrSize = 52; // sizeof(Elf32_Ehdr)
+        constexpr u32 phdrSize = 32; // sizeof(Elf32_Phdr)
+        constexpr u16 etExec = 2;    // ET_EXEC
+        constexpr u16 emRiscv = 243; // EM_RISCV
+        constexpr u32 ptLoad = 1;    // PT_LOAD
+        constexpr u32 pfExec = 1;    // PF_X
+        constexpr u32 pfWrite = 2;   // PF_W
+
+        // ELF files for RISC-V are little-endian, whatever the host is.
+        inline auto Le16(std::span<const u8> file, size_t offset) -> u16 { return static_cast<u16>(file[offset] | (file[offset + 1] << 8)); }
+        inline auto Le32(std::span<const u8> file, size_t offset) -> u32 { return Le16(file, offset) | (u32{Le16(file, offset + 2)} << 16); }
+    } // namespace impl
+
+    // Reads the ELF header and program headers of `file`. Returns nothing if it isn't a little-endian ELF32 RISC-V
+    // executable, or if its headers point outside of it.
+    inline auto Parse(std::span<const u8> file) -> std::optional<Program>
+    {
+        using namespace impl;
+
+        if (file.size() < ehdrSize || file[0] != 0x7f || file[1] != 'E' || file[2] != 'L' || file[3] != 'F' // ELFMAG
+            || file[4] != 1                                                                                   // ELFCLASS32
+            || file[5] != 1                                                                                   // ELFDATA2LSB
+            || Le16(file, 16) != etExec || Le16(file, 18) != emRiscv)
+        {
+            return std::nullopt;
+        }
+
+        const u32 phoff = Le32(file, 28);
+        const u16 phentsize = Le16(file, 42);
+        const u16 phnum = Le16(file, 44);
+        if (phentsize < phdrSize || phoff > file.size() || u64{phnum} * phentsize > file.size() - phoff)
+        {
+            return std::nullopt;
+        }
+
+        Program program{.entry = Le32(file, 24), .segments = {}};
+        for (u32 i = 0; i < phnum; i++)
+        {
+            const size_t ph = phoff + size_t{i} * phentsize;
+            if (Le32(file, ph) != ptLoad)
+            {
+                continue;
+            }
+            const Segment segment{
+                    .address = Le32(file, ph + 8),
+                    .offset = Le32(file, ph + 4),
+                    .fileSize = Le32(file, ph + 16),
+                    .memSize = Le32(file, ph + 20),
+                    .isWritable = (Le32(file, ph + 24) & pfWrite) != 0,
+                    .isExecutable = (Le32(file, ph + 24) & pfExec) != 0,
+            };
+            if (segment.offset > file.size() || segment.fileSize > file.size() - segment.offset || segment.fileSize > segment.memSize)
+            {
+                return std::nullopt;
+            }
+            program.segments.push_back(segment);
+        }
+        return program;
+    }
+
+    // Copies the segments of the ELF executable in `file` into `cpu`'s memory, clears their .bss, and sets its next pc to
+    // the entry point. The gaps between segments aren't initialised. Returns false if `file` isn't a RISC-V executable,
+    // and throws a TrappedException if a segment doesn't fit in memory.
+    template<typename Cpu>
+        requires IsIntegerCore<Cpu> && HasImageLoading<Cpu>
+    auto Load(Cpu& cpu, std::span<const u8> file) -> bool
+    {
+        const auto program = Parse(file);
+        if (!program)
+        {
+            return false;
+        }
+        for (const auto& segment : program->segments)
+        {
+            cpu.LoadImage(segment.address, file.subspan(segment.offset, segment.fileSize));
+            if (segment.memSize > segment.fileSize)
+            {
+                const std::vector<u8> zeroes(segment.memSize - segment.fileSize);
+                cpu.LoadImage(segment.address + segment.fileSize, zeroes);
+            }
+        }
+        cpu.SetNextPc(program->entry);
+        return true;
+    }
+
+#if ARVISS_HAS_FLAT_MEMORY
+
+    // Maps the ELF executable at `path` into `cpu`'s flat memory and sets its next pc to the entry point. Read-only
+    // segments that have whole pages to themselves are mapped straight from the file without being copied. The others
+    // are mapped as fresh memory and their contents copied in, so their .bss is committed lazily, a page at a time, the
+    // first time that it's touched. A page that's shared by more than one segment gets the most permissive protection
+    // of the segments that share it. Returns false if the file isn't a RISC-V executable or couldn't be mapped.
+    template<typename Cpu>
+        requires IsIntegerCore<Cpu> && std::derived_from<Cpu, platforms::flat::Memory>
+    auto Map(Cpu& cpu, const char* path) -> bool
+    {
+        // Both are released however this returns. Any mappings of the file into memory keep it open.
+        const FileDescriptor fd(open(path, O_RDONLY));
+        const FileMapping mapping(fd.Get(), 0);
+        const auto file = mapping.Bytes();
+        if (file.empty())
+        {
+            return false;
+        }
+
+        const auto program = Parse(file);
+        bool ok = program.has_value();
+        if (ok)
+        {
+            // The pages that a segment occupies.
+            struct Pages
+            {
+                u64 first;
+                u64 last;
+                bool isWritable;
+            };
+            const auto& segments = program->segments;
+            const auto pageMask = static_cast<u64>(sysconf(_SC_PAGESIZE)) - 1;
+            const auto pagesOf = [&](const Segment& segment) {
+                return Pages{.first = segment.address & ~pageMask,
+                             .last = (u64{segment.address} + segment.memSize + pageMask) & ~pageMask,
+                             .isWritable = segment.isWritable};
+            };
+
+            // A segment can only be mapped from the file if it's read-only, it's at the same offset within a page in
+            // the file as in memory, and it doesn't share any pages with another segment.
+            std::vector<bool> isDirect(segments.size());
+            for (size_t i = 0; i < segments.size(); i++)
+            {
+                const auto& segment = segments[i];
+                const auto pages = pagesOf(segment);
+                bool isShared = false;
+                for (size_t j = 0; j < segments.size(); j++)
+                {
+                    const auto other = pagesOf(segments[j]);
+                    isShared = isShared || (j != i && segments[j].memSize > 0 && other.first < pages.last && pages.first < other.last);
+                }
+                isDirect[i] = segment.memSize > 0 && !segment.isWritable && segment.fileSize > 0 && !isShared
+                              && (segment.offset & pageMask) == (segment.address & pageMask);
+            }
+
+            // Map everything else as runs of fresh, zeroed pages, merging the segments that share pages. That has to
+            // happen before anything is copied in, as mapping a run replaces whatever was there.
+            std::vector<Pages> runs;
+            for (size_t i = 0; i < segments.size(); i++)
+            {
+                if (segments[i].memSize > 0 && !isDirect[i])
+                {
+                    runs.push_back(pagesOf(segments[i]));
+                }
+            }
+            std::sort(runs.begin(), runs.end(), [](const Pages& a, const Pages& b) { return a.first < b.first; });
+            for (size_t i = 0; ok && i < runs.size(); i++)
+            {
+                auto run = runs[i];
+                for (; i + 1 < runs.size() && runs[i + 1].first < run.last; i++)
+                {
+                    run.last = std::max(run.last, runs[i + 1].last);
+                    run.isWritable = run.isWritable || runs[i + 1].isWritable;
+                }
+                ok = cpu.Map(static_cast<Address>(run.first), run.last - run.first, run.isWritable);
+            }
+
+            for (size_t i = 0; ok && i < segments.size(); i++)
+            {
+                const auto& segment = segments[i];
+                if (!isDirect[i])
+                {
+                    if (segment.fileSize > 0)
+                    {
+                        cpu.LoadImage(segment.address, file.subspan(segment.offset, segment.fileSize));
+                    }
+                    continue;
+                }
+
+                // Map the file's pages directly. The rest of the last of them holds whatever follows the segment in
+                // the file, so the part of it that's .bss has to be cleared, which gives the page a private copy.
+                // Any whole pages of .bss after that are mapped as fresh memory.
+                const u64 skew = segment.address & pageMask;
+                const u64 mapped = (skew + segment.fileSize + pageMask) & ~pageMask;
+                ok = cpu.MapImage(static_cast<Address>(segment.address - skew), fd.Get(), segment.offset - skew, skew + segment.fileSize);
+                const u64 tail = std::min(mapped, skew + segment.memSize) - skew - segment.fileSize;
+                if (ok && tail > 0)
+                {
+                    const std::vector<u8> zeroes(tail);
+                    cpu.LoadImage(segment.address + segment.fileSize, zeroes);
+                }
+                if (ok && skew + segment.memSize > mapped)
+                {
+                    ok = cpu.Map(static_cast<Address>(segment.address - skew + mapped), skew + segment.memSize - mapped, false);
+                }
+            }
+        }
+        if (ok)
+        {
+            cpu.SetNextPc(program->entry);
+        }
+        return ok;
+    }
+
+#endif // ARVISS_HAS_FLAT_MEMORY
+
+} // namespace arviss::elf
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "arviss/arviss.h"
+
+#include <span>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace arviss
+{
+#if defined(__unix__) || defined(__APPLE__)
+
+    // Closes a file descriptor when it goes out of scope.
+    class FileDescriptor
+    {
+        int fd_;
+
+    public:
+        explicit FileDescriptor(int fd) : fd_{fd} {}
+        ~FileDescriptor()
+        {
+            if (fd_ >= 0)
+            {
+                close(fd_);
+            }
+        }
+
+        FileDescriptor(const FileDescriptor&) = delete;
+        auto operator=(const FileDescriptor&) -> FileDescriptor& = delete;
+
+        auto Get() const -> int { return fd_; }
+    };
+
+    // Maps all of an open file read-only, and unmaps it when it goes out of scope. It's empty if the file couldn't be
+    // mapped or is no bigger than `minSize`.
+    class FileMapping
+    {
+        void* contents_{MAP_FAILED};
+        size_t size_{};
+
+    public:
+        FileMapping(int fd, u64 minSize)
+        {
+            struct stat st = {};
+            if (fd >= 0 && fstat(fd, &st) == 0 && static_cast<u64>(st.st_size) > minSize)
+            {
+                size_ = static_cast<size_t>(st.st_size);
+                contents_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+        }
+        ~FileMapping()
+        {
+            if (contents_ != MAP_FAILED)
+            {
+                munmap(contents_, size_);
+            }
+        }
+
+        FileMapping(const FileMapping&) = delete;
+        auto operator=(const FileMapping&) -> FileMapping& = delete;
+
+        auto Bytes() const -> std::span<const u8>
+        {
+            return contents_ != MAP_FAILED ? std::span<const u8>(static_cast<const u8*>(contents_), size_) : std::span<const u8>();
+        }
+    };
+
+#endif
+} // namespace arviss
@@ -0,0 +1,954 @@
+#pragma once
+
+#include "arviss/arviss.h"
+#include "arviss/blocks/executors.h"
+#include "arviss/jit/x86_64.h"
+#include "arviss/rv32/concepts.h"
+#include "arviss/rv32/executors.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <utility>
+#include <vector>
+
+namespace arviss::jit
+{
+    using blocks::DecodedOp;
+    using remix::Opcode;
+
+    // T is anything that the block cache can run.
+    template<typename T>
+    concept IsJitDispatchable = blocks::IsBlockDispatchable<T>;
+
+    // T's executor has no execution hooks, so generated code doesn't have to tell them about every instruction.
+    template<typename T>
+    concept HasNoHooks = requires(T t) {
+        {
+            t.Instrumentation()
+        } -> std::same_as<NoHooks&>;
+    };
+
+#if ARVISS_HAS_X86_64_JIT
+
+    // A tiered dispatcher. Cold code is interpreted from the block cache, and blocks that have been entered often enough
+    // are compiled to x86-64. Generated code works on the core's registers in place. Loads and stores go straight to the
+    // memory's window after checking the address against it, and a store also checks that it isn't about to write to a
+    // page that contains cached code. An access that fails its checks, and any op that isn't compiled inline, calls back
+    // into the block cache's executor, so traps, exceptions and self-modifying code behave exactly as they do when
+    // interpreted. A block ends by jumping straight to the block that follows it once that's been compiled too, so a hot
+    // loop doesn't come back to the dispatcher until it leaves the loop or runs out of instructions. Cores with stop
+    // events don't chain blocks, so that a stop request is seen after every block.
+    //
+    // Only cores without execution hooks whose memory has a window are compiled. Anything else runs on the block cache.
+    template<IsJitDispatchable T>
+    class JitDispatcher : public blocks::BlockCacheDispatcher<T>
+    {
+        using Base = blocks::BlockCacheDispatcher<T>;
+        using Block = typename Base::Block;
+        using E = X64Emitter;
+        using Entry = void (*)(Context* context, void* target);
+
+        static constexpr u32 hotThreshold = 16;                    // Blocks are compiled on their 16th entry.
+        static constexpr size_t codeBufferSize = 4 * 1024 * 1024; // 4MiB of generated code before starting again.
+        static constexpr bool canCompile = HasNoHooks<T> && HasMemoryWindow<T>;
+        static constexpr bool canChain = !HasStopEvents<T>;
+
+        // An out of line path in a block's generated code. It either calls Step() for an op that failed a check and then
+        // goes back to `resume`, or, if `op` is nullptr, leaves the block early.
+        struct Stub
+        {
+            E::Label label;
+            const DecodedOp* op;
+            Address pc;
+            E::Label resume;
+            u32 unexecuted; // The number of the block's instructions after the op, which won't be executed if it stops.
+        };
+
+        CodeBuffer code_{canCompile ? codeBufferSize : 0};
+        Context context_{};
+        std::deque<Link> links_{};     // Every block's slots. A deque, because generated code refers to them by address.
+        Link* pendingLink_{};          // The slot that generated code last left through...
+        Address pendingTarget_{};      // ... and where it was going, so that the slot can be linked to that block.
+        Entry enter_{};                // Calls into generated code. Set up by EmitTrampolines().
+        void* exit_{};                 // Returns from generated code to the dispatcher.
+        void* unlinked_{};             // Where a slot points until it's linked.
+        MemoryWindow window_{};        // The memory window that the generated code was compiled for.
+        std::exception_ptr pending_{}; // An exception thrown by a handler called from generated code.
+        bool full_{};                  // True if the code buffer has run out of room.
+
+        auto Self() -> T& { return static_cast<T&>(*this); }
+
+        auto IsStopping() -> bool
+        {
+            if constexpr (HasStopEvents<T>)
+            {
+                return Self().Events() != 0;
+            }
+            else
+            {
+                return Self().IsTrapped();
+            }
+        }
+
+        // Called from generated code to execute a single op at `pc` with the interpreter. Returns false if the block
+        // should stop. Exceptions can't unwind through generated code, so they're caught here and rethrown by RunNative().
+        static auto Step(JitDispatcher* dispatcher, const DecodedOp* op, Address pc) noexcept -> bool
+        {
+            auto& self = dispatcher->Self();
+            try
+            {
+                self.SetNextPc(pc);
+                self.Transfer();
+                self.SetNextPc(pc + 4);
+                dispatcher->Execute(*op);
+            }
+            catch (...)
+            {
+                dispatcher->pending_ = std::current_exception();
+            }
+            return !dispatcher->pending_ && !self.IsTrapped() && !dispatcher->HasDirtyPages();
+        }
+
+        // Operands for a field of the context, and for guest registers.
+
+        static auto Ctx(size_t offset) -> E::Mem { return {.base = E::Rbp, .disp = static_cast<i32>(offset)}; }
+
+        static auto X(Reg r) -> E::Mem { return {.base = E::Rbx, .disp = static_cast<i32>(r * sizeof(u32))}; }
+
+        auto F(Reg r) -> E::Mem
+            requires IsRv32fHandler<T>
+        {
+            const auto xreg = reinterpret_cast<std::intptr_t>(this->xreg_.data());
+            const auto freg = reinterpret_cast<std::intptr_t>(this->freg_.data());
+            return {.base = E::Rbx, .disp = static_cast<i32>(freg - xreg) + static_cast<i32>(r * sizeof(f32))};
+        }
+
+        // Emits the code that all blocks share: the way in from the dispatcher, the way back out, and where unlinked
+        // slots lead. Generated code keeps the context in rbp, the guest's registers in rbx, the dispatcher in r12, the
+        // remaining budget in r13, the memory window in r14 and the code page table in r15, all of which are preserved
+        // across calls to Step().
+        auto EmitTrampolines() -> bool
+        {
+            E e{code_.Next()};
+
+            // void enter(Context* context, void* target)
+            for (auto r : {E::Rbx, E::Rbp, E::R12, E::R13, E::R14, E::R15})
+            {
+                e.Push(r);
+            }
+            e.Op64(E::Alu::Sub, E::Rsp, 8); // Keep the stack 16-byte aligned for calls.
+            e.Mov64(E::Rbp, E::Rdi);
+            e.Mov64(E::Rbx, Ctx(offsetof(Context, xreg)));
+            e.Mov64(E::R12, Ctx(offsetof(Context, dispatcher)));
+            e.Mov64(E::R13, Ctx(offsetof(Context, budget)));
+            e.Mov64(E::R14, Ctx(offsetof(Context, memory)));
+            e.Mov64(E::R15, Ctx(offsetof(Context, codePages)));
+            e.Jmp(E::Rsi);
+
+            const auto exit = e.Size();
+            e.Mov64(Ctx(offsetof(Context, budget)), E::R13);
+            e.Op64(E::Alu::Add, E::Rsp, 8);
+            for (auto r : {E::R15, E::R14, E::R13, E::R12, E::Rbp, E::Rbx})
+            {
+                e.Pop(r);
+            }
+            e.Ret();
+
+            // An unlinked slot leaves with the slot's address in rax.
+            const auto unlinked = e.Size();
+            e.Mov64(Ctx(offsetof(Context, link)), E::Rax);
+            e.Jmp(code_.Next() + exit);
+
+            auto* code = static_cast<u8*>(code_.Commit(e.Code()));
+            if (code == nullptr)
+            {
+                return false;
+            }
+            enter_ = reinterpret_cast<Entry>(code);
+            exit_ = code + exit;
+            unlinked_ = code + unlinked;
+            return true;
+        }
+
+        // Emits a jump to the block at `target`, through a slot if blocks are chained. `pc` is the address of the
+        // instruction that's jumping.
+        auto EmitExit(E& e, Address pc, Address target) -> void
+        {
+            e.Mov(Ctx(offsetof(Context, pc)), pc);
+            e.Mov(Ctx(offsetof(Context, nextPc)), target);
+            if constexpr (canChain)
+            {
+                auto& link = links_.emplace_back(Link{.target = unlinked_, .key = target});
+                e.Mov64(E::Rax, reinterpret_cast<u64>(&link));
+                e.Jmp(E::Mem{.base = E::Rax});
+            }
+            else
+            {
+                e.Jmp(exit_);
+            }
+        }
+
+        // Emits a jump to the block whose address is in ecx. Its slot remembers the last block that it went to.
+        auto EmitIndirectExit(E& e, Address pc) -> void
+        {
+            e.Mov(Ctx(offsetof(Context, pc)), pc);
+            e.Mov(Ctx(offsetof(Context, nextPc)), E::Rcx);
+            if constexpr (canChain)
+            {
+                auto& link = links_.emplace_back(Link{.target = unlinked_, .key = 0});
+                e.Mov64(E::Rax, reinterpret_cast<u64>(&link));
+                e.Op(E::Alu::Cmp, E::Rcx, E::Mem{.base = E::Rax, .disp = static_cast<i32>(offsetof(Link, key))});
+                e.Jcc(E::Cond::NotEqual, unlinked_);
+                e.Jmp(E::Mem{.base = E::Rax});
+            }
+            else
+            {
+                e.Jmp(exit_);
+            }
+        }
+
+        // Emits a call to Step() for `op`, leaving eax non-zero if the block can carry on.
+        static auto EmitStepCall(E& e, const DecodedOp& op, Address pc) -> void
+        {
+            e.Mov64(E::Rdi, E::R12);
+            e.Mov64(E::Rsi, reinterpret_cast<u64>(&op));
+            e.Mov(E::Rdx, pc);
+            e.Mov64(E::Rax, reinterpret_cast<u64>(&Step));
+            e.Call(E::Rax);
+        }
+
+        // Returns the label of a stub that leaves the block after an op that stopped it.
+        static auto StopStub(E& e, std::vector<Stub>& stubs, u32 unexecuted) -> E::Label
+        {
+            const auto label = e.NewLabel();
+            stubs.push_back({.label = label, .op = nullptr, .pc = 0, .resume = 0, .unexecuted = unexecuted});
+            return label;
+        }
+
+        // Emits a call to Step() for `op`, leaving the block if it stops.
+        static auto EmitStep(E& e, std::vector<Stub>& stubs, const DecodedOp& op, Address pc, u32 unexecuted) -> void
+        {
+            EmitStepCall(e, op, pc);
+            e.Test8(E::Rax, E::Rax);
+            e.Jcc(E::Cond::Equal, StopStub(e, stubs, unexecuted));
+        }
+
+        // Emits a load of `size` bytes from the address in eax into eax, going out of line to `stub` if it's outside
+        // the window.
+        auto EmitLoad(E& e, u32 size, bool isSigned, E::Label slow) -> void
+        {
+            e.Op(E::Alu::Cmp, E::Rax, window_.readEnd - size + 1);
+            e.Jcc(E::Cond::AboveOrEqual, slow);
+            const E::Mem m{.base = E::R14, .disp = 0, .index = E::Rax};
+            switch (size)
+            {
+            case 1:
+                isSigned ? e.Movsx8(E::Rax, m) : e.Movzx8(E::Rax, m);
+                break;
+            case 2:
+                isSigned ? e.Movsx16(E::Rax, m) : e.Movzx16(E::Rax, m);
+                break;
+            default:
+                e.Mov(E::Rax, m);
+                break;
+            }
+        }
+
+        // Emits the checks for a store of `size` bytes to the address in eax, going out of line to `slow` if it's
+        // outside the window or on a page that contains cached code.
+        auto EmitStoreChecks(E& e, u32 size, E::Label slow) -> void
+        {
+            e.Mov(E::Rcx, E::Rax);
+            if (window_.writeStart != 0)
+            {
+                e.Op(E::Alu::Sub, E::Rcx, window_.writeStart);
+            }
+            e.Op(E::Alu::Cmp, E::Rcx, window_.writeEnd - window_.writeStart - size + 1);
+            e.Jcc(E::Cond::AboveOrEqual, slow);
+            for (const auto last : {u32{0}, size - 1})
+            {
+                // Check the pages of the first and last bytes.
+                e.Lea(E::Rcx, {.base = E::Rax, .disp = static_cast<i32>(last)});
+                e.Op(E::Shift::Shr, E::Rcx, static_cast<u8>(Base::pageShift));
+                e.Cmp8({.base = E::R15, .disp = 0, .index = E::Rcx}, 0);
+                e.Jcc(E::Cond::NotEqual, slow);
+                if (size == 1)
+                {
+                    break;
+                }
+            }
+        }
+
+        // Emits inline code for `op` at `pc` if it's one that can be compiled inline. Returns false if it isn't.
+        auto EmitInline(E& e, std::vector<Stub>& stubs, const DecodedOp& op, Address pc, u32 unexecuted) -> bool
+        {
+            using Alu = E::Alu;
+            using Shift = E::Shift;
+            using Cond = E::Cond;
+
+            const auto aluImm = [&](Alu alu) {
+                e.Mov(E::Rax, X(op.rs1));
+                e.Op(alu, E::Rax, op.imm);
+                e.Mov(X(op.rd), E::Rax);
+            };
+            const auto aluReg = [&](Alu alu) {
+                e.Mov(E::Rax, X(op.rs1));
+                e.Op(alu, E::Rax, X(op.rs2));
+                e.Mov(X(op.rd), E::Rax);
+            };
+            const auto shiftImm = [&](Shift shift) {
+                e.Mov(E::Rax, X(op.rs1));
+                e.Op(shift, E::Rax, static_cast<u8>(op.imm & 0x1f));
+                e.Mov(X(op.rd), E::Rax);
+            };
+            const auto shiftReg = [&](Shift shift) {
+                e.Mov(E::Rcx, X(op.rs2));
+                e.Mov(E::Rax, X(op.rs1));
+                e.OpCl(shift, E::Rax);
+                e.Mov(X(op.rd), E::Rax);
+            };
+            const auto setImm = [&](Cond cond) {
+                e.Mov(E::Rax, X(op.rs1));
+                e.Op(Alu::Cmp, E::Rax, op.imm);
+                e.Set(cond, E::Rax);
+                e.Mov(X(op.rd), E::Rax);
+            };
+            const auto setReg = [&](Cond cond) {
+                e.Mov(E::Rax, X(op.rs1));
+                e.Op(Alu::Cmp, E::Rax, X(op.rs2));
+                e.Set(cond, E::Rax);
+                e.Mov(X(op.rd), E::Rax);
+            };
+            const auto mulHigh = [&](bool isSigned) {
+                e.Mov(E::Rax, X(op.rs1));
+                e.MulHigh(isSigned, X(op.rs2));
+                e.Mov(X(op.rd), E::Rdx);
+            };
+
+            // Loads and stores go out of line to Step() if they fail a check. Step() executes the whole op again, which
+            // is safe because nothing has been written by then.
+            const auto slowPath = [&]() -> std::pair<E::Label, E::Label> {
+                const auto slow = e.NewLabel();
+                const auto resume = e.NewLabel();
+                stubs.push_back({.label = slow, .op = &op, .pc = pc, .resume = resume, .unexecuted = unexecuted});
+                return {slow, resume};
+            };
+            const auto address = [&]() {
+                e.Mov(E::Rax, X(op.rs1));
+                if (op.imm != 0)
+                {
+                    e.Op(Alu::Add, E::Rax, op.imm);
+                }
+            };
+            const auto load = [&](u32 size, bool isSigned, const E::Mem& rd) {
+                if (window_.readEnd < size)
+                {
+                    return false;
+                }
+                const auto [slow, resume] = slowPath();
+                address();
+                EmitLoad(e, size, isSigned, slow);
+                e.Mov(rd, E::Rax);
+                e.Bind(resume);
+                return true;
+            };
+            const auto store = [&](u32 size, const E::Mem& rs2) {
+                if (window_.writeEnd < window_.writeStart || window_.writeEnd - window_.writeStart < size)
+                {
+                    return false;
+                }
+                const auto [slow, resume] = slowPath();
+                address();
+                EmitStoreChecks(e, size, slow);
+                e.Mov(E::Rcx, rs2);
+                const E::Mem m{.base = E::R14, .disp = 0, .index = E::Rax};
+                size == 1 ? e.Mov8(m, E::Rcx) : size == 2 ? e.Mov16(m, E::Rcx) : e.Mov(m, E::Rcx);
+                e.Bind(resume);
+                return true;
+            };
+
+            switch (op.opc)
+            {
+            case Opcode::Addi:
+            case Opcode::Slti:
+            case Opcode::Sltiu:
+            case Opcode::Xori:
+            case Opcode::Ori:
+            case Opcode::Andi:
+            case Opcode::Slli:
+            case Opcode::Srli:
+            case Opcode::Srai:
+            case Opcode::Add:
+            case Opcode::Sub:
+            case Opcode::Sll:
+            case Opcode::Slt:
+            case Opcode::Sltu:
+            case Opcode::Xor:
+            case Opcode::Srl:
+            case Opcode::Sra:
+            case Opcode::Or:
+            case Opcode::And:
+            case Opcode::Mul:
+            case Opcode::Mulh:
+            case Opcode::Mulhu:
+            case Opcode::Lui:
+            case Opcode::Auipc:
+            case Opcode::Lui_addi:
+                if (op.rd == 0)
+                {
+                    // None of these have side effects, so a write to x0 is a no-op.
+                    return true;
+                }
+                break;
+            case Opcode::Lb:
+            case Opcode::Lh:
+            case Opcode::Lw:
+            case Opcode::Lbu:
+            case Opcode::Lhu:
+            case Opcode::Auipc_lw:
+                if (op.rd == 0)
+                {
+                    // Leave it to the interpreter, which still has to do the load in case it faults.
+                    return false;
+                }
+                break;
+            default:
+                break;
+            }
+
+            switch (op.opc)
+            {
+            case Opcode::Addi:
+                aluImm(Alu::Add);
+                return true;
+            case Opcode::Slti:
+                setImm(Cond::Less);
+                return true;
+            case Opcode::Sltiu:
+                setImm(Cond::Below);
+                return true;
+            case Opcode::Xori:
+                aluImm(Alu::Xor);
+                return true;
+            case Opcode::Ori:
+                aluImm(Alu::Or);
+                return true;
+            case Opcode::Andi:
+                aluImm(Alu::And);
+                return true;
+            case Opcode::Slli:
+                shiftImm(Shift::Shl);
+                return true;
+            case Opcode::Srli:
+                shiftImm(Shift::Shr);
+                return true;
+            case Opcode::Srai:
+                shiftImm(Shift::Sar);
+                return true;
+            case Opcode::Add:
+                aluReg(Alu::Add);
+                return true;
+            case Opcode::Sub:
+                aluReg(Alu::Sub);
+                return true;
+            case Opcode::Sll:
+                shiftReg(Shift::Shl);
+                return true;
+            case Opcode::Slt:
+                setReg(Cond::Less);
+                return true;
+            case Opcode::Sltu:
+                setReg(Cond::Below);
+                return true;
+            case Opcode::Xor:
+                aluReg(Alu::Xor);
+                return true;
+            case Opcode::Srl:
+                shiftReg(Shift::Shr);
+                return true;
+            case Opcode::Sra:
+                shiftReg(Shift::Sar);
+                return true;
+            case Opcode::Or:
+                aluReg(Alu::Or);
+                return true;
+            case Opcode::And:
+                aluReg(Alu::And);
+                return true;
+            case Opcode::Mul:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    e.Mov(E::Rax, X(op.rs1));
+                    e.Imul(E::Rax, X(op.rs2));
+                    e.Mov(X(op.rd), E::Rax);
+                    return true;
+                }
+                return false;
+            case Opcode::Mulh:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    mulHigh(true);
+                    return true;
+                }
+                return false;
+            case Opcode::Mulhu:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    mulHigh(false);
+                    return true;
+                }
+                return false;
+            case Opcode::Lui:
+            case Opcode::Lui_addi:
+                e.Mov(X(op.rd), op.imm);
+                return true;
+            case Opcode::Auipc:
+                e.Mov(X(op.rd), pc + op.imm);
+                return true;
+
+            // Loads and stores.
+            case Opcode::Lb:
+                return load(1, true, X(op.rd));
+            case Opcode::Lh:
+                return load(2, true, X(op.rd));
+            case Opcode::Lw:
+                return load(4, false, X(op.rd));
+            case Opcode::Lbu:
+                return load(1, false, X(op.rd));
+            case Opcode::Lhu:
+                return load(2, false, X(op.rd));
+            case Opcode::Sb:
+                return store(1, X(op.rs2));
+            case Opcode::Sh:
+                return store(2, X(op.rs2));
+            case Opcode::Sw:
+                return store(4, X(op.rs2));
+            case Opcode::Auipc_lw: {
+                // The address is known, so it can be checked now.
+                const auto hi = op.imm - blocks::LowPart(op.imm);
+                const auto target = (op.rs1 == 0 ? 0 : pc + hi) + blocks::LowPart(op.imm);
+                if (window_.readEnd < 4 || target > window_.readEnd - 4 || target > 0x7fffffff)
+                {
+                    return false;
+                }
+                if (op.rs1 != 0)
+                {
+                    e.Mov(X(op.rs1), pc + hi);
+                }
+                e.Mov(E::Rax, E::Mem{.base = E::R14, .disp = static_cast<i32>(target)});
+                e.Mov(X(op.rd), E::Rax);
+                return true;
+            }
+
+            default:
+                break;
+            }
+
+            if constexpr (IsRv32fHandler<T>)
+            {
+                const auto arithmetic = [&](E::Sse sse) {
+                    e.Op(E::Sse::Load, E::Xmm0, F(op.rs1));
+                    e.Op(sse, E::Xmm0, F(op.rs2));
+                    e.Movss(F(op.rd), E::Xmm0);
+                };
+                const auto fused = [&](E::Sse sse) {
+                    e.Op(E::Sse::Load, E::Xmm0, F(op.rs1));
+                    e.Op(E::Sse::Mul, E::Xmm0, F(op.rs2));
+                    e.Op(sse, E::Xmm0, F(op.rs3()));
+                    e.Movss(F(op.rd), E::Xmm0);
+                };
+
+                // Comparisons write to an integer register, so a write to x0 is a no-op.
+                switch (op.opc)
+                {
+                case Opcode::Fmv_x_w:
+                case Opcode::Flt_s:
+                case Opcode::Fle_s:
+                case Opcode::Feq_s:
+                    if (op.rd == 0)
+                    {
+                        return true;
+                    }
+                    break;
+                default:
+                    break;
+                }
+
+                switch (op.opc)
+                {
+                case Opcode::Flw:
+                    return load(4, false, F(op.rd));
+                case Opcode::Fsw:
+                    return store(4, F(op.rs2));
+                case Opcode::Fadd_s:
+                    arithmetic(E::Sse::Add);
+                    return true;
+                case Opcode::Fsub_s:
+                    arithmetic(E::Sse::Sub);
+                    return true;
+                case Opcode::Fmul_s:
+                    arithmetic(E::Sse::Mul);
+                    return true;
+                case Opcode::Fdiv_s:
+                    arithmetic(E::Sse::Div);
+                    return true;
+                case Opcode::Fsqrt_s:
+                    e.Op(E::Sse::Sqrt, E::Xmm0, F(op.rs1));
+                    e.Movss(F(op.rd), E::Xmm0);
+                    return true;
+                case Opcode::Fmadd_s:
+                    fused(E::Sse::Add);
+                    return true;
+                case Opcode::Fmsub_s:
+                    fused(E::Sse::Sub);
+                    return true;
+                case Opcode::Fmv_x_w:
+                    e.Mov(E::Rax, F(op.rs1));
+                    e.Mov(X(op.rd), E::Rax);
+                    return true;
+                case Opcode::Fmv_w_x:
+                    e.Mov(E::Rax, X(op.rs1));
+                    e.Mov(F(op.rd), E::Rax);
+                    return true;
+                case Opcode::Flt_s:
+                    // rs1 < rs2 is rs2 > rs1, which is false if either is a NaN.
+                    e.Op(E::Sse::Load, E::Xmm0, F(op.rs2));
+                    e.Comiss(E::Xmm0, F(op.rs1));
+                    e.Set(Cond::Above, E::Rax);
+                    e.Mov(X(op.rd), E::Rax);
+                    return true;
+                case Opcode::Fle_s:
+                    e.Op(E::Sse::Load, E::Xmm0, F(op.rs2));
+                    e.Comiss(E::Xmm0, F(op.rs1));
+                    e.Set(Cond::AboveOrEqual, E::Rax);
+                    e.Mov(X(op.rd), E::Rax);
+                    return true;
+                case Opcode::Feq_s:
+                    // Equal and ordered.
+                    e.Op(E::Sse::Load, E::Xmm0, F(op.rs1));
+                    e.Comiss(E::Xmm0, F(op.rs2));
+                    e.Set(Cond::Equal, E::Rax);
+                    e.Set(Cond::NoParity, E::Rcx);
+                    e.Op(Alu::And, E::Rax, E::Rcx);
+                    e.Mov(X(op.rd), E::Rax);
+                    return true;
+                default:
+                    break;
+                }
+            }
+            return false;
+        }
+
+        // Emits inline code for `op` at `pc` if it's a branch or jump that ends the block, including the jump to the block
+        // that follows it. Returns false if it isn't.
+        auto EmitEnd(E& e, const DecodedOp& op, Address pc) -> bool
+        {
+            using Cond = E::Cond;
+
+            const auto branch = [&](Cond cond) {
+                const auto taken = e.NewLabel();
+                e.Mov(E::Rax, X(op.rs1));
+                e.Op(E::Alu::Cmp, E::Rax, X(op.rs2));
+                e.Jcc(cond, taken);
+                EmitExit(e, pc, pc + 4);
+                e.Bind(taken);
+                EmitExit(e, pc, pc + op.imm);
+            };
+
+            switch (op.opc)
+            {
+            case Opcode::Beq:
+                branch(Cond::Equal);
+                return true;
+            case Opcode::Bne:
+                branch(Cond::NotEqual);
+                return true;
+            case Opcode::Blt:
+                branch(Cond::Less);
+                return true;
+            case Opcode::Bge:
+                branch(Cond::GreaterOrEqual);
+                return true;
+            case Opcode::Bltu:
+                branch(Cond::Below);
+                return true;
+            case Opcode::Bgeu:
+                branch(Cond::AboveOrEqual);
+                return true;
+            case Opcode::Jal:
+                if (op.rd != 0)
+                {
+                    e.Mov(X(op.rd), pc + 4);
+                }
+                EmitExit(e, pc, pc + op.imm);
+                return true;
+            case Opcode::Jalr:
+                // Read rs1 before writing rd, because they might be the same register.
+                e.Mov(E::Rcx, X(op.rs1));
+                if ((op.imm & ~1u) != 0)
+                {
+                    e.Op(E::Alu::Add, E::Rcx, op.imm & ~1u);
+                }
+                if (op.rd != 0)
+                {
+                    e.Mov(X(op.rd), pc + 4);
+                }
+                EmitIndirectExit(e, pc);
+                return true;
+            case Opcode::Addi_bne: {
+                // The bne is at pc + 4, and compares the addi's result with rs2.
+                const auto taken = e.NewLabel();
+                e.Mov(E::Rax, X(op.rd == 0 ? Reg{0} : Reg{op.rs1}));
+                if (op.rd != 0)
+                {
+                    e.Op(E::Alu::Add, E::Rax, u32(i32(op.imm) >> 20));
+                    e.Mov(X(op.rd), E::Rax);
+                }
+                e.Op(E::Alu::Cmp, E::Rax, X(op.rs2));
+                e.Jcc(Cond::NotEqual, taken);
+                EmitExit(e, pc + 4, pc + 8);
+                e.Bind(taken);
+                EmitExit(e, pc + 4, pc + 4 + u32(i32(op.imm << 19) >> 19));
+                return true;
+            }
+            case Opcode::Auipc_jalr: {
+                // The jalr is at pc + 4, and its target is known.
+                const auto hi = op.imm - blocks::LowPart(op.imm);
+                const auto base = op.rs1 == 0 ? 0 : pc + hi;
+                if (op.rs1 != 0)
+                {
+                    e.Mov(X(op.rs1), base);
+                }
+                if (op.rd != 0)
+                {
+                    e.Mov(X(op.rd), pc + 8);
+                }
+                EmitExit(e, pc + 4, base + (blocks::LowPart(op.imm) & ~1u));
+                return true;
+            }
+            default:
+                return false;
+            }
+        }
+
+        // Compiles `block` into the code buffer, returning nullptr if it won't fit.
+        auto Compile(const Block& block) -> void*
+        {
+            if (enter_ == nullptr && !EmitTrampolines())
+            {
+                full_ = true;
+                return nullptr;
+            }
+
+            E e{code_.Next()};
+            std::vector<Stub> stubs;
+
+            // Leave before doing anything if there isn't enough budget for the whole block.
+            static_assert(Base::maxBlockOps < 128, "The budget check uses an 8-bit immediate.");
+            const auto size = block.ops.size();
+            const auto bail = e.NewLabel();
+            e.Op64(E::Alu::Cmp, E::R13, static_cast<i8>(size));
+            e.Jcc(E::Cond::Below, bail);
+            e.Op64(E::Alu::Sub, E::R13, static_cast<i8>(size));
+
+            auto pc = block.start;
+            for (size_t i = 0; i < size;)
+            {
+                // A fused op covers the op after it too.
+                const auto& op = block.ops[i];
+                const size_t width = blocks::IsFused(op.opc) ? 2 : 1;
+                const auto unexecuted = static_cast<u32>(size - i - width);
+                if (unexecuted != 0 || !EmitEnd(e, op, pc))
+                {
+                    if (!EmitInline(e, stubs, op, pc, unexecuted))
+                    {
+                        EmitStep(e, stubs, op, pc, unexecuted);
+                    }
+                    if (unexecuted == 0)
+                    {
+                        if (blocks::EndsBlock(op.opc))
+                        {
+                            // Something like an ecall that the interpreter has dealt with, leaving pc and nextPc in the core.
+                            e.Mov8(Ctx(offsetof(Context, interpreted)), u8{1});
+                            e.Jmp(exit_);
+                        }
+                        else
+                        {
+                            // The block was cut short, so carry on with the next instruction.
+                            EmitExit(e, pc + 4 * static_cast<Address>(width - 1), pc + 4 * static_cast<Address>(width));
+                        }
+                    }
+                }
+                i += width;
+                pc += 4 * static_cast<Address>(width);
+            }
+
+            e.Bind(bail);
+            e.Mov(Ctx(offsetof(Context, nextPc)), block.start);
+            e.Jmp(exit_);
+
+            // Stubs can add more stubs, so this can't be a range-based for loop.
+            for (size_t i = 0; i < stubs.size(); i++)
+            {
+                const auto stub = stubs[i];
+                e.Bind(stub.label);
+                if (stub.op != nullptr)
+                {
+                    EmitStepCall(e, *stub.op, stub.pc);
+                    e.Test8(E::Rax, E::Rax);
+                    e.Jcc(E::Cond::Equal, StopStub(e, stubs, stub.unexecuted));
+                    e.Jmp(stub.resume);
+                }
+                else
+                {
+                    // Give back the budget for the instructions that weren't executed.
+                    if (stub.unexecuted != 0)
+                    {
+                        e.Op64(E::Alu::Add, E::R13, static_cast<i8>(stub.unexecuted));
+                    }
+                    e.Mov8(Ctx(offsetof(Context, interpreted)), u8{1});
+                    e.Jmp(exit_);
+                }
+            }
+
+            auto* native = code_.Commit(e.Code());
+            full_ = native == nullptr;
+            return native;
+        }
+
+        // Runs generated code from `block` for up to `count` instructions, and returns how many are left.
+        auto RunNative(const Block& block, size_t count) -> size_t
+        {
+            auto& self = Self();
+            context_.xreg = this->xreg_.data();
+            context_.dispatcher = this;
+            context_.memory = window_.base;
+            context_.codePages = this->CodePages(window_.writeEnd);
+            context_.budget = count;
+            context_.link = nullptr;
+            context_.interpreted = false;
+            enter_(&context_, block.native);
+            if (pending_)
+            {
+                std::rethrow_exception(std::exchange(pending_, nullptr));
+            }
+            if (!context_.interpreted)
+            {
+                // Leave pc and nextPc as the interpreter would after the last instruction.
+                self.SetNextPc(context_.pc);
+                self.Transfer();
+                self.SetNextPc(context_.nextPc);
+            }
+            if (context_.link != nullptr)
+            {
+                pendingLink_ = context_.link;
+                pendingTarget_ = context_.nextPc;
+            }
+            return context_.budget;
+        }
+
+        // Throws away blocks on pages that have been written to. Any slot might lead to one of them, so they're all
+        // unlinked.
+        auto Flush() -> void
+        {
+            this->FlushDirtyPages();
+            for (auto& link : links_)
+            {
+                link.target = unlinked_;
+            }
+            pendingLink_ = nullptr;
+        }
+
+    public:
+        using Item = typename T::Item;
+
+        JitDispatcher() = default;
+        JitDispatcher(const JitDispatcher&) = delete;
+        auto operator=(const JitDispatcher&) -> JitDispatcher& = delete;
+
+        // Executes up to `count` instructions, a block at a time, stopping early if the CPU traps or, if it has stop
+        // events, if it's asked to stop.
+        auto Run(size_t count) -> void
+        {
+            auto& self = Self();
+            pendingLink_ = nullptr;
+            if constexpr (canCompile)
+            {
+                if (const auto window = self.Window(); window != window_)
+                {
+                    // The generated code has the window's bounds built in.
+                    Invalidate();
+                    window_ = window;
+                }
+            }
+            if (this->HasDirtyPages())
+            {
+                // A store that hit cached code faulted on the way out of the last run.
+                Flush();
+            }
+            while (count > 0 && !IsStopping())
+            {
+                if (full_)
+                {
+                    // Start again with an empty code buffer.
+                    Invalidate();
+                }
+                auto& block = this->Lookup(self.Transfer());
+                self.SetNextPc(block.start);
+                if constexpr (canCompile)
+                {
+                    if (block.native == nullptr && code_ && ++block.executions == hotThreshold)
+                    {
+                        block.native = Compile(block);
+                    }
+                    if (pendingLink_ != nullptr)
+                    {
+                        // Link the slot that the last block left through to this one, if it's been compiled.
+                        if (block.native != nullptr && block.start == pendingTarget_)
+                        {
+                            pendingLink_->target = block.native;
+                            pendingLink_->key = block.start;
+                        }
+                        pendingLink_ = nullptr;
+                    }
+                }
+                if (block.native != nullptr && count >= block.ops.size())
+                {
+                    count = RunNative(block, count);
+                }
+                else
+                {
+                    this->Interpret(block, count);
+                }
+                if (this->HasDirtyPages())
+                {
+                    Flush();
+                }
+            }
+        }
+
+        // Throws away all cached blocks and their generated code.
+        auto Invalidate() -> void
+        {
+            Base::Invalidate();
+            code_.Reset();
+            links_.clear();
+            pendingLink_ = nullptr;
+            enter_ = nullptr;
+            full_ = false;
+        }
+    };
+
+#else
+
+    // There's no code generator for this platform, so fall back to the block cache.
+    template<IsJitDispatchable T>
+    class JitDispatcher : public blocks::BlockCacheDispatcher<T>
+    {
+    };
+
+#endif // ARVISS_HAS_X86_64_JIT
+
+} // namespace arviss::jit
@@ -0,0 +1,5 @@
+#pragma once
+
+#include "arviss/arviss.h"
+#include "arviss/jit/executors.h"
+#include "arviss/jit/x86_64.h"
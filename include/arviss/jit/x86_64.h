@@ -0,0 +1,476 @@
+#pragma once
+
+#include "arviss/arviss.h"
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+#if !defined(ARVISS_HAS_X86_64_JIT)
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__))
+#define ARVISS_HAS_X86_64_JIT 1
+#else
+#define ARVISS_HAS_X86_64_JIT 0
+#endif
+#endif
+
+#if ARVISS_HAS_X86_64_JIT
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace arviss::jit
+{
+    // A region of memory that generated code is copied into. It's never writable and executable at the same time: each
+    // commit makes the pages that it touches writable, copies the code in, then makes them executable again. Code is
+    // never freed piecemeal. Instead, the whole buffer is reset once it fills up.
+    class CodeBuffer
+    {
+        static constexpr size_t alignment = 16; // Where each piece of code starts.
+
+        u8* base_{};
+        size_t size_{};
+        size_t used_{};
+
+        auto Protect(size_t offset, size_t size, int protection) -> bool
+        {
+            const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            const auto first = offset / pageSize * pageSize;
+            const auto last = (offset + size + pageSize - 1) / pageSize * pageSize;
+            return mprotect(base_ + first, last - first, protection) == 0;
+        }
+
+    public:
+        explicit CodeBuffer(size_t size)
+        {
+            void* p = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p != MAP_FAILED)
+            {
+                base_ = static_cast<u8*>(p);
+                size_ = size;
+            }
+        }
+
+        ~CodeBuffer()
+        {
+            if (base_ != nullptr)
+            {
+                munmap(base_, size_);
+            }
+        }
+
+        CodeBuffer(const CodeBuffer&) = delete;
+        auto operator=(const CodeBuffer&) -> CodeBuffer& = delete;
+
+        // Returns true if the buffer was successfully allocated.
+        explicit operator bool() const { return base_ != nullptr; }
+
+        // Returns the address that the next piece of code will be committed at.
+        auto Next() const -> const u8* { return base_ + (used_ + alignment - 1) / alignment * alignment; }
+
+        // Copies `code` to Next() and returns its address, or nullptr if there isn't enough room.
+        auto Commit(std::span<const u8> code) -> void*
+        {
+            const auto offset = (used_ + alignment - 1) / alignment * alignment;
+            if (offset > size_ || code.size() > size_ - offset || !Protect(offset, code.size(), PROT_READ | PROT_WRITE))
+            {
+                return nullptr;
+            }
+            std::memcpy(base_ + offset, code.data(), code.size());
+            if (!Protect(offset, code.size(), PROT_READ | PROT_EXEC))
+            {
+                return nullptr;
+            }
+            used_ = offset + code.size();
+            return base_ + offset;
+        }
+
+        auto Reset() -> void { used_ = 0; }
+    };
+
+    // A slot that a block jumps through to get to the block that follows it. It starts off pointing at code that leaves
+    // generated code with the slot's address in ctx->link, so that the dispatcher can point it at the following block
+    // once that's been compiled. An indirect jump only follows the slot if its target matches `key`.
+    struct Link
+    {
+        const void* target; // Where to jump to.
+        Address key;        // The guest address of the block at `target`.
+    };
+
+    // What generated code shares with the dispatcher that runs it. Generated code keeps its address in rbp.
+    struct Context
+    {
+        u32* xreg;            // The guest's integer registers, followed by its float registers, if it has them.
+        void* dispatcher;     // The dispatcher, for handlers that call back into the interpreter.
+        u8* memory;           // The host address of guest address 0 in the memory window.
+        const u8* codePages;  // Non-zero for each page that contains cached code.
+        u64 budget;           // The number of instructions that generated code may still execute.
+        Link* link;           // The slot that generated code left through, or nullptr if it can't be linked.
+        Address pc;           // The address of the last instruction that generated code executed...
+        Address nextPc;       // ... and the address of the one after it.
+        bool interpreted;     // True if the interpreter has already left pc and nextPc in the core.
+    };
+
+    // A minimal x86-64 assembler for the JIT. It only knows the handful of instructions that the JIT emits. Jumps to
+    // labels are always rel32, and so are jumps to absolute addresses, which must be within 2GiB of where the code will
+    // be committed, i.e., in the same code buffer.
+    class X64Emitter
+    {
+    public:
+        enum Gpr : u8
+        {
+            Rax,
+            Rcx,
+            Rdx,
+            Rbx,
+            Rsp,
+            Rbp,
+            Rsi,
+            Rdi,
+            R8,
+            R9,
+            R10,
+            R11,
+            R12,
+            R13,
+            R14,
+            R15,
+        };
+
+        enum Xmm : u8
+        {
+            Xmm0,
+            Xmm1,
+        };
+
+        // Condition codes, as the low nibble of Jcc and SETcc.
+        enum class Cond : u8
+        {
+            Below = 0x2,
+            AboveOrEqual = 0x3,
+            Equal = 0x4,
+            NotEqual = 0x5,
+            Above = 0x7,
+            Parity = 0xa,
+            NoParity = 0xb,
+            Less = 0xc,
+            GreaterOrEqual = 0xd,
+        };
+
+        // ALU operations, as the ModRM reg field of their immediate forms.
+        enum class Alu : u8
+        {
+            Add = 0,
+            Or = 1,
+            And = 4,
+            Sub = 5,
+            Xor = 6,
+            Cmp = 7,
+        };
+
+        // Shifts, as the ModRM reg field.
+        enum class Shift : u8
+        {
+            Shl = 4,
+            Shr = 5,
+            Sar = 7,
+        };
+
+        // Scalar single precision operations, as the second opcode byte after F3 0F.
+        enum class Sse : u8
+        {
+            Load = 0x10,
+            Sqrt = 0x51,
+            Add = 0x58,
+            Mul = 0x59,
+            Sub = 0x5c,
+            Div = 0x5e,
+        };
+
+        // A memory operand, [base + index + disp].
+        struct Mem
+        {
+            Gpr base;
+            i32 disp{};
+            Gpr index{Rsp}; // Rsp can't be an index, so it means that there isn't one.
+        };
+
+        using Label = size_t;
+
+    private:
+        const u8* origin_;            // Where the code will be committed.
+        std::vector<u8> code_{};
+        std::vector<size_t> labels_{}; // The offset of each label, once it's bound.
+        struct Fixup
+        {
+            size_t offset; // The offset of a rel32...
+            Label label;   // ... that refers to this label.
+        };
+        std::vector<Fixup> fixups_{};
+
+        static constexpr size_t unbound = ~size_t{};
+
+        auto Emit(std::initializer_list<u8> bytes) -> void { code_.insert(code_.end(), bytes); }
+
+        auto Emit8(u8 value) -> void { code_.push_back(value); }
+
+        auto Emit32(u32 value) -> void
+        {
+            for (auto i = 0; i < 4; i++)
+            {
+                code_.push_back(static_cast<u8>(value >> (8 * i)));
+            }
+        }
+
+        auto Emit64(u64 value) -> void
+        {
+            Emit32(static_cast<u32>(value));
+            Emit32(static_cast<u32>(value >> 32));
+        }
+
+        // Emits a REX prefix if one is needed.
+        auto Rex(bool w, u8 reg, u8 index, u8 base) -> void
+        {
+            const auto rex = static_cast<u8>(0x40 | (w ? 8 : 0) | ((reg & 8) >> 1) | ((index & 8) >> 2) | ((base & 8) >> 3));
+            if (rex != 0x40)
+            {
+                Emit8(rex);
+            }
+        }
+
+        // Emits an instruction whose r/m operand is in memory. `prefix` goes before the REX prefix, if there is one.
+        auto Encode(std::initializer_list<u8> prefix, bool w, std::initializer_list<u8> opcode, u8 reg, Mem m) -> void
+        {
+            Emit(prefix);
+            Rex(w, reg, m.index, m.base);
+            Emit(opcode);
+            const auto needsSib = m.index != Rsp || (m.base & 7) == Rsp;
+            const auto rm = static_cast<u8>(needsSib ? Rsp : (m.base & 7));
+            const auto regField = static_cast<u8>((reg & 7) << 3);
+            if (m.disp == 0 && (m.base & 7) != Rbp)
+            {
+                Emit8(static_cast<u8>(0x00 | regField | rm));
+            }
+            else if (m.disp >= -128 && m.disp <= 127)
+            {
+                Emit8(static_cast<u8>(0x40 | regField | rm));
+            }
+            else
+            {
+                Emit8(static_cast<u8>(0x80 | regField | rm));
+            }
+            if (needsSib)
+            {
+                Emit8(static_cast<u8>(((m.index & 7) << 3) | (m.base & 7)));
+            }
+            if (m.disp != 0 || (m.base & 7) == Rbp)
+            {
+                if (m.disp >= -128 && m.disp <= 127)
+                {
+                    Emit8(static_cast<u8>(m.disp));
+                }
+                else
+                {
+                    Emit32(static_cast<u32>(m.disp));
+                }
+            }
+        }
+
+        // Emits an instruction whose r/m operand is a register.
+        auto Encode(std::initializer_list<u8> prefix, bool w, std::initializer_list<u8> opcode, u8 reg, Gpr rm) -> void
+        {
+            Emit(prefix);
+            Rex(w, reg, 0, rm);
+            Emit(opcode);
+            Emit8(static_cast<u8>(0xc0 | ((reg & 7) << 3) | (rm & 7)));
+        }
+
+        auto Rel32(Label label) -> void
+        {
+            fixups_.push_back({code_.size(), label});
+            Emit32(0);
+        }
+
+        auto Rel32(const void* target) -> void
+        {
+            const auto next = reinterpret_cast<std::ptrdiff_t>(origin_) + static_cast<std::ptrdiff_t>(code_.size() + 4);
+            Emit32(static_cast<u32>(reinterpret_cast<std::ptrdiff_t>(target) - next));
+        }
+
+    public:
+        explicit X64Emitter(const u8* origin) : origin_{origin} {}
+
+        auto NewLabel() -> Label
+        {
+            labels_.push_back(unbound);
+            return labels_.size() - 1;
+        }
+
+        auto Bind(Label label) -> void { labels_[label] = code_.size(); }
+
+        // Returns the number of bytes emitted so far.
+        auto Size() const -> size_t { return code_.size(); }
+
+        // Returns the code, with every jump to a label resolved.
+        auto Code() -> std::span<const u8>
+        {
+            for (const auto& fixup : fixups_)
+            {
+                const auto rel = static_cast<u32>(labels_[fixup.label] - (fixup.offset + 4));
+                std::memcpy(&code_[fixup.offset], &rel, sizeof(rel));
+            }
+            fixups_.clear();
+            return code_;
+        }
+
+        // Moves.
+
+        auto Mov(Gpr dst, Mem src) -> void { Encode({}, false, {0x8b}, dst, src); }           // mov r32, m32
+        auto Mov(Mem dst, Gpr src) -> void { Encode({}, false, {0x89}, src, dst); }           // mov m32, r32
+        auto Mov16(Mem dst, Gpr src) -> void { Encode({0x66}, false, {0x89}, src, dst); }     // mov m16, r16
+        auto Mov8(Mem dst, Gpr src) -> void { Encode({}, false, {0x88}, src, dst); }          // mov m8, r8 (al, cl, dl or bl)
+        auto Mov(Gpr dst, Gpr src) -> void { Encode({}, false, {0x89}, src, dst); }           // mov r32, r32
+        auto Mov64(Gpr dst, Gpr src) -> void { Encode({}, true, {0x89}, src, dst); }          // mov r64, r64
+        auto Mov64(Gpr dst, Mem src) -> void { Encode({}, true, {0x8b}, dst, src); }          // mov r64, m64
+        auto Mov64(Mem dst, Gpr src) -> void { Encode({}, true, {0x89}, src, dst); }          // mov m64, r64
+        auto Movzx8(Gpr dst, Mem src) -> void { Encode({}, false, {0x0f, 0xb6}, dst, src); }  // movzx r32, m8
+        auto Movsx8(Gpr dst, Mem src) -> void { Encode({}, false, {0x0f, 0xbe}, dst, src); }  // movsx r32, m8
+        auto Movzx16(Gpr dst, Mem src) -> void { Encode({}, false, {0x0f, 0xb7}, dst, src); } // movzx r32, m16
+        auto Movsx16(Gpr dst, Mem src) -> void { Encode({}, false, {0x0f, 0xbf}, dst, src); } // movsx r32, m16
+        auto Movzx8(Gpr dst, Gpr src) -> void { Encode({}, false, {0x0f, 0xb6}, dst, src); }  // movzx r32, r8 (al, cl, dl or bl)
+        auto Lea(Gpr dst, Mem src) -> void { Encode({}, false, {0x8d}, dst, src); }           // lea r32, m
+
+        auto Mov(Mem dst, u32 imm) -> void // mov m32, imm32
+        {
+            Encode({}, false, {0xc7}, 0, dst);
+            Emit32(imm);
+        }
+
+        auto Mov8(Mem dst, u8 imm) -> void // mov m8, imm8
+        {
+            Encode({}, false, {0xc6}, 0, dst);
+            Emit8(imm);
+        }
+
+        auto Mov(Gpr dst, u32 imm) -> void // mov r32, imm32
+        {
+            Rex(false, 0, 0, dst);
+            Emit8(static_cast<u8>(0xb8 | (dst & 7)));
+            Emit32(imm);
+        }
+
+        auto Mov64(Gpr dst, u64 imm) -> void // mov r64, imm64
+        {
+            Rex(true, 0, 0, dst);
+            Emit8(static_cast<u8>(0xb8 | (dst & 7)));
+            Emit64(imm);
+        }
+
+        // Arithmetic.
+
+        auto Op(Alu op, Gpr dst, Gpr src) -> void { Encode({}, false, {static_cast<u8>(static_cast<u8>(op) * 8 + 1)}, src, dst); } // op r32, r32
+        auto Op(Alu op, Gpr dst, Mem src) -> void { Encode({}, false, {static_cast<u8>(static_cast<u8>(op) * 8 + 3)}, dst, src); } // op r32, m32
+
+        auto Op(Alu op, Gpr dst, u32 imm) -> void // op r32, imm
+        {
+            if (static_cast<i32>(imm) >= -128 && static_cast<i32>(imm) <= 127)
+            {
+                Encode({}, false, {0x83}, static_cast<u8>(op), dst);
+                Emit8(static_cast<u8>(imm));
+            }
+            else
+            {
+                Encode({}, false, {0x81}, static_cast<u8>(op), dst);
+                Emit32(imm);
+            }
+        }
+
+        auto Op64(Alu op, Gpr dst, i8 imm) -> void // op r64, imm8
+        {
+            Encode({}, true, {0x83}, static_cast<u8>(op), dst);
+            Emit8(static_cast<u8>(imm));
+        }
+
+        auto Cmp8(Mem lhs, u8 imm) -> void // cmp m8, imm8
+        {
+            Encode({}, false, {0x80}, static_cast<u8>(Alu::Cmp), lhs);
+            Emit8(imm);
+        }
+
+        auto Test8(Gpr lhs, Gpr rhs) -> void { Encode({}, false, {0x84}, rhs, lhs); } // test r8, r8 (al, cl, dl or bl)
+
+        auto Op(Shift op, Gpr dst, u8 shamt) -> void // op r32, imm8
+        {
+            Encode({}, false, {0xc1}, static_cast<u8>(op), dst);
+            Emit8(static_cast<u8>(shamt & 0x1f));
+        }
+
+        auto OpCl(Shift op, Gpr dst) -> void { Encode({}, false, {0xd3}, static_cast<u8>(op), dst); } // op r32, cl (masked to 5 bits, as RV32 does)
+
+        auto Imul(Gpr dst, Mem src) -> void { Encode({}, false, {0x0f, 0xaf}, dst, src); } // imul r32, m32
+
+        // edx <- the high 32 bits of eax * src.
+        auto MulHigh(bool isSigned, Mem src) -> void { Encode({}, false, {0xf7}, isSigned ? 5 : 4, src); } // imul / mul m32
+
+        // dst <- cond ? 1 : 0, where dst is al, cl, dl or bl.
+        auto Set(Cond cond, Gpr dst) -> void
+        {
+            Encode({}, false, {0x0f, static_cast<u8>(0x90 | static_cast<u8>(cond))}, 0, dst);
+            Movzx8(dst, dst);
+        }
+
+        // Scalar single precision floating point.
+
+        auto Op(Sse op, Xmm dst, Mem src) -> void { Encode({0xf3}, false, {0x0f, static_cast<u8>(op)}, dst, src); } // op xmm, m32
+        auto Movss(Mem dst, Xmm src) -> void { Encode({0xf3}, false, {0x0f, 0x11}, src, dst); }                     // movss m32, xmm
+        auto Comiss(Xmm lhs, Mem rhs) -> void { Encode({}, false, {0x0f, 0x2f}, lhs, rhs); }                        // comiss xmm, m32
+
+        // Control flow.
+
+        auto Jcc(Cond cond, Label label) -> void
+        {
+            Emit({0x0f, static_cast<u8>(0x80 | static_cast<u8>(cond))});
+            Rel32(label);
+        }
+
+        auto Jcc(Cond cond, const void* target) -> void
+        {
+            Emit({0x0f, static_cast<u8>(0x80 | static_cast<u8>(cond))});
+            Rel32(target);
+        }
+
+        auto Jmp(Label label) -> void
+        {
+            Emit8(0xe9);
+            Rel32(label);
+        }
+
+        auto Jmp(const void* target) -> void
+        {
+            Emit8(0xe9);
+            Rel32(target);
+        }
+
+        auto Jmp(Gpr target) -> void { Encode({}, false, {0xff}, 4, target); }  // jmp r64
+        auto Jmp(Mem target) -> void { Encode({}, false, {0xff}, 4, target); }  // jmp m64
+        auto Call(Gpr target) -> void { Encode({}, false, {0xff}, 2, target); } // call r64
+
+        auto Push(Gpr r) -> void
+        {
+            Rex(false, 0, 0, r);
+            Emit8(static_cast<u8>(0x50 | (r & 7)));
+        }
+
+        auto Pop(Gpr r) -> void
+        {
+            Rex(false, 0, 0, r);
+            Emit8(static_cast<u8>(0x58 | (r & 7)));
+        }
+
+        auto Ret() -> void { Emit8(0xc3); }
+    };
+} // namespace arviss::jit
+
+#endif // ARVISS_HAS_X86_64_JIT
@@ -2,8 +2,12 @@
 
 #include "arviss/arviss.h"
 
+#include <array>
 #include <bit>
+#include <cstring>
 #include <iostream>
+#include <optional>
+#include <span>
 #include <vector>
 
 namespace arviss::platforms::basic
@@ -23,67 +27,100 @@ namespace arviss::platforms::basic
 
     namespace impl
     {
-        // A mixin implementation of a simple, checked address space that can signal bad access. It can have simple TTY
-        // output, but that can be turned off for benchmarking purposes.
-        template<bool has_io = false>
-        class Memory
+        // A mixin implementation of a simple, checked address space that can signal bad access, on top of `Pages`, which
+        // finds the bytes for an address. It can have simple TTY output, but that can be turned off for benchmarking
+        // purposes. By default, a bad access throws a TrappedException. If `reports_faults` is true then it also has
+        // non-throwing accessors that report a bad access through their return value, so that the executor can raise it
+        // as a trap instead.
+        //
+        // `Pages` divides memory into pages of `Pages::pageSize` bytes. `ReadPage(address)` returns the start of the page
+        // that contains `address`, and `WritePage(address)` does the same for a page that's about to be written to.
+        template<typename Pages, bool has_io = false, bool reports_faults = false>
+        class PagedMemory : public Pages
         {
-            // 32KiB of memory. The first 16KiB is read-only.
-            std::vector<u8> mem_ = std::vector<u8>(MEM_SIZE);
+            static constexpr u32 pageSize = Pages::pageSize;
+            static constexpr u32 pageMask = pageSize - 1;
+            static_assert(std::has_single_bit(pageSize) && pageSize <= MEM_SIZE);
 
-        public:
-            auto Read8(Address address) -> u8
+            template<typename U>
+            auto Get(Address address) -> U
             {
-                if (address < mem_.size())
+                U value;
+                if ((address & pageMask) <= pageSize - sizeof(U))
                 {
-                    return mem_[address];
+                    std::memcpy(&value, this->ReadPage(address) + (address & pageMask), sizeof(U));
                 }
-                else if (address == TTY_STATUS)
+                else
                 {
-                    return 1;
+                    // It straddles two pages.
+                    std::array<u8, sizeof(U)> bytes;
+                    for (size_t i = 0; i < sizeof(U); i++)
+                    {
+                        const Address a = address + static_cast<Address>(i);
+                        bytes[i] = this->ReadPage(a)[a & pageMask];
+                    }
+                    std::memcpy(&value, bytes.data(), sizeof(U));
                 }
-                throw TrappedException(TrapType::LoadAccessFault);
+                return value;
             }
 
-            auto Read16(Address address) -> u16
+            template<typename U>
+            auto Put(Address address, U value) -> void
             {
-                if (address < mem_.size() - 1)
+                if ((address & pageMask) <= pageSize - sizeof(U))
                 {
-                    if constexpr (std::endian::native == std::endian::little)
-                    {
-                        auto* p = reinterpret_cast<u16*>(&mem_[address]);
-                        return *p;
-                    }
-                    else if constexpr (std::endian::native == std::endian::big)
+                    std::memcpy(this->WritePage(address) + (address & pageMask), &value, sizeof(U));
+                }
+                else
+                {
+                    // It straddles two pages.
+                    std::array<u8, sizeof(U)> bytes;
+                    std::memcpy(bytes.data(), &value, sizeof(U));
+                    for (size_t i = 0; i < sizeof(U); i++)
                     {
-                        return (mem_[address] << 8) | mem_[address + 1];
+                        const Address a = address + static_cast<Address>(i);
+                        this->WritePage(a)[a & pageMask] = bytes[i];
                     }
                 }
-                throw TrappedException(TrapType::LoadAccessFault);
             }
 
-            auto Read32(Address address) -> u32
+            auto Get8(Address address) -> std::optional<u8>
             {
-                if (address < mem_.size() - 3)
+                if (address < MEM_SIZE)
                 {
-                    if constexpr (std::endian::native == std::endian::little)
-                    {
-                        auto* p = reinterpret_cast<u32*>(&mem_[address]);
-                        return *p;
-                    }
-                    else if constexpr (std::endian::native == std::endian::big)
-                    {
-                        return (mem_[address] << 24) | (mem_[address + 1] << 16) | (mem_[address + 2] << 8) | mem_[address + 3];
-                    }
+                    return this->ReadPage(address)[address & pageMask];
                 }
-                throw TrappedException(TrapType::LoadAccessFault);
+                else if (address == TTY_STATUS)
+                {
+                    return 1;
+                }
+                return {};
             }
 
-            auto Write8Unprotected(Address address, u8 byte) -> void
+            auto Get16(Address address) -> std::optional<u16>
+            {
+                if (address < MEM_SIZE - 1)
+                {
+                    return Get<u16>(address);
+                }
+                return {};
+            }
+
+            auto Get32(Address address) -> std::optional<u32>
+            {
+                if (address < MEM_SIZE - 3)
+                {
+                    return Get<u32>(address);
+                }
+                return {};
+            }
+
+            auto Put8(Address address, u8 byte) -> bool
             {
                 if (address < MEM_SIZE)
                 {
-                    mem_[address] = byte;
+                    this->WritePage(address)[address & pageMask] = byte;
+                    return true;
                 }
                 else if (address == TTY_DATA)
                 {
@@ -91,8 +128,62 @@ namespace arviss::platforms::basic
                     {
                         std::cout << static_cast<char>(byte);
                     }
+                    return true;
                 }
-                else
+                return false;
+            }
+
+            auto Put16(Address address, u16 halfWord) -> bool
+            {
+                if (address < MEM_SIZE - 1)
+                {
+                    Put(address, halfWord);
+                    return true;
+                }
+                return false;
+            }
+
+            auto Put32(Address address, u32 word) -> bool
+            {
+                if (address < MEM_SIZE - 3)
+                {
+                    Put(address, word);
+                    return true;
+                }
+                return false;
+            }
+
+        public:
+            auto Read8(Address address) -> u8
+            {
+                if (const auto byte = Get8(address))
+                {
+                    return *byte;
+                }
+                throw TrappedException(TrapType::LoadAccessFault);
+            }
+
+            auto Read16(Address address) -> u16
+            {
+                if (const auto halfWord = Get16(address))
+                {
+                    return *halfWord;
+                }
+                throw TrappedException(TrapType::LoadAccessFault);
+            }
+
+            auto Read32(Address address) -> u32
+            {
+                if (const auto word = Get32(address))
+                {
+                    return *word;
+                }
+                throw TrappedException(TrapType::LoadAccessFault);
+            }
+
+            auto Write8Unprotected(Address address, u8 byte) -> void
+            {
+                if (!Put8(address, byte))
                 {
                     throw TrappedException(TrapType::StoreAccessFault);
                 }
@@ -110,20 +201,7 @@ namespace arviss::platforms::basic
 
             auto Write16Unprotected(Address address, u16 halfWord) -> void
             {
-                if (address < MEM_SIZE - 1)
-                {
-                    if constexpr (std::endian::native == std::endian::little)
-                    {
-                        auto* p = reinterpret_cast<u16*>(&mem_[address]);
-                        *p = halfWord;
-                    }
-                    else if constexpr (std::endian::native == std::endian::big)
-                    {
-                        mem_[address] = (halfWord >> 8u) & 0xffu;
-                        mem_[address + 1] = halfWord & 0xffu;
-                    }
-                }
-                else
+                if (!Put16(address, halfWord))
                 {
                     throw TrappedException(TrapType::StoreAccessFault);
                 }
@@ -141,22 +219,7 @@ namespace arviss::platforms::basic
 
             auto Write32Unprotected(Address address, u32 word) -> void
             {
-                if (address < MEM_SIZE - 3)
-                {
-                    if constexpr (std::endian::native == std::endian::little)
-                    {
-                        auto* p = reinterpret_cast<u32*>(&mem_[address]);
-                        *p = word;
-                    }
-                    else if constexpr (std::endian::native == std::endian::big)
-                    {
-                        mem_[address] = (word >> 24) & 0xff;
-                        mem_[address + 1] = (word >> 16) & 0xff;
-                        mem_[address + 2] = (word >> 8) & 0xff;
-                        mem_[address + 3] = word & 0xff;
-                    }
-                }
-                else
+                if (!Put32(address, word))
                 {
                     throw TrappedException(TrapType::StoreAccessFault);
                 }
@@ -171,10 +234,92 @@ namespace arviss::platforms::basic
                 }
                 throw TrappedException(TrapType::StoreAccessFault);
             }
+
+            // Non-throwing accessors. These return nothing, or false, if the access is bad.
+
+            auto TryRead8(Address address) -> std::optional<u8>
+                requires reports_faults
+            {
+                return Get8(address);
+            }
+
+            auto TryRead16(Address address) -> std::optional<u16>
+                requires reports_faults
+            {
+                return Get16(address);
+            }
+
+            auto TryRead32(Address address) -> std::optional<u32>
+                requires reports_faults
+            {
+                return Get32(address);
+            }
+
+            auto TryWrite8(Address address, u8 byte) -> bool
+                requires reports_faults
+            {
+                return address >= RAM_START && Put8(address, byte);
+            }
+
+            auto TryWrite16(Address address, u16 halfWord) -> bool
+                requires reports_faults
+            {
+                return address >= RAM_START && Put16(address, halfWord);
+            }
+
+            auto TryWrite32(Address address, u32 word) -> bool
+                requires reports_faults
+            {
+                return address >= RAM_START && Put32(address, word);
+            }
+        };
+
+        // Pages for the basic platform's address space that are all of it, as a single block of host memory.
+        class ContiguousPages
+        {
+        protected:
+            static constexpr u32 pageSize = MEM_SIZE;
+
+            std::vector<u8> mem_ = std::vector<u8>(MEM_SIZE);
+
+            auto ReadPage(Address) -> const u8* { return mem_.data(); }
+            auto WritePage(Address) -> u8* { return mem_.data(); }
+        };
+
+        // The basic platform's address space, held in a single block of host memory.
+        template<bool has_io = false, bool reports_faults = false>
+        class Memory : public PagedMemory<ContiguousPages, has_io, reports_faults>
+        {
+            using ContiguousPages::mem_;
+
+        public:
+            // Copies `image` to `address` with a single bounds check, even if it's in ROM.
+            auto LoadImage(Address address, std::span<const u8> image) -> void
+            {
+                if (address > mem_.size() || image.size() > mem_.size() - address)
+                {
+                    throw TrappedException(TrapType::StoreAccessFault);
+                }
+                if (!image.empty())
+                {
+                    std::memcpy(&mem_[address], image.data(), image.size());
+                }
+            }
+
+            // All of memory can be read directly, but only RAM can be written. TTY I/O goes through the accessors.
+            auto Window() -> MemoryWindow
+                requires(std::endian::native == std::endian::little)
+            {
+                return {.base = mem_.data(), .readEnd = Address{MEM_SIZE}, .writeStart = RAM_START, .writeEnd = Address{MEM_SIZE}};
+            }
         };
     } // namespace impl
 
     using Memory = impl::Memory<true>;
     using MemoryNoIO = impl::Memory<false>;
 
+    // Memory whose loads and stores are raised as traps by the executor rather than thrown as exceptions.
+    using NonThrowingMemory = impl::Memory<true, true>;
+    using NonThrowingMemoryNoIO = impl::Memory<false, true>;
+
 } // namespace arviss::platforms::basic
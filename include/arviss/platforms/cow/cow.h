@@ -0,0 +1,133 @@
+#pragma once
+
+#include "arviss/arviss.h"
+#include "arviss/platforms/basic/basic.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstring>
+#include <memory>
+#include <span>
+
+namespace arviss::platforms::cow
+{
+    // The same address space as the basic platform.
+    using basic::MEM_SIZE;
+    using basic::RAM_START;
+    using basic::ROM_START;
+    using basic::TTY_DATA;
+    using basic::TTY_STATUS;
+
+    namespace impl
+    {
+        constexpr u32 pageShift = 12; // Memory is shared in 4KiB pages.
+        constexpr u32 pageSize = 1 << pageShift;
+        constexpr u32 pageMask = pageSize - 1;
+
+        struct Page
+        {
+            std::array<u8, pageSize> bytes{};
+        };
+
+        // Pages that are shared copy-on-write. Copying them copies a table of page pointers rather than the pages
+        // themselves, and a page is only copied when it's written to while it's shared.
+        //
+        // Copies can be made and used on different threads, but a single copy mustn't be used by two threads at once.
+        // That's enough for WritePage()'s check for sharing to be safe: another copy can stop sharing a page at any
+        // time, but nothing can start sharing it without using this copy.
+        class SharedPages
+        {
+        protected:
+            static constexpr u32 pageSize = impl::pageSize;
+
+            std::array<std::shared_ptr<Page>, MEM_SIZE / pageSize> pages_{};
+
+            auto ReadPage(Address address) -> const u8* { return pages_[address >> pageShift]->bytes.data(); }
+
+            // Returns the page containing `address`, copying it first if it's shared.
+            auto WritePage(Address address) -> u8*
+            {
+                auto& page = pages_[address >> pageShift];
+                if (page.use_count() > 1)
+                {
+                    page = std::make_shared<Page>(*page);
+                }
+                else
+                {
+                    // This is the only copy, but others may have read from the page before they let it go. Their
+                    // reads have to happen before these writes.
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                }
+                return page->bytes.data();
+            }
+
+        public:
+            // Every page starts out as the same zeroed page, so even the first copy of a page is made on demand.
+            SharedPages() { pages_.fill(std::make_shared<Page>()); }
+        };
+
+        // A mixin implementation of the basic platform's address space whose pages are shared copy-on-write. Otherwise it
+        // behaves exactly like `basic::impl::Memory`.
+        template<bool has_io = false, bool reports_faults = false>
+        class Memory : public basic::impl::PagedMemory<SharedPages, has_io, reports_faults>
+        {
+            using SharedPages::pages_;
+
+        public:
+            // Copies `image` to `address` with a single bounds check, even if it's in ROM. Pages that it covers completely
+            // are replaced rather than copied.
+            auto LoadImage(Address address, std::span<const u8> image) -> void
+            {
+                if (address > MEM_SIZE || image.size() > MEM_SIZE - address)
+                {
+                    throw TrappedException(TrapType::StoreAccessFault);
+                }
+                while (!image.empty())
+                {
+                    const auto offset = address & pageMask;
+                    const auto size = std::min<size_t>(pageSize - offset, image.size());
+                    auto& page = pages_[address >> pageShift];
+                    if (size == pageSize)
+                    {
+                        page = std::make_shared<Page>();
+                    }
+                    std::memcpy(this->WritePage(address) + offset, image.data(), size);
+                    address += static_cast<Address>(size);
+                    image = image.subspan(size);
+                }
+            }
+        };
+    } // namespace impl
+
+    using Memory = impl::Memory<true>;
+    using MemoryNoIO = impl::Memory<false>;
+    using NonThrowingMemory = impl::Memory<true, true>;
+    using NonThrowingMemoryNoIO = impl::Memory<false, true>;
+
+    static_assert(HasMemory<Memory>);
+    static_assert(HasUnprotectedWrites<Memory>);
+    static_assert(HasImageLoading<Memory>);
+    static_assert(HasNonThrowingMemory<NonThrowingMemory>);
+
+    // A frozen copy of a CPU's complete state: pc, registers, traps and memory. Forking it gives a new CPU that carries
+    // on from where the snapshot was taken. With copy-on-write memory a fork costs a copy of the registers and the page
+    // table, and pages are only copied when the fork stores to them. A snapshot can be forked from several threads at
+    // once.
+    template<std::copy_constructible Cpu>
+    class Snapshot
+    {
+        Cpu cpu_;
+
+    public:
+        explicit Snapshot(const Cpu& cpu) : cpu_{cpu} {}
+
+        auto Fork() const -> Cpu { return cpu_; }
+        auto ForkUnique() const -> std::unique_ptr<Cpu> { return std::make_unique<Cpu>(cpu_); }
+
+        // The CPU as it was when the snapshot was taken.
+        auto State() const -> const Cpu& { return cpu_; }
+    };
+
+} // namespace arviss::platforms::cow
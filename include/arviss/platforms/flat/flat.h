@@ -0,0 +1,371 @@
+#pragma once
+
+#include "arviss/arviss.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <span>
+#include <system_error>
+#include <vector>
+
+// Flat memory relies on mmap() to reserve the guest's address space and on the x86-64 page fault error code to tell
+// loads from stores, so it's only available on x86-64 Linux and macOS.
+#if !defined(ARVISS_HAS_FLAT_MEMORY)
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__))
+#define ARVISS_HAS_FLAT_MEMORY 1
+#else
+#define ARVISS_HAS_FLAT_MEMORY 0
+#endif
+#endif
+
+#if ARVISS_HAS_FLAT_MEMORY
+
+#include <csetjmp>
+#include <csignal>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+namespace arviss::platforms::flat
+{
+    namespace impl
+    {
+        constexpr u64 reservationSize = u64{1} << 32; // The whole 32-bit guest address space.
+        constexpr u64 guardSize = 1 << 16;            // A guard region after it, so that no access can run off the end.
+
+        // Where to go when a guarded access faults, and what the fault was.
+        struct Landing
+        {
+            sigjmp_buf env;
+            const u8* base;
+            volatile Address address;
+            volatile bool isStore;
+        };
+
+        inline thread_local Landing* landing = nullptr;
+        inline struct sigaction previousSegvAction = {};
+        inline struct sigaction previousBusAction = {};
+
+        inline auto IsStore(void* context) -> bool
+        {
+            const auto* uc = static_cast<const ucontext_t*>(context);
+#if defined(__APPLE__)
+            return (uc->uc_mcontext->__es.__err & 2) != 0;
+#else
+            return (uc->uc_mcontext.gregs[REG_ERR] & 2) != 0;
+#endif
+        }
+
+        inline auto OnFault(int sig, siginfo_t* info, void* context) -> void
+        {
+            auto* l = landing;
+            const auto* address = static_cast<const u8*>(info->si_addr);
+            if (l != nullptr && address >= l->base && address < l->base + reservationSize + guardSize)
+            {
+                l->address = static_cast<Address>(address - l->base);
+                l->isStore = IsStore(context);
+                siglongjmp(l->env, 1);
+            }
+
+            // It isn't ours, so hand it on.
+            const auto& previous = sig == SIGBUS ? previousBusAction : previousSegvAction;
+            if ((previous.sa_flags & SA_SIGINFO) != 0 && previous.sa_sigaction != nullptr)
+            {
+                previous.sa_sigaction(sig, info, context);
+            }
+            else if (previous.sa_handler != SIG_DFL && previous.sa_handler != SIG_IGN)
+            {
+                previous.sa_handler(sig);
+            }
+            else
+            {
+                // Restore the default action and return so that the faulting instruction faults again.
+                signal(sig, SIG_DFL);
+            }
+        }
+
+        inline auto InstallFaultHandler() -> void
+        {
+            static std::once_flag once;
+            std::call_once(once, [] {
+                struct sigaction action = {};
+                action.sa_sigaction = OnFault;
+                action.sa_flags = SA_SIGINFO | SA_NODEFER;
+                sigemptyset(&action.sa_mask);
+                sigaction(SIGSEGV, &action, &previousSegvAction);
+                sigaction(SIGBUS, &action, &previousBusAction); // macOS reports protection faults as SIGBUS.
+            });
+        }
+    } // namespace impl
+
+    // A mixin implementation of a flat address space that reserves all 4GiB of the guest's address space up front and
+    // commits only the regions that are mapped with Map(). Guest loads and stores are plain pointer accesses with no
+    // bounds checks. Instead, everything that isn't mapped is PROT_NONE, read-only regions are PROT_READ, and an access
+    // that faults is turned into a trap by Guarded(), which sched::RunFor() and sched::RunUntilStopped() call for it.
+    // Unprotected writes are for the host, so they're checked, and throw a TrappedException if they miss every region.
+    class Memory
+    {
+        struct Region
+        {
+            Address start;
+            u64 size;
+            bool isWritable;
+        };
+
+        u8* base_{};
+        std::vector<Region> regions_{};
+
+        static auto PageSize() -> u64 { return static_cast<u64>(sysconf(_SC_PAGESIZE)); }
+
+        // Returns the index of the region containing `address`, or the number of regions if it isn't mapped. Regions are
+        // kept sorted and never overlap, so it can only be the last one that starts at or before `address`.
+        auto FindRegion(Address address) const -> size_t
+        {
+            auto it = std::upper_bound(regions_.begin(), regions_.end(), address, [](Address a, const Region& r) { return a < r.start; });
+            if (it == regions_.begin() || address - std::prev(it)->start >= std::prev(it)->size)
+            {
+                return regions_.size();
+            }
+            return static_cast<size_t>(std::prev(it) - regions_.begin());
+        }
+
+        // Records a newly mapped region, trimming or splitting any that it replaces.
+        auto AddRegion(const Region& region) -> void
+        {
+            const u64 start = region.start;
+            const u64 end = start + region.size;
+            std::vector<Region> regions;
+            regions.reserve(regions_.size() + 2);
+            for (const auto& r : regions_)
+            {
+                const u64 rStart = r.start;
+                const u64 rEnd = rStart + r.size;
+                if (rEnd <= start || rStart >= end)
+                {
+                    regions.push_back(r);
+                    continue;
+                }
+                if (rStart < start)
+                {
+                    regions.push_back({.start = r.start, .size = start - rStart, .isWritable = r.isWritable});
+                }
+                if (rEnd > end)
+                {
+                    regions.push_back({.start = static_cast<Address>(end), .size = rEnd - end, .isWritable = r.isWritable});
+                }
+            }
+            regions.push_back(region);
+            std::sort(regions.begin(), regions.end(), [](const Region& a, const Region& b) { return a.start < b.start; });
+            regions_ = std::move(regions);
+        }
+
+        // Copies `size` bytes to guest memory on behalf of the host, temporarily unprotecting read-only pages. Nothing
+        // is written unless every byte is in a mapped region.
+        auto WriteUnprotected(Address address, const void* data, u32 size) -> void
+        {
+            const u64 end = static_cast<u64>(address) + size;
+            if (end > impl::reservationSize)
+            {
+                throw TrappedException(TrapType::StoreAccessFault);
+            }
+            // As regions don't overlap, the range is mapped if it's covered by consecutive regions with no gaps.
+            const auto endOf = [this](size_t i) { return regions_[i].start + regions_[i].size; };
+            const auto first = FindRegion(address);
+            auto last = first;
+            if (first == regions_.size())
+            {
+                throw TrappedException(TrapType::StoreAccessFault);
+            }
+            while (endOf(last) < end)
+            {
+                if (last + 1 == regions_.size() || regions_[last + 1].start != endOf(last))
+                {
+                    throw TrappedException(TrapType::StoreAccessFault);
+                }
+                ++last;
+            }
+
+            // Regions are whole pages, so unprotecting the pages that a piece touches never reaches outside its region.
+            const auto pageSize = PageSize();
+            const auto* bytes = static_cast<const u8*>(data);
+            u64 a = address;
+            for (auto i = first; i <= last; i++)
+            {
+                const auto& r = regions_[i];
+                const u64 pieceEnd = std::min(end, r.start + r.size);
+                if (r.isWritable)
+                {
+                    std::memcpy(base_ + a, bytes + (a - address), pieceEnd - a);
+                }
+                else
+                {
+                    const u64 firstPage = a & ~(pageSize - 1);
+                    const u64 lastPage = (pieceEnd + pageSize - 1) & ~(pageSize - 1);
+                    mprotect(base_ + firstPage, lastPage - firstPage, PROT_READ | PROT_WRITE);
+                    std::memcpy(base_ + a, bytes + (a - address), pieceEnd - a);
+                    mprotect(base_ + firstPage, lastPage - firstPage, PROT_READ);
+                }
+                a = pieceEnd;
+            }
+        }
+
+    public:
+        // Reserves the address space. Throws a std::system_error if it can't.
+        Memory()
+        {
+            void* p = mmap(nullptr, impl::reservationSize + impl::guardSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (p == MAP_FAILED)
+            {
+                throw std::system_error(errno, std::generic_category(), "flat::Memory couldn't reserve the guest's address space");
+            }
+            base_ = static_cast<u8*>(p);
+            impl::InstallFaultHandler();
+        }
+
+        ~Memory() { munmap(base_, impl::reservationSize + impl::guardSize); }
+
+        Memory(const Memory&) = delete;
+        auto operator=(const Memory&) -> Memory& = delete;
+
+        // Commits `size` bytes of zeroed memory at `start`, rounded out to whole pages, replacing anything that was
+        // mapped there before. If `isWritable` is false then the guest can only read it. Returns false if the region
+        // couldn't be mapped.
+        auto Map(Address start, u64 size, bool isWritable = true) -> bool
+        {
+            const auto pageSize = PageSize();
+            const u64 first = start & ~(pageSize - 1);
+            const u64 last = std::min((static_cast<u64>(start) + size + pageSize - 1) & ~(pageSize - 1), impl::reservationSize);
+            if (size == 0 || first >= last)
+            {
+                return false;
+            }
+            const int protection = isWritable ? PROT_READ | PROT_WRITE : PROT_READ;
+            const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_NORESERVE;
+            if (mmap(base_ + first, static_cast<size_t>(last - first), protection, flags, -1, 0) == MAP_FAILED)
+            {
+                return false;
+            }
+            AddRegion({.start = static_cast<Address>(first), .size = last - first, .isWritable = isWritable});
+            return true;
+        }
+
+        // Copies `image` to `address`, even if it's in a read-only region. Throws a TrappedException if it isn't
+        // entirely within mapped regions.
+        auto LoadImage(Address address, std::span<const u8> image) -> void
+        {
+            if (image.size() > impl::reservationSize - address)
+            {
+                throw TrappedException(TrapType::StoreAccessFault);
+            }
+            if (!image.empty())
+            {
+                WriteUnprotected(address, image.data(), static_cast<u32>(image.size()));
+            }
+        }
+
+        // Maps the file at `path` read-only at `start`, which must be page aligned, without copying it. The rest of its
+        // last page reads as zero. Stores by the guest fault as they do for any other read-only region. Unprotected
+        // writes from the host, e.g., by the Remix transcoder, go to a private copy of the page, and the file isn't
+        // changed. Returns false if the file couldn't be mapped.
+        auto MapImage(Address start, const char* path) -> bool
+        {
+            const int fd = open(path, O_RDONLY);
+            if (fd < 0)
+            {
+                return false;
+            }
+            struct stat st = {};
+            const bool ok = fstat(fd, &st) == 0 && MapImage(start, fd, 0, static_cast<u64>(st.st_size));
+            close(fd); // The mapping keeps the file open.
+            return ok;
+        }
+
+        // As above, but maps `size` bytes of the open file `fd`, starting at `offset`, which must also be page aligned.
+        // Like Map(), it replaces anything that was mapped there before.
+        auto MapImage(Address start, int fd, u64 offset, u64 size) -> bool
+        {
+            const auto pageSize = PageSize();
+            if (size == 0 || size > impl::reservationSize - start || ((start | offset) & (pageSize - 1)) != 0)
+            {
+                return false;
+            }
+            if (mmap(base_ + start, static_cast<size_t>(size), PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, static_cast<off_t>(offset)) == MAP_FAILED)
+            {
+                return false;
+            }
+            AddRegion({.start = start, .size = std::min((size + pageSize - 1) & ~(pageSize - 1), impl::reservationSize - start), .isWritable = false});
+            return true;
+        }
+
+        // Calls `run()`, returning true if it ran to completion. If an access to guest memory faults while it's running
+        // then `run()` is abandoned, the fault is raised on `cpu` as a trap with the guest address as its context, and it
+        // returns false. A fault in the instruction at the program counter is an InstructionAccessFault, as a load from
+        // the instruction's own bytes can only fault if fetching it did. Otherwise it's a LoadAccessFault or a
+        // StoreAccessFault.
+        //
+        // As the fault is recovered with siglongjmp(), nothing between this and the access can rely on its destructor
+        // being called. That's true of the CPUs, the Remix dispatchers and the scheduler's run loop, but not of the block
+        // cache or the JIT, so they can't be guarded. See NeedsUnwinding.
+        template<typename Cpu, typename F>
+        auto Guarded(Cpu& cpu, F&& run) -> bool
+        {
+            static_assert(!NeedsUnwinding<Cpu>, "Flat memory can't recover from faults in a CPU that needs unwinding");
+
+            impl::Landing l{.env = {}, .base = base_, .address = 0, .isStore = false};
+            auto* previous = impl::landing;
+            impl::landing = &l;
+            if (sigsetjmp(l.env, 0) == 0) // The handler doesn't block the signal, so there's no mask to restore.
+            {
+                run();
+                impl::landing = previous;
+                return true;
+            }
+            impl::landing = previous;
+            if (l.isStore)
+            {
+                cpu.RaiseTrap(TrapType::StoreAccessFault, l.address);
+            }
+            else
+            {
+                const bool isFetch = l.address - cpu.Pc() < 4;
+                cpu.RaiseTrap(isFetch ? TrapType::InstructionAccessFault : TrapType::LoadAccessFault, l.address);
+            }
+            return false;
+        }
+
+        auto Read8(Address address) -> u8 { return base_[address]; }
+
+        auto Read16(Address address) -> u16
+        {
+            u16 halfWord;
+            std::memcpy(&halfWord, base_ + address, sizeof(halfWord));
+            return halfWord;
+        }
+
+        auto Read32(Address address) -> u32
+        {
+            u32 word;
+            std::memcpy(&word, base_ + address, sizeof(word));
+            return word;
+        }
+
+        auto Write8(Address address, u8 byte) -> void { base_[address] = byte; }
+        auto Write16(Address address, u16 halfWord) -> void { std::memcpy(base_ + address, &halfWord, sizeof(halfWord)); }
+        auto Write32(Address address, u32 word) -> void { std::memcpy(base_ + address, &word, sizeof(word)); }
+
+        auto Write8Unprotected(Address address, u8 byte) -> void { WriteUnprotected(address, &byte, sizeof(byte)); }
+        auto Write16Unprotected(Address address, u16 halfWord) -> void { WriteUnprotected(address, &halfWord, sizeof(halfWord)); }
+        auto Write32Unprotected(Address address, u32 word) -> void { WriteUnprotected(address, &word, sizeof(word)); }
+    };
+
+    static_assert(HasMemory<Memory>);
+    static_assert(HasUnprotectedWrites<Memory>);
+    static_assert(HasImageLoading<Memory>);
+
+} // namespace arviss::platforms::flat
+
+#endif // ARVISS_HAS_FLAT_MEMORY
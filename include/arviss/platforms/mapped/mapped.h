@@ -0,0 +1,476 @@
+#pragma once
+
+#include "arviss/arviss.h"
+#include "arviss/platforms/basic/basic.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+// ARVISS_NOINLINE keeps a slow path out of line, so that it isn't copied into every caller of the fast path.
+#if defined(__has_cpp_attribute)
+#if __has_cpp_attribute(gnu::noinline)
+#define ARVISS_NOINLINE [[gnu::noinline]]
+#endif
+#endif
+#if !defined(ARVISS_NOINLINE)
+#define ARVISS_NOINLINE
+#endif
+
+namespace arviss::platforms::mapped
+{
+    // A memory-mapped device. Each access is given its offset from the start of the device's region and its size in
+    // bytes, which is 1, 2 or 4. Multi-byte values are little-endian, as they are in guest memory.
+    class Device
+    {
+    public:
+        virtual ~Device() = default;
+
+        // Returns the value at `offset`, or nothing if it can't be read, which raises a LoadAccessFault.
+        virtual auto Read(Address offset, u32 size) -> std::optional<u32> = 0;
+
+        // Writes `value` to `offset`. Returns false if it can't be written, which raises a StoreAccessFault.
+        virtual auto Write(Address offset, u32 size, u32 value) -> bool = 0;
+    };
+
+    // The basic platform's TTY. Its status byte always reads as writable, and bytes written to its data byte go to
+    // `out`, or nowhere if there isn't one. Any other access faults.
+    class Console : public Device
+    {
+        std::ostream* out_;
+
+    public:
+        static constexpr Address STATUS = 0;
+        static constexpr Address DATA = 1;
+
+        explicit Console(std::ostream* out = nullptr) : out_{out} {}
+
+        auto Read(Address offset, u32 size) -> std::optional<u32> override
+        {
+            if (offset == STATUS && size == 1)
+            {
+                return 1;
+            }
+            return {};
+        }
+
+        auto Write(Address offset, u32 size, u32 value) -> bool override
+        {
+            if (offset != DATA || size != 1)
+            {
+                return false;
+            }
+            if (out_ != nullptr)
+            {
+                *out_ << static_cast<char>(value);
+            }
+            return true;
+        }
+    };
+
+    namespace impl
+    {
+        constexpr u32 pageShift = 12; // Regions are mapped in 4KiB pages.
+        constexpr u32 pageSize = 1 << pageShift;
+        constexpr u32 pageMask = pageSize - 1;
+
+        // What a page is. The order matters, as anything up to Rom is backed by bytes.
+        enum class Kind : u8
+        {
+            Ram,
+            Rom,
+            Device,
+            Unmapped,
+        };
+
+        struct Page
+        {
+            Kind kind{Kind::Unmapped};
+            size_t offset{};  // Where a RAM or ROM page's bytes are in the backing store.
+            Device* device{}; // The device on a device page.
+            Address base{};   // The start of the device's region.
+        };
+
+        // A mixin implementation of an address space that is described by a table with an entry for every 4KiB page. A
+        // page is RAM, ROM, part of a device's region, or unmapped. An access to RAM or ROM costs a bounds check and a
+        // table lookup, and only an access that misses, i.e., one to a device, to an unmapped page, or that straddles
+        // two pages, takes the slow path. Devices can be added without touching the fast path.
+        //
+        // By default, a bad access throws a TrappedException. If `reports_faults` is true then it also has non-throwing
+        // accessors that report a bad access through their return value. Copies share their devices.
+        template<bool reports_faults = false>
+        class Memory
+        {
+            std::vector<Page> pages_{};                      // Indexed by page, up to the last mapped page.
+            std::vector<u8> bytes_{};                        // The backing store for RAM and ROM.
+            std::vector<std::shared_ptr<Device>> devices_{}; // Keeps the devices alive.
+            std::vector<u8*> readable_{};                    // For the fast path, each RAM or ROM page's bytes, or null.
+            std::vector<u8*> writable_{};                    // Likewise, but only for RAM pages.
+
+            // Points the fast path's tables at the backing store, which is needed whenever it moves.
+            auto Rebuild() -> void
+            {
+                readable_.resize(pages_.size());
+                writable_.resize(pages_.size());
+                for (size_t i = 0; i < pages_.size(); i++)
+                {
+                    readable_[i] = pages_[i].kind <= Kind::Rom ? bytes_.data() + pages_[i].offset : nullptr;
+                    writable_[i] = pages_[i].kind == Kind::Ram ? readable_[i] : nullptr;
+                }
+            }
+
+            // Returns the page containing `address`, or nothing if it's beyond the last mapped page.
+            auto Find(Address address) -> Page*
+            {
+                const Address page = address >> pageShift;
+                return page < pages_.size() ? &pages_[page] : nullptr;
+            }
+
+            // Returns the pages that cover `size` bytes at `start`, extending the table if necessary, for the caller to
+            // map. Returns nothing if there's nothing to map or it runs off the end of the address space.
+            auto MapPages(Address start, u64 size) -> std::span<Page>
+            {
+                const u64 first = start >> pageShift;
+                const u64 last = (static_cast<u64>(start) + size + pageMask) >> pageShift;
+                if (size == 0 || last > (u64{1} << (32 - pageShift)))
+                {
+                    return {};
+                }
+                if (last > pages_.size())
+                {
+                    pages_.resize(last);
+                }
+                return std::span(pages_).subspan(first, last - first);
+            }
+
+            // Maps the pages as RAM or ROM. A page that's already one or the other keeps its bytes in the backing store,
+            // cleared, so that remapping a region doesn't grow it.
+            auto MapMemory(Address start, u64 size, Kind kind) -> bool
+            {
+                const auto pages = MapPages(start, size);
+                const auto added = std::count_if(pages.begin(), pages.end(), [](const Page& page) { return page.kind > Kind::Rom; });
+                auto offset = bytes_.size();
+                bytes_.resize(offset + static_cast<size_t>(added) * pageSize);
+                for (auto& page : pages)
+                {
+                    if (page.kind <= Kind::Rom)
+                    {
+                        std::memset(bytes_.data() + page.offset, 0, pageSize);
+                        page = Page{.kind = kind, .offset = page.offset};
+                    }
+                    else
+                    {
+                        page = Page{.kind = kind, .offset = offset};
+                        offset += pageSize;
+                    }
+                }
+                Rebuild();
+                return !pages.empty();
+            }
+
+            // A load or store that isn't to a single RAM or ROM page. Each byte of one that straddles two pages must be
+            // in RAM or ROM, as a device only sees whole accesses.
+            template<typename U>
+            ARVISS_NOINLINE auto GetSlow(Address address) -> std::optional<U>
+            {
+                const auto* p = Find(address);
+                if (p == nullptr)
+                {
+                    return {};
+                }
+                if (p->kind == Kind::Device && (address & pageMask) <= pageSize - sizeof(U))
+                {
+                    if (const auto value = p->device->Read(address - p->base, sizeof(U)))
+                    {
+                        return static_cast<U>(*value);
+                    }
+                    return {};
+                }
+                U value = 0;
+                for (u32 i = 0; i < sizeof(U); i++)
+                {
+                    const auto* q = Find(address + i);
+                    if (q == nullptr || q->kind > Kind::Rom)
+                    {
+                        return {};
+                    }
+                    value |= static_cast<U>(static_cast<U>(bytes_[q->offset + ((address + i) & pageMask)]) << (8 * i));
+                }
+                return value;
+            }
+
+            template<typename U>
+            auto Get(Address address) -> std::optional<U>
+            {
+                const Address page = address >> pageShift;
+                if (page < readable_.size() && readable_[page] != nullptr && (address & pageMask) <= pageSize - sizeof(U))
+                {
+                    U value;
+                    std::memcpy(&value, readable_[page] + (address & pageMask), sizeof(U));
+                    return value;
+                }
+                return GetSlow<U>(address);
+            }
+
+            template<typename U>
+            ARVISS_NOINLINE auto PutSlow(Address address, U value, Kind writable) -> bool
+            {
+                const auto* p = Find(address);
+                if (p == nullptr)
+                {
+                    return false;
+                }
+                if (p->kind == Kind::Device && (address & pageMask) <= pageSize - sizeof(U))
+                {
+                    return p->device->Write(address - p->base, sizeof(U), value);
+                }
+                // Check every byte before storing any of them, so that a store that faults changes nothing.
+                std::array<size_t, sizeof(U)> offsets;
+                for (u32 i = 0; i < sizeof(U); i++)
+                {
+                    const auto* q = Find(address + i);
+                    if (q == nullptr || q->kind > writable)
+                    {
+                        return false;
+                    }
+                    offsets[i] = q->offset + ((address + i) & pageMask);
+                }
+                for (u32 i = 0; i < sizeof(U); i++)
+                {
+                    bytes_[offsets[i]] = static_cast<u8>(value >> (8 * i));
+                }
+                return true;
+            }
+
+            // Stores `value` at `address` if it's in RAM, or if `writable` is Kind::Rom, in RAM or ROM.
+            template<typename U>
+            auto Put(Address address, U value, Kind writable = Kind::Ram) -> bool
+            {
+                const Address page = address >> pageShift;
+                const auto& pointers = writable == Kind::Rom ? readable_ : writable_;
+                if (page < pointers.size() && pointers[page] != nullptr && (address & pageMask) <= pageSize - sizeof(U))
+                {
+                    std::memcpy(pointers[page] + (address & pageMask), &value, sizeof(U));
+                    return true;
+                }
+                return PutSlow(address, value, writable);
+            }
+
+        public:
+            Memory() = default;
+
+            Memory(const Memory& other) : pages_{other.pages_}, bytes_{other.bytes_}, devices_{other.devices_} { Rebuild(); }
+
+            auto operator=(const Memory& other) -> Memory&
+            {
+                pages_ = other.pages_;
+                bytes_ = other.bytes_;
+                devices_ = other.devices_;
+                Rebuild();
+                return *this;
+            }
+
+            Memory(Memory&&) = default;
+            auto operator=(Memory&&) -> Memory& = default;
+
+            // Maps `size` bytes of zeroed RAM at `start`, rounded out to whole pages, replacing whatever was there.
+            // Returns false if there's nothing to map or it runs off the end of the address space.
+            auto MapRam(Address start, u64 size) -> bool { return MapMemory(start, size, Kind::Ram); }
+
+            // As above, but for ROM, which the guest can only read. Use LoadImage() or an unprotected write to fill it.
+            auto MapRom(Address start, u64 size) -> bool { return MapMemory(start, size, Kind::Rom); }
+
+            // Maps `device` to `size` bytes at `start`, which must be page aligned, rounded up to whole pages. Returns
+            // false if the region can't be mapped.
+            auto MapDevice(Address start, u64 size, std::shared_ptr<Device> device) -> bool
+            {
+                if ((start & pageMask) != 0 || device == nullptr)
+                {
+                    return false;
+                }
+                const auto pages = MapPages(start, size);
+                std::fill(pages.begin(), pages.end(), Page{.kind = Kind::Device, .device = device.get(), .base = start});
+                if (pages.empty())
+                {
+                    return false;
+                }
+                devices_.push_back(std::move(device));
+                Rebuild();
+                return true;
+            }
+
+            auto Read8(Address address) -> u8
+            {
+                if (const auto byte = Get<u8>(address))
+                {
+                    return *byte;
+                }
+                throw TrappedException(TrapType::LoadAccessFault);
+            }
+
+            auto Read16(Address address) -> u16
+            {
+                if (const auto halfWord = Get<u16>(address))
+                {
+                    return *halfWord;
+                }
+                throw TrappedException(TrapType::LoadAccessFault);
+            }
+
+            auto Read32(Address address) -> u32
+            {
+                if (const auto word = Get<u32>(address))
+                {
+                    return *word;
+                }
+                throw TrappedException(TrapType::LoadAccessFault);
+            }
+
+            auto Write8(Address address, u8 byte) -> void
+            {
+                if (!Put(address, byte))
+                {
+                    throw TrappedException(TrapType::StoreAccessFault);
+                }
+            }
+
+            auto Write16(Address address, u16 halfWord) -> void
+            {
+                if (!Put(address, halfWord))
+                {
+                    throw TrappedException(TrapType::StoreAccessFault);
+                }
+            }
+
+            auto Write32(Address address, u32 word) -> void
+            {
+                if (!Put(address, word))
+                {
+                    throw TrappedException(TrapType::StoreAccessFault);
+                }
+            }
+
+            auto Write8Unprotected(Address address, u8 byte) -> void
+            {
+                if (!Put(address, byte, Kind::Rom))
+                {
+                    throw TrappedException(TrapType::StoreAccessFault);
+                }
+            }
+
+            auto Write16Unprotected(Address address, u16 halfWord) -> void
+            {
+                if (!Put(address, halfWord, Kind::Rom))
+                {
+                    throw TrappedException(TrapType::StoreAccessFault);
+                }
+            }
+
+            auto Write32Unprotected(Address address, u32 word) -> void
+            {
+                if (!Put(address, word, Kind::Rom))
+                {
+                    throw TrappedException(TrapType::StoreAccessFault);
+                }
+            }
+
+            // Copies `image` to `address`, even if it's in ROM. Throws a TrappedException if any of it isn't in RAM or
+            // ROM, in which case none of it is copied.
+            auto LoadImage(Address address, std::span<const u8> image) -> void
+            {
+                if (image.size() > (u64{1} << 32) - address)
+                {
+                    throw TrappedException(TrapType::StoreAccessFault);
+                }
+                for (u64 a = address & ~u64{pageMask}; a < address + image.size(); a += pageSize)
+                {
+                    const auto* p = Find(static_cast<Address>(a));
+                    if (p == nullptr || p->kind > Kind::Rom)
+                    {
+                        throw TrappedException(TrapType::StoreAccessFault);
+                    }
+                }
+                // Every page is now known to be in the table.
+                while (!image.empty())
+                {
+                    const auto offset = address & pageMask;
+                    const auto size = std::min<size_t>(pageSize - offset, image.size());
+                    std::memcpy(&bytes_[pages_[address >> pageShift].offset + offset], image.data(), size);
+                    address += static_cast<Address>(size);
+                    image = image.subspan(size);
+                }
+            }
+
+            // Non-throwing accessors. These return nothing, or false, if the access is bad.
+
+            auto TryRead8(Address address) -> std::optional<u8>
+                requires reports_faults
+            {
+                return Get<u8>(address);
+            }
+
+            auto TryRead16(Address address) -> std::optional<u16>
+                requires reports_faults
+            {
+                return Get<u16>(address);
+            }
+
+            auto TryRead32(Address address) -> std::optional<u32>
+                requires reports_faults
+            {
+                return Get<u32>(address);
+            }
+
+            auto TryWrite8(Address address, u8 byte) -> bool
+                requires reports_faults
+            {
+                return Put(address, byte);
+            }
+
+            auto TryWrite16(Address address, u16 halfWord) -> bool
+                requires reports_faults
+            {
+                return Put(address, halfWord);
+            }
+
+            auto TryWrite32(Address address, u32 word) -> bool
+                requires reports_faults
+            {
+                return Put(address, word);
+            }
+        };
+
+        // The basic platform's address space, i.e., ROM, then RAM, then the TTY, as a page-mapped memory that more
+        // devices can be added to. If `has_io` is false then the TTY's output goes nowhere.
+        template<bool has_io = false, bool reports_faults = false>
+        class BasicMemory : public Memory<reports_faults>
+        {
+        public:
+            BasicMemory()
+            {
+                this->MapRom(basic::ROM_START, basic::RAM_START - basic::ROM_START);
+                this->MapRam(basic::RAM_START, basic::MEM_SIZE - basic::RAM_START);
+                this->MapDevice(basic::TTY_STATUS, pageSize, std::make_shared<Console>(has_io ? &std::cout : nullptr));
+            }
+        };
+    } // namespace impl
+
+    using Memory = impl::Memory<false>;
+    using NonThrowingMemory = impl::Memory<true>;
+
+    using BasicMemory = impl::BasicMemory<true>;
+    using BasicMemoryNoIO = impl::BasicMemory<false>;
+    using NonThrowingBasicMemory = impl::BasicMemory<true, true>;
+    using NonThrowingBasicMemoryNoIO = impl::BasicMemory<false, true>;
+
+    static_assert(HasMemory<Memory>);
+    static_assert(HasUnprotectedWrites<Memory>);
+    static_assert(HasImageLoading<Memory>);
+    static_assert(HasNonThrowingMemory<NonThrowingMemory>);
+
+} // namespace arviss::platforms::mapped
@@ -0,0 +1,214 @@
+#pragma once
+
+#include "arviss/arviss.h"
+#include "arviss/rv32/disassemblers.h"
+#include "arviss/rv32/executors.h"
+
+#include <algorithm>
+#include <format>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace arviss::profile
+{
+    // How often the instruction at an address was executed, and if it's a conditional branch, how often it was taken.
+    struct Counts
+    {
+        u64 executed;
+        u64 taken;
+        u64 notTaken;
+    };
+
+    // A run of consecutive instructions that were all executed the same number of times. This is usually a basic block.
+    struct Block
+    {
+        Address start;
+        Address last; // The address of its last instruction.
+        u64 executed;
+        u64 instructions; // The number of instructions that it retired, i.e., its size times `executed`.
+    };
+
+    // Execution hooks that count how often each instruction in the first `memSize` bytes of guest memory is executed,
+    // and how often each conditional branch goes each way. Counts are kept in a flat array indexed by halfword so that
+    // they cost an increment apiece and work for compressed code. Use it as the executor's hooks, e.g.,
+    //
+    //  using Cpu = Rv32imfDispatcher<Rv32imfExecutor<FloatCore<Mem>, profile::Profiler<basic::MEM_SIZE>>>;
+    //
+    // then read it back through cpu.Instrumentation().
+    template<u64 memSize>
+    class Profiler : public NoHooks
+    {
+        std::vector<Counts> counts_ = std::vector<Counts>(memSize / 2);
+        u64 elsewhere_{}; // Instructions executed outside of the profiled memory.
+
+        // Walks the executed instructions in address order, calling `f(pc, counts)` for each.
+        template<typename F>
+        auto ForEach(F&& f) const -> void
+        {
+            for (size_t i = 0; i < counts_.size(); i++)
+            {
+                if (counts_[i].executed != 0)
+                {
+                    f(static_cast<Address>(i << 1), counts_[i]);
+                }
+            }
+        }
+
+        // Disassembles the instruction at `pc` using `fetch` to read it.
+        template<typename Disassembler, typename Fetch>
+        static auto Disassemble(Fetch& fetch, Address pc) -> std::string
+        {
+            u32 ins = fetch(pc);
+            if ((ins & 0b11) != 0b11)
+            {
+                ins &= 0xffff; // 16-bit compressed instruction.
+            }
+            Disassembler d;
+            return d.Dispatch(ins);
+        }
+
+    public:
+        auto OnInstruction(Address pc) -> void
+        {
+            if (pc < memSize)
+            {
+                ++counts_[pc >> 1].executed;
+            }
+            else
+            {
+                ++elsewhere_;
+            }
+        }
+
+        auto OnBranch(Address pc, Address /*target*/, bool taken) -> void
+        {
+            if (pc < memSize)
+            {
+                auto& c = counts_[pc >> 1];
+                ++(taken ? c.taken : c.notTaken);
+            }
+        }
+
+        auto Clear() -> void
+        {
+            std::fill(counts_.begin(), counts_.end(), Counts{});
+            elsewhere_ = 0;
+        }
+
+        // Returns the counts for the instruction at `pc`.
+        auto At(Address pc) const -> Counts { return pc < memSize ? counts_[pc >> 1] : Counts{}; }
+
+        // Returns the total number of instructions executed.
+        auto Executed() const -> u64
+        {
+            u64 total = elsewhere_;
+            ForEach([&](Address, const Counts& c) { total += c.executed; });
+            return total;
+        }
+
+        // Returns the addresses of the `limit` most executed instructions, most executed first.
+        auto HotSpots(size_t limit) const -> std::vector<Address>
+        {
+            std::vector<Address> pcs;
+            ForEach([&](Address pc, const Counts&) { pcs.push_back(pc); });
+            limit = std::min(limit, pcs.size());
+            std::partial_sort(pcs.begin(), pcs.begin() + static_cast<std::ptrdiff_t>(limit), pcs.end(),
+                              [this](Address a, Address b) { return At(a).executed > At(b).executed; });
+            pcs.resize(limit);
+            return pcs;
+        }
+
+        // Returns the addresses of the `limit` most executed conditional branches, most executed first.
+        auto HotBranches(size_t limit) const -> std::vector<Address>
+        {
+            std::vector<Address> pcs;
+            ForEach([&](Address pc, const Counts& c) {
+                if (c.taken + c.notTaken != 0)
+                {
+                    pcs.push_back(pc);
+                }
+            });
+            limit = std::min(limit, pcs.size());
+            std::partial_sort(pcs.begin(), pcs.begin() + static_cast<std::ptrdiff_t>(limit), pcs.end(),
+                              [this](Address a, Address b) { return At(a).executed > At(b).executed; });
+            pcs.resize(limit);
+            return pcs;
+        }
+
+        // Returns the `limit` blocks that retired the most instructions, hottest first. A block ends where the count
+        // changes or where there's a gap, so a block that's entered part way through shows up as two.
+        auto HotBlocks(size_t limit) const -> std::vector<Block>
+        {
+            std::vector<Block> blocks;
+            ForEach([&](Address pc, const Counts& c) {
+                // The next instruction is at most 4 bytes on, as 32-bit instructions leave their second halfword empty.
+                if (!blocks.empty() && blocks.back().executed == c.executed && pc - blocks.back().last <= 4)
+                {
+                    blocks.back().last = pc;
+                    blocks.back().instructions += c.executed;
+                    return;
+                }
+                blocks.push_back({.start = pc, .last = pc, .executed = c.executed, .instructions = c.executed});
+            });
+            limit = std::min(limit, blocks.size());
+            std::partial_sort(blocks.begin(), blocks.begin() + static_cast<std::ptrdiff_t>(limit), blocks.end(),
+                              [](const Block& a, const Block& b) { return a.instructions > b.instructions; });
+            blocks.resize(limit);
+            return blocks;
+        }
+
+        // Returns a report of the hottest blocks, branches and instructions, and of how often each instruction was
+        // executed, annotated by `Disassembler`. The instructions are read with `fetch(pc)`, so if the code has been
+        // transcoded in place, e.g., by a Remix dispatcher, then `fetch` should read them from the original image.
+        template<typename Disassembler = Rv32imfDisassembler, typename Fetch>
+        auto Report(Fetch fetch, size_t limit = 10) const -> std::string
+        {
+            const auto total = Executed();
+            const auto percent = [=](u64 n) { return total != 0 ? 100.0 * static_cast<double>(n) / static_cast<double>(total) : 0.0; };
+            std::string report = std::format("{} instructions executed, {} outside of profiled memory\n", total, elsewhere_);
+
+            report += "\nHot blocks:\n";
+            for (const auto& b : HotBlocks(limit))
+            {
+                report += std::format("{:6.2f}%  {:08x}-{:08x}  executed {} times\n", percent(b.instructions), b.start, b.last, b.executed);
+                for (Address pc = b.start; pc <= b.last; pc += 2)
+                {
+                    if (At(pc).executed != 0)
+                    {
+                        report += std::format("            {:08x}  {}\n", pc, Disassemble<Disassembler>(fetch, pc));
+                    }
+                }
+            }
+
+            report += "\nHot branches:\n";
+            for (const auto pc : HotBranches(limit))
+            {
+                const auto c = At(pc);
+                report += std::format("{:>12}  {:08x}  {:<28}  taken {:6.2f}%\n", c.executed, pc, Disassemble<Disassembler>(fetch, pc),
+                                      100.0 * static_cast<double>(c.taken) / static_cast<double>(c.taken + c.notTaken));
+            }
+
+            report += "\nHot instructions:\n";
+            for (const auto pc : HotSpots(limit))
+            {
+                report += std::format("{:>12}  {:6.2f}%  {:08x}  {}\n", At(pc).executed, percent(At(pc).executed), pc, Disassemble<Disassembler>(fetch, pc));
+            }
+
+            // The opcode is the mnemonic that starts the disassembly.
+            std::map<std::string, u64> byOpcode;
+            ForEach([&](Address pc, const Counts& c) {
+                const auto text = Disassemble<Disassembler>(fetch, pc);
+                byOpcode[text.substr(0, text.find_first_of("\t :"))] += c.executed;
+            });
+            std::vector<std::pair<std::string, u64>> opcodes(byOpcode.begin(), byOpcode.end());
+            std::stable_sort(opcodes.begin(), opcodes.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+            report += "\nOpcodes:\n";
+            for (const auto& [opcode, n] : opcodes)
+            {
+                report += std::format("{:>12}  {:6.2f}%  {}\n", n, percent(n), opcode);
+            }
+            return report;
+        }
+    };
+} // namespace arviss::profile
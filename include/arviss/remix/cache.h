@@ -0,0 +1,175 @@
+#pragma once
+
+#include "arviss/arviss.h"
+#include "arviss/file.h"
+#include "arviss/platforms/flat/flat.h"
+#include "arviss/rv32/concepts.h"
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace arviss::remix
+{
+    /*
+
+    A transcoded image can be saved to disk so that a later VM that runs the same image can skip transcoding entirely.
+    The cache file is a header page followed by the transcoded bytes, so that the bytes are page aligned in the file and
+    can be mapped straight into flat memory.
+
+    +--------------------+------------+---------------+------------+---------------+---------+
+    | magic "ArvRmx03"   | key        | address       | size       | encoding      | padding |
+    | 8                  | 8          | 4             | 4          | 8             | to 4KiB |
+    +--------------------+------------+---------------+------------+---------------+---------+
+
+    The key is a hash of the original image and its address, so a cache file that was made from a different image is
+    ignored. The encoding names the instruction set that the image was transcoded for, e.g., "rv32imf", as each has its
+    own converter, so a cache file that was made by a different kind of CPU is ignored too. The magic includes a version
+    number which must be changed if the Remix encoding changes.
+
+    */
+
+    namespace impl
+    {
+        constexpr std::array<char, 8> cacheMagic = {'A', 'r', 'v', 'R', 'm', 'x', '0', '3'};
+        constexpr size_t cacheHeaderSize = 4096;
+
+        struct CacheHeader
+        {
+            std::array<char, 8> magic;
+            u64 key;
+            Address address;
+            u32 size;
+            std::array<char, 8> encoding;
+        };
+
+        // Returns the name of the instruction set that `Cpu` transcodes, which determines the Remix words that it makes.
+        template<typename Cpu>
+        constexpr auto EncodingOf() -> std::array<char, 8>
+        {
+            if constexpr (IsRv32fHandler<Cpu>)
+            {
+                return {'r', 'v', '3', '2', 'i', 'm', 'f', '\0'};
+            }
+            else if constexpr (IsRv32mHandler<Cpu>)
+            {
+                return {'r', 'v', '3', '2', 'i', 'm', '\0', '\0'};
+            }
+            else
+            {
+                return {'r', 'v', '3', '2', 'i', '\0', '\0', '\0'};
+            }
+        }
+
+        // Returns a name for a temporary file next to `path` that no other thread or process is using.
+        inline auto TemporaryPath(const char* path) -> std::string
+        {
+            static std::atomic<u32> count = 0;
+            auto temporary = std::string(path) + ".tmp.";
+#if defined(__unix__) || defined(__APPLE__)
+            temporary += std::to_string(getpid());
+            temporary += '.';
+#endif
+            temporary += std::to_string(count++);
+            return temporary;
+        }
+    } // namespace impl
+
+    // Returns a key for the original, untranscoded, `image` when loaded at `address`. This is 64-bit FNV-1a.
+    inline auto CacheKey(Address address, std::span<const u8> image) -> u64
+    {
+        u64 hash = 0xcbf29ce484222325;
+        const auto mix = [&](u8 byte) {
+            hash ^= byte;
+            hash *= 0x100000001b3;
+        };
+        for (auto i = 0; i < 4; i++)
+        {
+            mix(static_cast<u8>(address >> (8 * i)));
+        }
+        for (auto byte : image)
+        {
+            mix(byte);
+        }
+        return hash;
+    }
+
+    // Saves `size` bytes of `cpu`'s memory at `address`, e.g., after Pretranscode(), to `path` under `key`. Only a
+    // dispatcher that transcodes in place has Remix words in memory to save. The file is written under a temporary name
+    // and renamed into place, so anything that loads it at the same time sees either the old file or the new one, never
+    // part of it. Returns false if the file couldn't be written.
+    template<typename Cpu>
+        requires HasMemory<Cpu>
+    auto SaveTranscoded(Cpu& cpu, const char* path, u64 key, Address address, u32 size) -> bool
+    {
+        std::vector<u8> contents(impl::cacheHeaderSize + size);
+        const impl::CacheHeader header{.magic = impl::cacheMagic, .key = key, .address = address, .size = size, .encoding = impl::EncodingOf<Cpu>()};
+        std::memcpy(contents.data(), &header, sizeof(header));
+        for (u32 i = 0; i < size; i++)
+        {
+            contents[impl::cacheHeaderSize + i] = cpu.Read8(address + i);
+        }
+        const auto temporary = impl::TemporaryPath(path);
+        std::ofstream file(temporary, std::ios::out | std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(contents.data()), static_cast<std::streamsize>(contents.size()));
+        file.close();
+        if (!file || std::rename(temporary.c_str(), path) != 0)
+        {
+            std::remove(temporary.c_str());
+            return false;
+        }
+        return true;
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+
+    // Loads the transcoded image saved at `path` into `cpu`'s memory if it was saved under `key` by a CPU with the same
+    // instruction set and none of it is missing. Flat memory maps it without copying, and other memory copies it from a
+    // mapping of the file. Returns false if there's no usable cache file, in which case the image must be loaded and
+    // transcoded in the usual way.
+    template<typename Cpu>
+        requires HasImageLoading<Cpu>
+    auto LoadTranscoded(Cpu& cpu, const char* path, u64 key) -> bool
+    {
+        const FileDescriptor fd(open(path, O_RDONLY)); // Closing it doesn't affect flat memory's mapping of the file.
+        const FileMapping mapping(fd.Get(), impl::cacheHeaderSize);
+        const auto contents = mapping.Bytes();
+        if (contents.empty())
+        {
+            return false;
+        }
+
+        impl::CacheHeader header;
+        std::memcpy(&header, contents.data(), sizeof(header));
+        if (header.magic != impl::cacheMagic || header.key != key || header.size != contents.size() - impl::cacheHeaderSize
+            || header.encoding != impl::EncodingOf<Cpu>())
+        {
+            return false;
+        }
+        bool mapped = false;
+#if ARVISS_HAS_FLAT_MEMORY
+        if constexpr (std::derived_from<Cpu, platforms::flat::Memory>)
+        {
+            mapped = cpu.MapImage(header.address, fd.Get(), impl::cacheHeaderSize, header.size);
+        }
+#endif
+        if (!mapped)
+        {
+            cpu.LoadImage(header.address, contents.subspan(impl::cacheHeaderSize, header.size));
+        }
+        return true;
+    }
+
+#endif
+
+} // namespace arviss::remix
@@ -37,6 +37,20 @@ namespace arviss::remix
     As all opcodes ending in 0b11 are placeholders for RV32 instructions, this means that there can only be 96 Remix
     opcodes rather than 128, but as the instruction set is small this is not really a problem.
 
+    Compressed (RV32c) instructions are re-encoded as the RV32i instructions that they expand to, except for jumps via a
+    register and jumps that link to the next 16-bit instruction, which have opcodes of their own. A 16-bit
+    instruction has no room for a 32-bit Remix word, and its bottom two bits aren't 0b11, so Remix words for cores that
+    support compressed instructions are kept in a side table rather than in memory. See `RemixDispatcher`.
+
+    The opcodes for fused pairs of instructions, e.g., Lui_addi, are never produced by the Remix converters, as their
+    operands don't fit in a Remix word. They're used by the block cache's pre-decoder. See `blocks::Fuse()`.
+
+    Instructions whose destination is x0 are dealt with when they're transcoded. Those that have no effect other than
+    writing to x0, e.g., the canonical `addi x0, x0, 0`, become a Nop. Jumps and loads still have to run, so they
+    become a J, a Jr, or a Load_x0, whose handlers write the result to the core's SINK register if it has one. For a
+    Load_x0, the rd field holds the opcode of the load. This means that a Remix dispatcher never writes to x0, so a
+    core can skip putting x0 back to zero after every write. See `ZeroSink`.
+
     */
 
     enum Opcode : u32
@@ -140,6 +154,21 @@ namespace arviss::remix
         Fmsub_s,
         Fnmsub_s,
         Fnmadd_s,
+        Rv63 = 0b110'0011,
+        C_jal,
+        C_jalr,
+        C_jr,
+        Rv67 = 0b110'0111,
+        Lui_addi,
+        Auipc_jalr,
+        Auipc_lw,
+        Rv6b = 0b110'1011,
+        Addi_bne,
+        Nop,
+        J,
+        Rv6f = 0b110'1111,
+        Jr,
+        Load_x0,
     };
 
     struct F0
@@ -424,6 +453,22 @@ namespace arviss::remix
     public:
         using Item = Remix;
 
+    protected:
+        // A load. If its destination is x0 then it's a Load_x0 with the load's opcode in place of rd.
+        static auto Load(Opcode opc, Reg rd, Reg rs1, u32 iimm) -> Item
+        {
+            if (rd == RegNames::ZERO)
+            {
+                return {.itype = F2i(Opcode::Load_x0, opc, rs1, iimm)};
+            }
+            return {.itype = F2i(opc, rd, rs1, iimm)};
+        }
+
+    public:
+        // An instruction that does nothing, for those whose only effect is to write to x0.
+
+        auto Nop() -> Item { return {.f0 = F0(Opcode::Nop)}; }
+
         // Illegal instruction.
 
         auto Illegal(u32 /*ins*/) -> Item { return {.f0 = F0(Opcode::Illegal)}; }
@@ -439,18 +484,18 @@ namespace arviss::remix
 
         // I-type instructions.
 
-        auto Lb(Reg rd, Reg rs1, u32 iimm) -> Item { return {.itype = F2i(Opcode::Lb, rd, rs1, iimm)}; }
-        auto Lh(Reg rd, Reg rs1, u32 iimm) -> Item { return {.itype = F2i(Opcode::Lh, rd, rs1, iimm)}; }
-        auto Lw(Reg rd, Reg rs1, u32 iimm) -> Item { return {.itype = F2i(Opcode::Lw, rd, rs1, iimm)}; }
-        auto Lbu(Reg rd, Reg rs1, u32 iimm) -> Item { return {.itype = F2i(Opcode::Lbu, rd, rs1, iimm)}; }
-        auto Lhu(Reg rd, Reg rs1, u32 iimm) -> Item { return {.itype = F2i(Opcode::Lhu, rd, rs1, iimm)}; }
-        auto Addi(Reg rd, Reg rs1, u32 iimm) -> Item { return {.itype = F2i(Opcode::Addi, rd, rs1, iimm)}; }
-        auto Slti(Reg rd, Reg rs1, u32 iimm) -> Item { return {.itype = F2i(Opcode::Slti, rd, rs1, iimm)}; }
-        auto Sltiu(Reg rd, Reg rs1, u32 iimm) -> Item { return {.itype = F2i(Opcode::Sltiu, rd, rs1, iimm)}; }
-        auto Xori(Reg rd, Reg rs1, u32 iimm) -> Item { return {.itype = F2i(Opcode::Xori, rd, rs1, iimm)}; }
-        auto Ori(Reg rd, Reg rs1, u32 iimm) -> Item { return {.itype = F2i(Opcode::Ori, rd, rs1, iimm)}; }
-        auto Andi(Reg rd, Reg rs1, u32 iimm) -> Item { return {.itype = F2i(Opcode::Andi, rd, rs1, iimm)}; }
-        auto Jalr(Reg rd, Reg rs1, u32 iimm) -> Item { return {.itype = F2i(Opcode::Jalr, rd, rs1, iimm)}; }
+        auto Lb(Reg rd, Reg rs1, u32 iimm) -> Item { return Load(Opcode::Lb, rd, rs1, iimm); }
+        auto Lh(Reg rd, Reg rs1, u32 iimm) -> Item { return Load(Opcode::Lh, rd, rs1, iimm); }
+        auto Lw(Reg rd, Reg rs1, u32 iimm) -> Item { return Load(Opcode::Lw, rd, rs1, iimm); }
+        auto Lbu(Reg rd, Reg rs1, u32 iimm) -> Item { return Load(Opcode::Lbu, rd, rs1, iimm); }
+        auto Lhu(Reg rd, Reg rs1, u32 iimm) -> Item { return Load(Opcode::Lhu, rd, rs1, iimm); }
+        auto Addi(Reg rd, Reg rs1, u32 iimm) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.itype = F2i(Opcode::Addi, rd, rs1, iimm)}; }
+        auto Slti(Reg rd, Reg rs1, u32 iimm) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.itype = F2i(Opcode::Slti, rd, rs1, iimm)}; }
+        auto Sltiu(Reg rd, Reg rs1, u32 iimm) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.itype = F2i(Opcode::Sltiu, rd, rs1, iimm)}; }
+        auto Xori(Reg rd, Reg rs1, u32 iimm) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.itype = F2i(Opcode::Xori, rd, rs1, iimm)}; }
+        auto Ori(Reg rd, Reg rs1, u32 iimm) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.itype = F2i(Opcode::Ori, rd, rs1, iimm)}; }
+        auto Andi(Reg rd, Reg rs1, u32 iimm) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.itype = F2i(Opcode::Andi, rd, rs1, iimm)}; }
+        auto Jalr(Reg rd, Reg rs1, u32 iimm) -> Item { return {.itype = F2i(rd == RegNames::ZERO ? Opcode::Jr : Opcode::Jalr, rd, rs1, iimm)}; }
 
         // S-type instructions.
 
@@ -460,31 +505,31 @@ namespace arviss::remix
 
         // U-type instructions.
 
-        auto Auipc(Reg rd, u32 uimm) -> Item { return {.utype = F4u(Opcode::Auipc, rd, uimm)}; }
-        auto Lui(Reg rd, u32 uimm) -> Item { return {.utype = F4u(Opcode::Lui, rd, uimm)}; }
+        auto Auipc(Reg rd, u32 uimm) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.utype = F4u(Opcode::Auipc, rd, uimm)}; }
+        auto Lui(Reg rd, u32 uimm) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.utype = F4u(Opcode::Lui, rd, uimm)}; }
 
         // J-type instructions.
 
-        auto Jal(Reg rd, u32 jimm) -> Item { return {.jtype = F4j(Opcode::Jal, rd, jimm)}; }
+        auto Jal(Reg rd, u32 jimm) -> Item { return {.jtype = F4j(rd == RegNames::ZERO ? Opcode::J : Opcode::Jal, rd, jimm)}; }
 
         // Arithmetic instructions.
 
-        auto Add(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::Add, rd, rs1, rs2)}; }
-        auto Sub(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::Sub, rd, rs1, rs2)}; }
-        auto Sll(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::Sll, rd, rs1, rs2)}; }
-        auto Slt(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::Slt, rd, rs1, rs2)}; }
-        auto Sltu(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::Sltu, rd, rs1, rs2)}; }
-        auto Xor(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::Xor, rd, rs1, rs2)}; }
-        auto Srl(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::Srl, rd, rs1, rs2)}; }
-        auto Sra(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::Sra, rd, rs1, rs2)}; }
-        auto Or(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::Or, rd, rs1, rs2)}; }
-        auto And(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::And, rd, rs1, rs2)}; }
+        auto Add(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::Add, rd, rs1, rs2)}; }
+        auto Sub(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::Sub, rd, rs1, rs2)}; }
+        auto Sll(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::Sll, rd, rs1, rs2)}; }
+        auto Slt(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::Slt, rd, rs1, rs2)}; }
+        auto Sltu(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::Sltu, rd, rs1, rs2)}; }
+        auto Xor(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::Xor, rd, rs1, rs2)}; }
+        auto Srl(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::Srl, rd, rs1, rs2)}; }
+        auto Sra(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::Sra, rd, rs1, rs2)}; }
+        auto Or(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::Or, rd, rs1, rs2)}; }
+        auto And(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::And, rd, rs1, rs2)}; }
 
         // Immediate shift instructions.
 
-        auto Slli(Reg rd, Reg rs1, u32 shamt) -> Item { return {.immShiftType = F1s(Opcode::Slli, rd, rs1, shamt)}; }
-        auto Srli(Reg rd, Reg rs1, u32 shamt) -> Item { return {.immShiftType = F1s(Opcode::Srli, rd, rs1, shamt)}; }
-        auto Srai(Reg rd, Reg rs1, u32 shamt) -> Item { return {.immShiftType = F1s(Opcode::Srai, rd, rs1, shamt)}; }
+        auto Slli(Reg rd, Reg rs1, u32 shamt) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.immShiftType = F1s(Opcode::Slli, rd, rs1, shamt)}; }
+        auto Srli(Reg rd, Reg rs1, u32 shamt) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.immShiftType = F1s(Opcode::Srli, rd, rs1, shamt)}; }
+        auto Srai(Reg rd, Reg rs1, u32 shamt) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.immShiftType = F1s(Opcode::Srai, rd, rs1, shamt)}; }
 
         // Fence instructions.
 
@@ -504,14 +549,14 @@ namespace arviss::remix
     public:
         using Item = Rv32iToRemixConverter::Item;
 
-        auto Mul(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::Mul, rd, rs1, rs2)}; }
-        auto Mulh(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::Mulh, rd, rs1, rs2)}; }
-        auto Mulhsu(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::Mulhsu, rd, rs1, rs2)}; }
-        auto Mulhu(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::Mulhu, rd, rs1, rs2)}; }
-        auto Div(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::Div, rd, rs1, rs2)}; }
-        auto Divu(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::Divu, rd, rs1, rs2)}; }
-        auto Rem(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::Rem, rd, rs1, rs2)}; }
-        auto Remu(Reg rd, Reg rs1, Reg rs2) -> Item { return {.arithType = F1a(Opcode::Remu, rd, rs1, rs2)}; }
+        auto Mul(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::Mul, rd, rs1, rs2)}; }
+        auto Mulh(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::Mulh, rd, rs1, rs2)}; }
+        auto Mulhsu(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::Mulhsu, rd, rs1, rs2)}; }
+        auto Mulhu(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::Mulhu, rd, rs1, rs2)}; }
+        auto Div(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::Div, rd, rs1, rs2)}; }
+        auto Divu(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::Divu, rd, rs1, rs2)}; }
+        auto Rem(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::Rem, rd, rs1, rs2)}; }
+        auto Remu(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.arithType = F1a(Opcode::Remu, rd, rs1, rs2)}; }
     };
 
     static_assert(IsRv32imHandler<Rv32imToRemixConverter>);
@@ -522,13 +567,13 @@ namespace arviss::remix
     public:
         using Item = Rv32imToRemixConverter::Item;
 
-        auto Fmv_x_w(Reg rd, Reg rs1) -> Item { return {.f5Type = F5(Opcode::Fmv_x_w, rd, rs1)}; }
-        auto Fclass_s(Reg rd, Reg rs1) -> Item { return {.f5Type = F5(Opcode::Fclass_s, rd, rs1)}; }
+        auto Fmv_x_w(Reg rd, Reg rs1) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.f5Type = F5(Opcode::Fmv_x_w, rd, rs1)}; }
+        auto Fclass_s(Reg rd, Reg rs1) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.f5Type = F5(Opcode::Fclass_s, rd, rs1)}; }
         auto Fmv_w_x(Reg rd, Reg rs1) -> Item { return {.f5Type = F5(Opcode::Fmv_w_x, rd, rs1)}; }
 
         auto Fsqrt_s(Reg rd, Reg rs1, u32 rm) -> Item { return {.f5rmType = F5rm(Opcode::Fsqrt_s, rd, rs1, rm)}; }
-        auto Fcvt_w_s(Reg rd, Reg rs1, u32 rm) -> Item { return {.f5rmType = F5rm(Opcode::Fcvt_w_s, rd, rs1, rm)}; }
-        auto Fcvt_wu_s(Reg rd, Reg rs1, u32 rm) -> Item { return {.f5rmType = F5rm(Opcode::Fcvt_wu_s, rd, rs1, rm)}; }
+        auto Fcvt_w_s(Reg rd, Reg rs1, u32 rm) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.f5rmType = F5rm(Opcode::Fcvt_w_s, rd, rs1, rm)}; }
+        auto Fcvt_wu_s(Reg rd, Reg rs1, u32 rm) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.f5rmType = F5rm(Opcode::Fcvt_wu_s, rd, rs1, rm)}; }
         auto Fcvt_s_w(Reg rd, Reg rs1, u32 rm) -> Item { return {.f5rmType = F5rm(Opcode::Fcvt_s_w, rd, rs1, rm)}; }
         auto Fcvt_s_wu(Reg rd, Reg rs1, u32 rm) -> Item { return {.f5rmType = F5rm(Opcode::Fcvt_s_wu, rd, rs1, rm)}; }
 
@@ -537,9 +582,9 @@ namespace arviss::remix
         auto Fsgnjx_s(Reg rd, Reg rs1, Reg rs2) -> Item { return {.f6Type = F6(Opcode::Fsgnjx_s, rd, rs1, rs2)}; }
         auto Fmin_s(Reg rd, Reg rs1, Reg rs2) -> Item { return {.f6Type = F6(Opcode::Fmin_s, rd, rs1, rs2)}; }
         auto Fmax_s(Reg rd, Reg rs1, Reg rs2) -> Item { return {.f6Type = F6(Opcode::Fmax_s, rd, rs1, rs2)}; }
-        auto Fle_s(Reg rd, Reg rs1, Reg rs2) -> Item { return {.f6Type = F6(Opcode::Fle_s, rd, rs1, rs2)}; }
-        auto Flt_s(Reg rd, Reg rs1, Reg rs2) -> Item { return {.f6Type = F6(Opcode::Flt_s, rd, rs1, rs2)}; }
-        auto Feq_s(Reg rd, Reg rs1, Reg rs2) -> Item { return {.f6Type = F6(Opcode::Feq_s, rd, rs1, rs2)}; }
+        auto Fle_s(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.f6Type = F6(Opcode::Fle_s, rd, rs1, rs2)}; }
+        auto Flt_s(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.f6Type = F6(Opcode::Flt_s, rd, rs1, rs2)}; }
+        auto Feq_s(Reg rd, Reg rs1, Reg rs2) -> Item { return rd == RegNames::ZERO ? Nop() : Item{.f6Type = F6(Opcode::Feq_s, rd, rs1, rs2)}; }
 
         auto Fadd_s(Reg rd, Reg rs1, Reg rs2, u32 rm) -> Item { return {.f6rmType = F6rm(Opcode::Fadd_s, rd, rs1, rs2, rm)}; }
         auto Fsub_s(Reg rd, Reg rs1, Reg rs2, u32 rm) -> Item { return {.f6rmType = F6rm(Opcode::Fsub_s, rd, rs1, rs2, rm)}; }
@@ -558,4 +603,41 @@ namespace arviss::remix
 
     static_assert(IsRv32imfHandler<Rv32imfToRemixConverter>);
 
+    // An Rv32ic instruction handler that re-encodes instructions for Remix.
+    class Rv32icToRemixConverter : public Rv32iToRemixConverter
+    {
+    public:
+        using Item = Rv32iToRemixConverter::Item;
+
+        auto C_ebreak() -> Item { return Ebreak(); }
+        auto C_jr(Reg rs1n0) -> Item { return {.f5Type = F5(Opcode::C_jr, RegNames::ZERO, rs1n0)}; }
+        auto C_jalr(Reg rs1n0) -> Item { return {.f5Type = F5(Opcode::C_jalr, RegNames::RA, rs1n0)}; }
+        auto C_nop(u32 /*u*/) -> Item { return Addi(RegNames::ZERO, RegNames::ZERO, 0); }
+        auto C_addi16sp(u32 imm) -> Item { return Addi(RegNames::SP, RegNames::SP, imm); }
+        auto C_sub(Reg rdrs1p, Reg rs2p) -> Item { return Sub(rdrs1p, rdrs1p, rs2p); }
+        auto C_xor(Reg rdrs1p, Reg rs2p) -> Item { return Xor(rdrs1p, rdrs1p, rs2p); }
+        auto C_or(Reg rdrs1p, Reg rs2p) -> Item { return Or(rdrs1p, rdrs1p, rs2p); }
+        auto C_and(Reg rdrs1p, Reg rs2p) -> Item { return And(rdrs1p, rdrs1p, rs2p); }
+        auto C_andi(Reg rsrs1p, u32 imm) -> Item { return Andi(rsrs1p, rsrs1p, imm); }
+        auto C_srli(Reg rdrs1p, u32 imm) -> Item { return Srli(rdrs1p, rdrs1p, imm); }
+        auto C_srai(Reg rdrs1p, u32 imm) -> Item { return Srai(rdrs1p, rdrs1p, imm); }
+        auto C_mv(Reg rd, Reg rs2n0) -> Item { return Add(rd, RegNames::ZERO, rs2n0); }
+        auto C_add(Reg rdrs1, Reg rs2n0) -> Item { return Add(rdrs1, rdrs1, rs2n0); }
+        auto C_addi4spn(Reg rdp, u32 imm) -> Item { return Addi(rdp, RegNames::SP, imm); }
+        auto C_lw(Reg rdp, Reg rs1p, u32 imm) -> Item { return Lw(rdp, rs1p, imm); }
+        auto C_sw(Reg rs1p, Reg rs2p, u32 imm) -> Item { return Sw(rs1p, rs2p, imm); }
+        auto C_addi(Reg rdrs1n0, u32 imm) -> Item { return Addi(rdrs1n0, rdrs1n0, imm); }
+        auto C_li(Reg rd, u32 imm) -> Item { return Addi(rd, RegNames::ZERO, imm); }
+        auto C_lui(Reg rdn2, u32 imm) -> Item { return Lui(rdn2, imm); }
+        auto C_j(u32 imm) -> Item { return Jal(RegNames::ZERO, imm); }
+        auto C_beqz(Reg rs1p, u32 imm) -> Item { return Beq(rs1p, RegNames::ZERO, imm); }
+        auto C_bnez(Reg rs1p, u32 imm) -> Item { return Bne(rs1p, RegNames::ZERO, imm); }
+        auto C_lwsp(Reg rdn0, u32 imm) -> Item { return Lw(rdn0, RegNames::SP, imm); }
+        auto C_swsp(Reg rs2, u32 imm) -> Item { return Sw(RegNames::SP, rs2, imm); }
+        auto C_jal(u32 imm) -> Item { return {.jtype = F4j(Opcode::C_jal, RegNames::RA, imm)}; }
+        auto C_slli(Reg rdrs1n0, u32 imm) -> Item { return Slli(rdrs1n0, rdrs1n0, imm); }
+    };
+
+    static_assert(IsRv32icHandler<Rv32icToRemixConverter>);
+
 } // namespace arviss::remix
@@ -2,10 +2,13 @@
 
 #include "arviss/arviss.h"
 #include "arviss/remix/encoder.h"
+#include "arviss/remix/side_table.h"
 #include "arviss/rv32/concepts.h"
 #include "arviss/rv32/dispatchers.h"
 #include "arviss/rv32/executors.h"
 
+#include <type_traits>
+
 namespace arviss::remix
 {
     template<typename T>
@@ -17,8 +20,16 @@ namespace arviss::remix
             requires IsRv32iHandler<T>  // T is a handler for Rv32i.
                 && (!IsRv32mHandler<T>) // T is NOT a handler for Rv32m.
                 && (!IsRv32fHandler<T>) // T is NOT a handler for Rv32f.
+                && (!IsRv32cHandler<T>) // T is NOT a handler for Rv32c.
         auto ConverterFor() -> Rv32iDispatcher<Rv32iToRemixConverter>;
 
+        template<typename T>
+            requires IsRv32iHandler<T>  // T is a handler for Rv32i.
+                && IsRv32cHandler<T>    // T is a handler for Rv32c.
+                && (!IsRv32mHandler<T>) // T is NOT a handler for Rv32m.
+                && (!IsRv32fHandler<T>) // T is NOT a handler for Rv32f.
+        auto ConverterFor() -> Rv32icDispatcher<Rv32icToRemixConverter>;
+
         template<typename T>
             requires IsRv32iHandler<T>  // T is a handler for Rv32i.
                 && IsRv32mHandler<T>    // T is a handler for Rv32m.
@@ -33,7 +44,18 @@ namespace arviss::remix
 
     } // namespace
 
-    template<IsRemixDispatchable T>
+    // A dispatcher that transcodes RISC-V instructions to Remix the first time that they're executed.
+    //
+    // On a core without compressed instructions, each Remix word replaces the RISC-V instruction that it came from in
+    // memory. On a core with compressed instructions that doesn't work, because a 16-bit instruction has no room for a
+    // Remix word, and because a Remix word in memory would look like a 16-bit instruction to the fetch cycle. Instead,
+    // Remix words are kept in a side table alongside the size of the instruction that they came from, and Fetch() returns
+    // Remix words rather than RISC-V instructions. In place, code is assumed not to change once it has been transcoded.
+    //
+    // If `shadowed` is true then a core without compressed instructions uses the side table too, so memory is never
+    // changed and the guest reads back its own instructions. Guest stores to a page with transcoded code on it throw
+    // away that page's Remix words, so self-modifying code and code that's loaded at run time are transcoded afresh.
+    template<IsRemixDispatchable T, bool shadowed = false>
     class RemixDispatcher : public T
     {
         auto Self() -> T& { return static_cast<T&>(*this); }
@@ -42,11 +64,180 @@ namespace arviss::remix
         // its dispatcher has to do work unnecessarily.
         using ConverterType = decltype(ConverterFor<T>());
 
+        static constexpr bool isCompact = IsRv32cHandler<T>;
+        static constexpr bool isShadowed = shadowed || isCompact; // True if Remix words are kept in the side table.
+
+        // A Remix word in the side table, and the size in bytes of the instruction that it came from. A size of zero
+        // means that there's no Remix word for that address.
+        struct Remixed
+        {
+            u32 code;
+            u32 size;
+        };
+
+        // The side table has a slot for every halfword. Only a dispatcher that keeps Remix words in the side table has
+        // one, so that one that transcodes in place doesn't carry it around.
+        struct NoSideTable
+        {
+        };
+
         ConverterType converter_{};
+        [[no_unique_address]] std::conditional_t<isShadowed, SideTable<Remixed, 1>, NoSideTable> remixed_{};
+
+        auto Find(Address pc) const -> const Remixed*
+        {
+            const auto* r = remixed_.Find(pc);
+            return r != nullptr && r->size != 0 ? r : nullptr;
+        }
+
+    protected:
+        // Called before a guest store of `size` bytes to `address`. If the store hits transcoded code then the Remix
+        // words for the pages that it touches are thrown away, to be transcoded again when they're next fetched.
+        auto CheckStore(Address address, u32 size) -> void
+        {
+            if constexpr (shadowed)
+            {
+                for (const Address a : {address, address + size - 1})
+                {
+                    remixed_.ClearPage(a);
+                }
+            }
+        }
+
+        // Where jumps and loads whose destination is x0 write their results. That's SINK if the core has one, otherwise
+        // it's x0 itself, which the core's Wx() keeps at zero.
+        static constexpr Reg sink = [] {
+            if constexpr (HasSinkRegister<T>)
+            {
+                return T::SINK;
+            }
+            else
+            {
+                return Reg{RegNames::ZERO};
+            }
+        }();
+
+        // Executes a Load_x0, i.e., a load whose destination is x0, for the sake of its side effects.
+        auto LoadToSink(u32 code) -> typename T::Item
+        {
+            auto& self = Self();
+            const Remix e = *reinterpret_cast<Remix*>(&code);
+            switch (e.itype.rd()) // The load's own opcode.
+            {
+            case Opcode::Lb:
+                return self.Lb(sink, e.itype.rs1(), e.itype.iimm());
+            case Opcode::Lh:
+                return self.Lh(sink, e.itype.rs1(), e.itype.iimm());
+            case Opcode::Lw:
+                return self.Lw(sink, e.itype.rs1(), e.itype.iimm());
+            case Opcode::Lbu:
+                return self.Lbu(sink, e.itype.rs1(), e.itype.iimm());
+            case Opcode::Lhu:
+                return self.Lhu(sink, e.itype.rs1(), e.itype.iimm());
+            default:
+                return self.Illegal(code);
+            }
+        }
+
+        // Returns the RISC-V instruction that an Illegal Remix word stands for. On a compact core, Fetch() carries an
+        // illegal 16-bit instruction in the otherwise unused bits of the Remix word.
+        static auto IllegalCode(u32 code) -> u32
+        {
+            if constexpr (isCompact)
+            {
+                return code >> 7;
+            }
+            else
+            {
+                return code;
+            }
+        }
 
     public:
         using Item = typename T::Item;
 
+        // Fetches the next instruction. If Remix words are kept in the side table, this transcodes it too, so that the
+        // result is always a Remix word unless it's an illegal 32-bit instruction.
+        auto Fetch() -> u32
+        {
+            auto& self = Self();
+            if constexpr (!isShadowed)
+            {
+                return self.Fetch();
+            }
+            else
+            {
+                const auto pc = self.Transfer();
+                if (const auto* r = Find(pc))
+                {
+                    self.SetNextPc(pc + r->size);
+                    return r->code;
+                }
+
+                auto ins = self.Fetch32(pc);
+                u32 size = 4;
+                if (isCompact && (ins & 0b11) != 0b11)
+                {
+                    // 16-bit compressed instruction.
+                    ins = ins & 0xffff;
+                    size = 2;
+                }
+                self.SetNextPc(pc + size);
+
+                const auto remixed = converter_.Dispatch(ins);
+                if (remixed.f0.opc() == Opcode::Illegal)
+                {
+                    // A 32-bit instruction is passed on as-is for Dispatch() to reject. A 16-bit one can't be, because
+                    // it might look like a Remix word.
+                    return size == 4 ? ins : (ins << 7) | Opcode::Illegal;
+                }
+                const u32 recode = *reinterpret_cast<const u32*>(&remixed);
+                remixed_.Set(pc, {.code = recode, .size = size});
+                return recode;
+            }
+        }
+
+        // Transcodes every instruction in [start, end) ahead of time, so that the first run doesn't pay for it. The range
+        // must only hold code, as any data in it that looks like an instruction would be transcoded too. Words that have
+        // already been transcoded, or that aren't legal instructions, are left alone.
+        auto Pretranscode(Address start, Address end) -> void
+            requires(!isCompact)
+        {
+            auto& self = Self();
+            for (auto pc = start; pc < end && end - pc >= 4; pc += 4)
+            {
+                const auto code = self.Fetch32(pc);
+                if ((code & 0b11) != 0b11)
+                {
+                    continue;
+                }
+                const auto remixed = converter_.Dispatch(code);
+                if (remixed.f0.opc() == Opcode::Illegal)
+                {
+                    continue;
+                }
+                const u32 recode = *reinterpret_cast<const u32*>(&remixed);
+                if constexpr (isShadowed)
+                {
+                    remixed_.Set(pc, {.code = recode, .size = 4});
+                }
+                else
+                {
+                    self.Write32Unprotected(pc, recode);
+                }
+            }
+        }
+
+        // Throws away all Remix words in the side table, e.g., after the host has written new code with unprotected
+        // writes. It doesn't undo transcoding that was done in place.
+        auto Invalidate() -> void
+        {
+            if constexpr (isShadowed)
+            {
+                remixed_.Clear();
+            }
+        }
+
         auto Transcode(u32 code) -> Item
         {
             auto& self = Self();
@@ -56,7 +247,14 @@ namespace arviss::remix
                 return self.Illegal(code);
             }
             const u32 recode = *reinterpret_cast<const u32*>(&remixed);
-            self.Write32Unprotected(self.Pc(), recode);
+            if constexpr (isShadowed)
+            {
+                remixed_.Set(self.Pc(), {.code = recode, .size = (code & 0b11) == 0b11 ? 4u : 2u});
+            }
+            else
+            {
+                self.Write32Unprotected(self.Pc(), recode);
+            }
             return Dispatch(recode);
         }
 
@@ -69,7 +267,7 @@ namespace arviss::remix
             {
             // Illegal instruction.
             case Opcode::Illegal:
-                return self.Illegal(code);
+                return self.Illegal(IllegalCode(code));
 
             // --- RV32i.
 
@@ -115,10 +313,13 @@ namespace arviss::remix
 
             // S-type instructions.
             case Opcode::Sb:
+                CheckStore(self.Rx(e.stype.rs1()) + e.stype.simm(), 1);
                 return self.Sb(e.stype.rs1(), e.stype.rs2(), e.stype.simm());
             case Opcode::Sh:
+                CheckStore(self.Rx(e.stype.rs1()) + e.stype.simm(), 2);
                 return self.Sh(e.stype.rs1(), e.stype.rs2(), e.stype.simm());
             case Opcode::Sw:
+                CheckStore(self.Rx(e.stype.rs1()) + e.stype.simm(), 4);
                 return self.Sw(e.stype.rs1(), e.stype.rs2(), e.stype.simm());
 
             // U-type instructions.
@@ -169,6 +370,16 @@ namespace arviss::remix
             case Opcode::Ebreak:
                 return self.Ebreak();
 
+            // Instructions whose destination was x0.
+            case Opcode::Nop:
+                return;
+            case Opcode::J:
+                return self.Jal(sink, e.jtype.jimm());
+            case Opcode::Jr:
+                return self.Jalr(sink, e.itype.rs1(), e.itype.iimm());
+            case Opcode::Load_x0:
+                return LoadToSink(code);
+
             // --- RV32m.
 
             // Integer multiply and divide instructions.
@@ -352,6 +563,7 @@ namespace arviss::remix
             case Opcode::Fsw:
                 if constexpr (IsRv32fHandler<T>)
                 {
+                    CheckStore(self.Rx(e.stype.rs1()) + e.stype.simm(), 4);
                     return self.Fsw(e.stype.rs1(), e.stype.rs2(), e.stype.simm());
                 }
                 [[fallthrough]];
@@ -379,6 +591,27 @@ namespace arviss::remix
                     return self.Fnmadd_s(e.f7Type.rd(), e.f7Type.rs1(), e.f7Type.rs2(), e.f7Type.rs3(), e.f7Type.rm());
                 }
                 [[fallthrough]];
+            // --- RV32c.
+
+            // Compressed instructions that don't behave exactly like an RV32i instruction. The rest are remixed as RV32i.
+            case Opcode::C_jal:
+                if constexpr (IsRv32cHandler<T>)
+                {
+                    return self.C_jal(e.jtype.jimm());
+                }
+                [[fallthrough]];
+            case Opcode::C_jalr:
+                if constexpr (IsRv32cHandler<T>)
+                {
+                    return self.C_jalr(e.f5Type.rs1());
+                }
+                [[fallthrough]];
+            case Opcode::C_jr:
+                if constexpr (IsRv32cHandler<T>)
+                {
+                    return self.C_jr(e.f5Type.rs1());
+                }
+                [[fallthrough]];
 
             // If we don't know it then we assume it's RISC-V encoded and try to transcode it.
             default:
@@ -1,5 +1,8 @@
 #pragma once
 
 #include "arviss/arviss.h"
+#include "arviss/remix/cache.h"
 #include "arviss/remix/encoder.h"
 #include "arviss/remix/executors.h"
+#include "arviss/remix/tailcall.h"
+#include "arviss/remix/threaded.h"
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "arviss/arviss.h"
+
+#include <array>
+#include <vector>
+
+namespace arviss::remix
+{
+    // A table with an `Entry` for every `1 << entryShift` bytes of the guest's address space, e.g., for Remix words that
+    // are kept apart from the code that they came from. It's a fixed two-level table keyed on the page, so that its size
+    // depends on how much of the address space has entries rather than on how high up in it they are. A group is either
+    // empty or has an entry for each of its pages, and a page is either empty or has an entry, initially `empty`, for
+    // each slot in it.
+    template<typename Entry, u32 entryShift, Entry empty = Entry{}>
+    class SideTable
+    {
+        static constexpr u32 pageShift = 12;  // The table is split into 4KiB pages.
+        static constexpr u32 groupShift = 22; // Pages are grouped into 4MiB ranges of 1024 pages.
+        static constexpr u32 groupSize = 1 << (groupShift - pageShift);
+        static constexpr u32 pageSize = 1 << pageShift;
+
+        using Page = std::vector<Entry>;
+        using Group = std::vector<Page>;
+
+        std::array<Group, 1 << (32 - groupShift)> groups_{};
+
+        static auto Slot(Address address) -> size_t { return (address & (pageSize - 1)) >> entryShift; }
+
+    public:
+        // Returns the entry for `address`, or nullptr if nothing on its page has been set.
+        auto Find(Address address) const -> const Entry*
+        {
+            const auto& group = groups_[address >> groupShift];
+            if (!group.empty())
+            {
+                const auto& page = group[(address >> pageShift) & (groupSize - 1)];
+                if (!page.empty())
+                {
+                    return &page[Slot(address)];
+                }
+            }
+            return nullptr;
+        }
+
+        // Sets the entry for `address`.
+        auto Set(Address address, const Entry& entry) -> void
+        {
+            auto& group = groups_[address >> groupShift];
+            if (group.empty())
+            {
+                group.resize(groupSize);
+            }
+            auto& page = group[(address >> pageShift) & (groupSize - 1)];
+            if (page.empty())
+            {
+                page.resize(pageSize >> entryShift, empty);
+            }
+            page[Slot(address)] = entry;
+        }
+
+        // Throws away the entries for the page containing `address`.
+        auto ClearPage(Address address) -> void
+        {
+            auto& group = groups_[address >> groupShift];
+            if (!group.empty())
+            {
+                group[(address >> pageShift) & (groupSize - 1)].clear();
+            }
+        }
+
+        // Throws away every entry.
+        auto Clear() -> void
+        {
+            for (auto& group : groups_)
+            {
+                group.clear();
+            }
+        }
+    };
+} // namespace arviss::remix
@@ -0,0 +1,720 @@
+#pragma once
+
+#include "arviss/arviss.h"
+#include "arviss/remix/encoder.h"
+#include "arviss/remix/executors.h"
+#include "arviss/rv32/concepts.h"
+
+#include <array>
+#include <utility>
+
+// ARVISS_MUSTTAIL marks a return statement as a call that must be compiled as a tail call. Clang has supported it since
+// clang 13, and GCC since GCC 15. Define ARVISS_HAS_MUSTTAIL as 0 to force the portable loop, or as 1 to rely on the
+// optimizer's sibling call elimination on a compiler without the attribute, e.g., GCC before 15 at -O2 or above.
+#if !defined(ARVISS_HAS_MUSTTAIL)
+#if defined(__has_cpp_attribute)
+#if __has_cpp_attribute(clang::musttail) || __has_cpp_attribute(gnu::musttail)
+#define ARVISS_HAS_MUSTTAIL 1
+#endif
+#endif
+#endif
+#if !defined(ARVISS_HAS_MUSTTAIL)
+#define ARVISS_HAS_MUSTTAIL 0
+#endif
+
+#if defined(__has_cpp_attribute)
+#if __has_cpp_attribute(clang::musttail)
+#define ARVISS_MUSTTAIL [[clang::musttail]]
+#elif __has_cpp_attribute(gnu::musttail)
+#define ARVISS_MUSTTAIL [[gnu::musttail]]
+#endif
+#endif
+#if !defined(ARVISS_MUSTTAIL)
+#define ARVISS_MUSTTAIL
+#endif
+
+namespace arviss::remix
+{
+    // A Remix dispatcher in continuation-passing style. Every Remix opcode has its own handler function which executes
+    // the instruction then, if there is budget left and no trap, fetches the next instruction and tail calls its
+    // handler through a table of function pointers indexed by the Remix opcode. The remaining budget and the
+    // instruction word are passed from handler to handler as arguments, so they stay in host registers rather than
+    // going through memory.
+    //
+    // Like ThreadedRemixDispatcher, there's an indirect branch per handler rather than one for the whole interpreter,
+    // but because each handler is a function in its own right, the compiler allocates registers for each one
+    // separately and can't merge their dispatch sequences. Without a guaranteed tail call, i.e., if ARVISS_HAS_MUSTTAIL
+    // is 0, each handler returns to a loop that calls the next one instead, because otherwise the stack would grow with
+    // every instruction.
+    //
+    // On a core with HasSequentialPc, e.g., SequentialCore, the handlers for instructions that can't jump move the
+    // program counter on with Advance(), so straight-line code never touches the jump target. Only the handlers for
+    // branches, jumps, and anything else that might change the flow of control, ask the core where to go next.
+    template<IsRemixDispatchable T, bool shadowed = false>
+    class TailCallRemixDispatcher : public RemixDispatcher<T, shadowed>
+    {
+        using Handler = auto (*)(TailCallRemixDispatcher& d, u32 code, size_t count) -> size_t;
+
+        auto Self() -> T& { return static_cast<T&>(*this); }
+
+        // Executes `code`, whose Remix opcode is `op`. As `op` is a constant, all but its own case is compiled away.
+        template<u32 op>
+        auto Execute(u32 code) -> void
+        {
+            auto& self = Self();
+            const Remix e = *reinterpret_cast<Remix*>(&code);
+
+            switch (op)
+            {
+            // Illegal instruction.
+            case Opcode::Illegal:
+                self.Illegal(this->IllegalCode(code));
+                return;
+
+            // --- RV32i.
+
+            // B-type instructions.
+            case Opcode::Beq:
+                self.Beq(e.btype.rs1(), e.btype.rs2(), e.btype.bimm());
+                return;
+            case Opcode::Bne:
+                self.Bne(e.btype.rs1(), e.btype.rs2(), e.btype.bimm());
+                return;
+            case Opcode::Blt:
+                self.Blt(e.btype.rs1(), e.btype.rs2(), e.btype.bimm());
+                return;
+            case Opcode::Bge:
+                self.Bge(e.btype.rs1(), e.btype.rs2(), e.btype.bimm());
+                return;
+            case Opcode::Bltu:
+                self.Bltu(e.btype.rs1(), e.btype.rs2(), e.btype.bimm());
+                return;
+            case Opcode::Bgeu:
+                self.Bgeu(e.btype.rs1(), e.btype.rs2(), e.btype.bimm());
+                return;
+
+            // I-type instructions.
+            case Opcode::Lb:
+                self.Lb(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                return;
+            case Opcode::Lh:
+                self.Lh(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                return;
+            case Opcode::Lw:
+                self.Lw(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                return;
+            case Opcode::Lbu:
+                self.Lbu(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                return;
+            case Opcode::Lhu:
+                self.Lhu(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                return;
+            case Opcode::Addi:
+                self.Addi(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                return;
+            case Opcode::Slti:
+                self.Slti(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                return;
+            case Opcode::Sltiu:
+                self.Sltiu(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                return;
+            case Opcode::Xori:
+                self.Xori(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                return;
+            case Opcode::Ori:
+                self.Ori(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                return;
+            case Opcode::Andi:
+                self.Andi(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                return;
+            case Opcode::Jalr:
+                self.Jalr(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                return;
+
+            // S-type instructions.
+            case Opcode::Sb:
+                this->CheckStore(self.Rx(e.stype.rs1()) + e.stype.simm(), 1);
+                self.Sb(e.stype.rs1(), e.stype.rs2(), e.stype.simm());
+                return;
+            case Opcode::Sh:
+                this->CheckStore(self.Rx(e.stype.rs1()) + e.stype.simm(), 2);
+                self.Sh(e.stype.rs1(), e.stype.rs2(), e.stype.simm());
+                return;
+            case Opcode::Sw:
+                this->CheckStore(self.Rx(e.stype.rs1()) + e.stype.simm(), 4);
+                self.Sw(e.stype.rs1(), e.stype.rs2(), e.stype.simm());
+                return;
+
+            // U-type instructions.
+            case Opcode::Auipc:
+                self.Auipc(e.utype.rd(), e.utype.uimm());
+                return;
+            case Opcode::Lui:
+                self.Lui(e.utype.rd(), e.utype.uimm());
+                return;
+
+            // J-type instructions.
+            case Opcode::Jal:
+                self.Jal(e.jtype.rd(), e.jtype.jimm());
+                return;
+
+            // Arithmetic instructions.
+            case Opcode::Add:
+                self.Add(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                return;
+            case Opcode::Sub:
+                self.Sub(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                return;
+            case Opcode::Sll:
+                self.Sll(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                return;
+            case Opcode::Slt:
+                self.Slt(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                return;
+            case Opcode::Sltu:
+                self.Sltu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                return;
+            case Opcode::Xor:
+                self.Xor(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                return;
+            case Opcode::Srl:
+                self.Srl(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                return;
+            case Opcode::Sra:
+                self.Sra(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                return;
+            case Opcode::Or:
+                self.Or(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                return;
+            case Opcode::And:
+                self.And(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                return;
+
+            // Immediate shift instructions.
+            case Opcode::Slli:
+                self.Slli(e.immShiftType.rd(), e.immShiftType.rs1(), e.immShiftType.shamt());
+                return;
+            case Opcode::Srli:
+                self.Srli(e.immShiftType.rd(), e.immShiftType.rs1(), e.immShiftType.shamt());
+                return;
+            case Opcode::Srai:
+                self.Srai(e.immShiftType.rd(), e.immShiftType.rs1(), e.immShiftType.shamt());
+                return;
+
+            // System instructions.
+            case Opcode::Fence:
+                self.Fence(e.fenceType.fm(), e.fenceType.rd(), e.fenceType.rs1());
+                return;
+            case Opcode::Ecall:
+                self.Ecall();
+                return;
+            case Opcode::Ebreak:
+                self.Ebreak();
+                return;
+
+            // Instructions whose destination was x0.
+            case Opcode::Nop:
+                return;
+            case Opcode::J:
+                self.Jal(this->sink, e.jtype.jimm());
+                return;
+            case Opcode::Jr:
+                self.Jalr(this->sink, e.itype.rs1(), e.itype.iimm());
+                return;
+            case Opcode::Load_x0:
+                this->LoadToSink(code);
+                return;
+
+            // --- RV32m.
+
+            // Integer multiply and divide instructions.
+            case Opcode::Mul:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    self.Mul(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Mulh:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    self.Mulh(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Mulhsu:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    self.Mulhsu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Mulhu:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    self.Mulhu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Div:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    self.Div(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Divu:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    self.Divu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Rem:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    self.Rem(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Remu:
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    self.Remu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                    return;
+                }
+                [[fallthrough]];
+            // --- RV32f.
+
+            // Floating point instructions.
+            case Opcode::Fmv_x_w:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fmv_x_w(e.f5Type.rd(), e.f5Type.rs1());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fclass_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fclass_s(e.f5Type.rd(), e.f5Type.rs1());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fmv_w_x:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fmv_w_x(e.f5Type.rd(), e.f5Type.rs1());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fsqrt_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fsqrt_s(e.f5rmType.rd(), e.f5rmType.rs1(), e.f5rmType.rm());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fcvt_w_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fcvt_w_s(e.f5rmType.rd(), e.f5rmType.rs1(), e.f5rmType.rm());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fcvt_wu_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fcvt_wu_s(e.f5rmType.rd(), e.f5rmType.rs1(), e.f5rmType.rm());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fcvt_s_w:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fcvt_s_w(e.f5rmType.rd(), e.f5rmType.rs1(), e.f5rmType.rm());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fcvt_s_wu:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fcvt_s_wu(e.f5rmType.rd(), e.f5rmType.rs1(), e.f5rmType.rm());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fsgnj_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fsgnj_s(e.f6Type.rd(), e.f6Type.rs1(), e.f6Type.rs2());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fsgnjn_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fsgnjn_s(e.f6Type.rd(), e.f6Type.rs1(), e.f6Type.rs2());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fsgnjx_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fsgnjx_s(e.f6Type.rd(), e.f6Type.rs1(), e.f6Type.rs2());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fmin_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fmin_s(e.f6Type.rd(), e.f6Type.rs1(), e.f6Type.rs2());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fmax_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fmax_s(e.f6Type.rd(), e.f6Type.rs1(), e.f6Type.rs2());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fle_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fle_s(e.f6Type.rd(), e.f6Type.rs1(), e.f6Type.rs2());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Flt_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Flt_s(e.f6Type.rd(), e.f6Type.rs1(), e.f6Type.rs2());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Feq_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Feq_s(e.f6Type.rd(), e.f6Type.rs1(), e.f6Type.rs2());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fadd_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fadd_s(e.f6rmType.rd(), e.f6rmType.rs1(), e.f6rmType.rs2(), e.f6rmType.rm());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fsub_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fsub_s(e.f6rmType.rd(), e.f6rmType.rs1(), e.f6rmType.rs2(), e.f6rmType.rm());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fmul_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fmul_s(e.f6rmType.rd(), e.f6rmType.rs1(), e.f6rmType.rs2(), e.f6rmType.rm());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fdiv_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fdiv_s(e.f6rmType.rd(), e.f6rmType.rs1(), e.f6rmType.rs2(), e.f6rmType.rm());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Flw:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Flw(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fsw:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    this->CheckStore(self.Rx(e.stype.rs1()) + e.stype.simm(), 4);
+                    self.Fsw(e.stype.rs1(), e.stype.rs2(), e.stype.simm());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fmadd_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fmadd_s(e.f7Type.rd(), e.f7Type.rs1(), e.f7Type.rs2(), e.f7Type.rs3(), e.f7Type.rm());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fmsub_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fmsub_s(e.f7Type.rd(), e.f7Type.rs1(), e.f7Type.rs2(), e.f7Type.rs3(), e.f7Type.rm());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fnmsub_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fnmsub_s(e.f7Type.rd(), e.f7Type.rs1(), e.f7Type.rs2(), e.f7Type.rs3(), e.f7Type.rm());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::Fnmadd_s:
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fnmadd_s(e.f7Type.rd(), e.f7Type.rs1(), e.f7Type.rs2(), e.f7Type.rs3(), e.f7Type.rm());
+                    return;
+                }
+                [[fallthrough]];
+            // --- RV32c.
+
+            // Compressed instructions that don't behave exactly like an RV32i instruction.
+            case Opcode::C_jal:
+                if constexpr (IsRv32cHandler<T>)
+                {
+                    self.C_jal(e.jtype.jimm());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::C_jalr:
+                if constexpr (IsRv32cHandler<T>)
+                {
+                    self.C_jalr(e.f5Type.rs1());
+                    return;
+                }
+                [[fallthrough]];
+            case Opcode::C_jr:
+                if constexpr (IsRv32cHandler<T>)
+                {
+                    self.C_jr(e.f5Type.rs1());
+                    return;
+                }
+                [[fallthrough]];
+
+            // If we don't know it then we assume it's RISC-V encoded and transcode it, which also executes it.
+            default:
+                this->Transcode(code);
+                return;
+            }
+        }
+
+        // True if the core lets the dispatcher advance the program counter itself. Remix words that are kept in the
+        // side table have sizes of their own, so then every fetch goes through Fetch() as usual.
+        static constexpr bool isSequential = HasSequentialPc<T> && !shadowed && !IsRv32cHandler<T>;
+
+        // True if the instruction with Remix opcode `op` is known to carry on with the next instruction. Branches, jumps
+        // and traps aren't, and nor is anything that's transcoded when it's executed, as it could turn out to be any of
+        // them.
+        static constexpr auto FallsThrough(u32 op) -> bool
+        {
+            switch (op)
+            {
+            case Opcode::Lb:
+            case Opcode::Lh:
+            case Opcode::Lw:
+            case Opcode::Lbu:
+            case Opcode::Lhu:
+            case Opcode::Load_x0:
+            case Opcode::Nop:
+            case Opcode::Addi:
+            case Opcode::Slti:
+            case Opcode::Sltiu:
+            case Opcode::Xori:
+            case Opcode::Ori:
+            case Opcode::Andi:
+            case Opcode::Sb:
+            case Opcode::Sh:
+            case Opcode::Sw:
+            case Opcode::Auipc:
+            case Opcode::Lui:
+            case Opcode::Add:
+            case Opcode::Sub:
+            case Opcode::Sll:
+            case Opcode::Slt:
+            case Opcode::Sltu:
+            case Opcode::Xor:
+            case Opcode::Srl:
+            case Opcode::Sra:
+            case Opcode::Or:
+            case Opcode::And:
+            case Opcode::Slli:
+            case Opcode::Srli:
+            case Opcode::Srai:
+            case Opcode::Fence:
+                return true;
+            case Opcode::Mul:
+            case Opcode::Mulh:
+            case Opcode::Mulhsu:
+            case Opcode::Mulhu:
+            case Opcode::Div:
+            case Opcode::Divu:
+            case Opcode::Rem:
+            case Opcode::Remu:
+                return IsRv32mHandler<T>;
+            case Opcode::Fmv_x_w:
+            case Opcode::Fclass_s:
+            case Opcode::Fmv_w_x:
+            case Opcode::Fsqrt_s:
+            case Opcode::Fcvt_w_s:
+            case Opcode::Fcvt_wu_s:
+            case Opcode::Fcvt_s_w:
+            case Opcode::Fcvt_s_wu:
+            case Opcode::Fsgnj_s:
+            case Opcode::Fsgnjn_s:
+            case Opcode::Fsgnjx_s:
+            case Opcode::Fmin_s:
+            case Opcode::Fmax_s:
+            case Opcode::Fle_s:
+            case Opcode::Flt_s:
+            case Opcode::Feq_s:
+            case Opcode::Fadd_s:
+            case Opcode::Fsub_s:
+            case Opcode::Fmul_s:
+            case Opcode::Fdiv_s:
+            case Opcode::Flw:
+            case Opcode::Fsw:
+            case Opcode::Fmadd_s:
+            case Opcode::Fmsub_s:
+            case Opcode::Fnmsub_s:
+            case Opcode::Fnmadd_s:
+                return IsRv32fHandler<T>;
+            default:
+                return false;
+            }
+        }
+
+        // True if executing the instruction with Remix opcode `op` might stop the CPU. An instruction that's known to
+        // fall through can only do that by trapping on a memory access, and then only if memory doesn't throw.
+        static constexpr auto MayStop(u32 op) -> bool
+        {
+            if (!FallsThrough(op))
+            {
+                return true;
+            }
+            if constexpr (HasNonThrowingMemory<T>)
+            {
+                switch (op)
+                {
+                case Opcode::Lb:
+                case Opcode::Lh:
+                case Opcode::Lw:
+                case Opcode::Lbu:
+                case Opcode::Lhu:
+                case Opcode::Load_x0:
+                case Opcode::Sb:
+                case Opcode::Sh:
+                case Opcode::Sw:
+                case Opcode::Flw:
+                case Opcode::Fsw:
+                    return true;
+                default:
+                    break;
+                }
+            }
+            return false;
+        }
+
+        // True if the CPU should stop. A core with stop events has a single word for traps and stop requests.
+        auto IsStopping() -> bool
+        {
+            if constexpr (HasStopEvents<T>)
+            {
+                return Self().Events() != 0;
+            }
+            else
+            {
+                return Self().IsTrapped();
+            }
+        }
+
+        // Fetches the instruction that follows one with Remix opcode `op`. If it's known to fall through, and the core
+        // allows it, this steps over it without asking the core whether it jumped.
+        template<u32 op>
+        auto FetchAfter() -> u32
+        {
+            if constexpr (isSequential && FallsThrough(op))
+            {
+                auto& self = Self();
+                return self.Fetch32(self.Advance());
+            }
+            else
+            {
+                return this->Fetch();
+            }
+        }
+
+        // The handler for Remix opcode `op`. It executes `code` then carries on with the next instruction until it has
+        // executed `count` instructions or the CPU stops, and returns how many of the `count` are left. Only the
+        // handlers for instructions that might stop the CPU check whether it has, so straight-line arithmetic only has
+        // to check the count, and a stop request is seen at the next branch or jump.
+        template<u32 op>
+        static auto Handle(TailCallRemixDispatcher& d, u32 code, size_t count) -> size_t
+        {
+            d.Execute<op>(code);
+#if ARVISS_HAS_MUSTTAIL
+            --count;
+            if constexpr (MayStop(op))
+            {
+                if (count == 0 || d.IsStopping())
+                {
+                    return count;
+                }
+            }
+            else if (count == 0)
+            {
+                return 0;
+            }
+            code = d.FetchAfter<op>();
+            ARVISS_MUSTTAIL return HandlerFor(code)(d, code, count);
+#else
+            return count;
+#endif
+        }
+
+        template<size_t... ops>
+        static constexpr auto MakeHandlers(std::index_sequence<ops...>) -> std::array<Handler, sizeof...(ops)>
+        {
+            return {&Handle<ops>...};
+        }
+
+        // Indexed by Remix opcode. Opcodes that Remix doesn't use get a handler that transcodes.
+        static constexpr std::array<Handler, 128> handlers = MakeHandlers(std::make_index_sequence<128>{});
+
+        static auto HandlerFor(u32 code) -> Handler { return handlers[reinterpret_cast<const Remix*>(&code)->f0.opc()]; }
+
+    public:
+        using Item = typename RemixDispatcher<T, shadowed>::Item;
+
+        // Fetches and executes up to `count` instructions, stopping early if the CPU traps or, if it has stop events,
+        // is asked to stop. Returns the number of instructions executed.
+        auto RunCounted(size_t count) -> size_t
+        {
+            if (count == 0 || IsStopping())
+            {
+                return 0;
+            }
+#if ARVISS_HAS_MUSTTAIL
+            const u32 code = this->Fetch();
+            return count - HandlerFor(code)(*this, code, count);
+#else
+            size_t executed = 0;
+            do
+            {
+                const u32 code = this->Fetch();
+                HandlerFor(code)(*this, code, count);
+                ++executed;
+            } while (executed < count && !IsStopping());
+            return executed;
+#endif
+        }
+
+        // Fetches and executes up to `count` instructions, stopping early if the CPU traps.
+        auto Run(size_t count) -> void { RunCounted(count); }
+    };
+} // namespace arviss::remix
+
+#undef ARVISS_MUSTTAIL
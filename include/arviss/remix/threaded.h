@@ -0,0 +1,608 @@
+#pragma once
+
+#include "arviss/arviss.h"
+#include "arviss/remix/encoder.h"
+#include "arviss/remix/executors.h"
+#include "arviss/rv32/concepts.h"
+
+// Labels as values (computed goto) are a GCC extension that clang also supports. Define ARVISS_HAS_COMPUTED_GOTO as 0
+// to force the portable switch-based loop.
+#if !defined(ARVISS_HAS_COMPUTED_GOTO)
+#if defined(__GNUC__) || defined(__clang__)
+#define ARVISS_HAS_COMPUTED_GOTO 1
+#else
+#define ARVISS_HAS_COMPUTED_GOTO 0
+#endif
+#endif
+
+// GCC will happily merge the identical dispatch sequences at the end of each handler back into one, leaving a single
+// indirect branch again. ARVISS_NO_CROSSJUMPING turns off the optimizations that do that for the threaded loop alone, as
+// if it were built with `-fno-gcse -fno-crossjumping`. Clang doesn't merge them.
+#if ARVISS_HAS_COMPUTED_GOTO && defined(__GNUC__) && !defined(__clang__)
+#define ARVISS_NO_CROSSJUMPING [[gnu::optimize("no-gcse", "no-crossjumping")]]
+#else
+#define ARVISS_NO_CROSSJUMPING
+#endif
+
+// ARVISS_REMIX_OP introduces the handler for a Remix opcode. ARVISS_REMIX_NEXT retires the instruction then, if there is
+// budget left and the CPU isn't stopping, fetches the next instruction and goes to its handler. ARVISS_REMIX_TRANSCODE
+// introduces the handler for anything that isn't a Remix opcode.
+#if ARVISS_HAS_COMPUTED_GOTO
+#define ARVISS_REMIX_OP(op) op_##op
+#define ARVISS_REMIX_TRANSCODE transcode
+#define ARVISS_REMIX_NEXT                                                                                                                                      \
+    if (--count == 0 || IsStopping())                                                                                                                          \
+    {                                                                                                                                                          \
+        return count;                                                                                                                                          \
+    }                                                                                                                                                          \
+    code = this->Fetch();                                                                                                                                      \
+    e = *reinterpret_cast<Remix*>(&code);                                                                                                                      \
+    goto *labels[e.f0.opc()]
+#else
+#define ARVISS_REMIX_OP(op) case Opcode::op
+#define ARVISS_REMIX_TRANSCODE default
+#define ARVISS_REMIX_NEXT break
+#endif
+
+// Computed goto is an extension, so -Wpedantic warns about every label in the table and every jump through it.
+#if ARVISS_HAS_COMPUTED_GOTO && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+namespace arviss::remix
+{
+    // A Remix dispatcher that owns the fetch / dispatch loop. Each handler fetches the next instruction and jumps directly
+    // to that instruction's handler through a table of labels indexed by the Remix opcode, so there is an indirect branch
+    // per handler rather than a single, hard to predict, indirect branch at the top of a switch. On compilers without
+    // computed goto it falls back to a switch in a loop.
+    template<IsRemixDispatchable T, bool shadowed = false>
+    class ThreadedRemixDispatcher : public RemixDispatcher<T, shadowed>
+    {
+        auto Self() -> T& { return static_cast<T&>(*this); }
+
+        // True if the CPU should stop. A core with stop events has a single word for traps and stop requests.
+        auto IsStopping() -> bool
+        {
+            if constexpr (HasStopEvents<T>)
+            {
+                return Self().Events() != 0;
+            }
+            else
+            {
+                return Self().IsTrapped();
+            }
+        }
+
+        // Fetches and executes up to `count` instructions, stopping early if the CPU traps or, if it has stop events,
+        // is asked to stop. Returns how many of the `count` are left.
+        // clang-format off
+        ARVISS_NO_CROSSJUMPING auto RunRemaining(size_t count) -> size_t
+        {
+            auto& self = Self();
+            if (count == 0 || IsStopping())
+            {
+                return count;
+            }
+
+            u32 code = this->Fetch();
+            Remix e = *reinterpret_cast<Remix*>(&code);
+
+#if ARVISS_HAS_COMPUTED_GOTO
+            // Indexed by opcode, in the same order as `remix::Opcode`. RV32 placeholders, fused pairs, which only the block
+            // cache uses, and unused opcodes transcode.
+            static void* const labels[128] = {
+                &&op_Illegal, &&op_Beq, &&op_Bne, &&transcode,
+                &&op_Blt, &&op_Bge, &&op_Bltu, &&transcode,
+                &&op_Bgeu, &&op_Lb, &&op_Lh, &&transcode,
+                &&op_Lw, &&op_Lbu, &&op_Lhu, &&transcode,
+                &&op_Addi, &&op_Slti, &&op_Sltiu, &&transcode,
+                &&op_Xori, &&op_Ori, &&op_Andi, &&transcode,
+                &&op_Jalr, &&op_Sb, &&op_Sh, &&transcode,
+                &&op_Sw, &&op_Auipc, &&op_Lui, &&transcode,
+                &&op_Jal, &&op_Add, &&op_Sub, &&transcode,
+                &&op_Sll, &&op_Slt, &&op_Sltu, &&transcode,
+                &&op_Xor, &&op_Srl, &&op_Sra, &&transcode,
+                &&op_Or, &&op_And, &&op_Slli, &&transcode,
+                &&op_Srli, &&op_Srai, &&op_Fence, &&transcode,
+                &&op_Ecall, &&op_Ebreak, &&op_Mul, &&transcode,
+                &&op_Mulh, &&op_Mulhsu, &&op_Mulhu, &&transcode,
+                &&op_Div, &&op_Divu, &&op_Rem, &&transcode,
+                &&op_Remu, &&op_Fmv_x_w, &&op_Fclass_s, &&transcode,
+                &&op_Fmv_w_x, &&op_Fsqrt_s, &&op_Fcvt_w_s, &&transcode,
+                &&op_Fcvt_wu_s, &&op_Fcvt_s_w, &&op_Fcvt_s_wu, &&transcode,
+                &&op_Fsgnj_s, &&op_Fsgnjn_s, &&op_Fsgnjx_s, &&transcode,
+                &&op_Fmin_s, &&op_Fmax_s, &&op_Fle_s, &&transcode,
+                &&op_Flt_s, &&op_Feq_s, &&op_Fadd_s, &&transcode,
+                &&op_Fsub_s, &&op_Fmul_s, &&op_Fdiv_s, &&transcode,
+                &&op_Flw, &&op_Fsw, &&op_Fmadd_s, &&transcode,
+                &&op_Fmsub_s, &&op_Fnmsub_s, &&op_Fnmadd_s, &&transcode,
+                &&op_C_jal, &&op_C_jalr, &&op_C_jr, &&transcode,
+                &&transcode, &&transcode, &&transcode, &&transcode,
+                &&transcode, &&op_Nop, &&op_J, &&transcode,
+                &&op_Jr, &&op_Load_x0, &&transcode, &&transcode,
+                &&transcode, &&transcode, &&transcode, &&transcode,
+                &&transcode, &&transcode, &&transcode, &&transcode,
+                &&transcode, &&transcode, &&transcode, &&transcode,
+            };
+            static_assert(Opcode::C_jr == 0x66 && Opcode::Load_x0 == 0x71, "The label table is out of step with remix::Opcode");
+
+            goto *labels[e.f0.opc()];
+#else
+            for (;;)
+            {
+            switch (e.f0.opc())
+            {
+#endif
+            // Illegal instruction.
+            ARVISS_REMIX_OP(Illegal):
+                self.Illegal(this->IllegalCode(code));
+                ARVISS_REMIX_NEXT;
+
+            // --- RV32i.
+
+            // B-type instructions.
+            ARVISS_REMIX_OP(Beq):
+                self.Beq(e.btype.rs1(), e.btype.rs2(), e.btype.bimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Bne):
+                self.Bne(e.btype.rs1(), e.btype.rs2(), e.btype.bimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Blt):
+                self.Blt(e.btype.rs1(), e.btype.rs2(), e.btype.bimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Bge):
+                self.Bge(e.btype.rs1(), e.btype.rs2(), e.btype.bimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Bltu):
+                self.Bltu(e.btype.rs1(), e.btype.rs2(), e.btype.bimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Bgeu):
+                self.Bgeu(e.btype.rs1(), e.btype.rs2(), e.btype.bimm());
+                ARVISS_REMIX_NEXT;
+
+            // I-type instructions.
+            ARVISS_REMIX_OP(Lb):
+                self.Lb(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Lh):
+                self.Lh(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Lw):
+                self.Lw(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Lbu):
+                self.Lbu(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Lhu):
+                self.Lhu(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Addi):
+                self.Addi(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Slti):
+                self.Slti(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Sltiu):
+                self.Sltiu(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Xori):
+                self.Xori(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Ori):
+                self.Ori(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Andi):
+                self.Andi(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Jalr):
+                self.Jalr(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                ARVISS_REMIX_NEXT;
+
+            // S-type instructions.
+            ARVISS_REMIX_OP(Sb):
+                this->CheckStore(self.Rx(e.stype.rs1()) + e.stype.simm(), 1);
+                self.Sb(e.stype.rs1(), e.stype.rs2(), e.stype.simm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Sh):
+                this->CheckStore(self.Rx(e.stype.rs1()) + e.stype.simm(), 2);
+                self.Sh(e.stype.rs1(), e.stype.rs2(), e.stype.simm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Sw):
+                this->CheckStore(self.Rx(e.stype.rs1()) + e.stype.simm(), 4);
+                self.Sw(e.stype.rs1(), e.stype.rs2(), e.stype.simm());
+                ARVISS_REMIX_NEXT;
+
+            // U-type instructions.
+            ARVISS_REMIX_OP(Auipc):
+                self.Auipc(e.utype.rd(), e.utype.uimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Lui):
+                self.Lui(e.utype.rd(), e.utype.uimm());
+                ARVISS_REMIX_NEXT;
+
+            // J-type instructions.
+            ARVISS_REMIX_OP(Jal):
+                self.Jal(e.jtype.rd(), e.jtype.jimm());
+                ARVISS_REMIX_NEXT;
+
+            // Arithmetic instructions.
+            ARVISS_REMIX_OP(Add):
+                self.Add(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Sub):
+                self.Sub(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Sll):
+                self.Sll(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Slt):
+                self.Slt(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Sltu):
+                self.Sltu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Xor):
+                self.Xor(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Srl):
+                self.Srl(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Sra):
+                self.Sra(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Or):
+                self.Or(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(And):
+                self.And(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                ARVISS_REMIX_NEXT;
+
+            // Immediate shift instructions.
+            ARVISS_REMIX_OP(Slli):
+                self.Slli(e.immShiftType.rd(), e.immShiftType.rs1(), e.immShiftType.shamt());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Srli):
+                self.Srli(e.immShiftType.rd(), e.immShiftType.rs1(), e.immShiftType.shamt());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Srai):
+                self.Srai(e.immShiftType.rd(), e.immShiftType.rs1(), e.immShiftType.shamt());
+                ARVISS_REMIX_NEXT;
+
+            // System instructions.
+            ARVISS_REMIX_OP(Fence):
+                self.Fence(e.fenceType.fm(), e.fenceType.rd(), e.fenceType.rs1());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Ecall):
+                self.Ecall();
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Ebreak):
+                self.Ebreak();
+                ARVISS_REMIX_NEXT;
+
+            // Instructions whose destination was x0.
+            ARVISS_REMIX_OP(Nop):
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(J):
+                self.Jal(this->sink, e.jtype.jimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Jr):
+                self.Jalr(this->sink, e.itype.rs1(), e.itype.iimm());
+                ARVISS_REMIX_NEXT;
+            ARVISS_REMIX_OP(Load_x0):
+                this->LoadToSink(code);
+                ARVISS_REMIX_NEXT;
+
+            // --- RV32m.
+
+            // Integer multiply and divide instructions.
+            ARVISS_REMIX_OP(Mul):
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    self.Mul(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Mulh):
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    self.Mulh(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Mulhsu):
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    self.Mulhsu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Mulhu):
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    self.Mulhu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Div):
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    self.Div(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Divu):
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    self.Divu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Rem):
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    self.Rem(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Remu):
+                if constexpr (IsRv32mHandler<T>)
+                {
+                    self.Remu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+
+            // --- RV32f.
+
+            // Floating point instructions.
+            ARVISS_REMIX_OP(Fmv_x_w):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fmv_x_w(e.f5Type.rd(), e.f5Type.rs1());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fclass_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fclass_s(e.f5Type.rd(), e.f5Type.rs1());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fmv_w_x):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fmv_w_x(e.f5Type.rd(), e.f5Type.rs1());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fsqrt_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fsqrt_s(e.f5rmType.rd(), e.f5rmType.rs1(), e.f5rmType.rm());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fcvt_w_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fcvt_w_s(e.f5rmType.rd(), e.f5rmType.rs1(), e.f5rmType.rm());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fcvt_wu_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fcvt_wu_s(e.f5rmType.rd(), e.f5rmType.rs1(), e.f5rmType.rm());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fcvt_s_w):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fcvt_s_w(e.f5rmType.rd(), e.f5rmType.rs1(), e.f5rmType.rm());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fcvt_s_wu):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fcvt_s_wu(e.f5rmType.rd(), e.f5rmType.rs1(), e.f5rmType.rm());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fsgnj_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fsgnj_s(e.f6Type.rd(), e.f6Type.rs1(), e.f6Type.rs2());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fsgnjn_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fsgnjn_s(e.f6Type.rd(), e.f6Type.rs1(), e.f6Type.rs2());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fsgnjx_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fsgnjx_s(e.f6Type.rd(), e.f6Type.rs1(), e.f6Type.rs2());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fmin_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fmin_s(e.f6Type.rd(), e.f6Type.rs1(), e.f6Type.rs2());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fmax_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fmax_s(e.f6Type.rd(), e.f6Type.rs1(), e.f6Type.rs2());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fle_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fle_s(e.f6Type.rd(), e.f6Type.rs1(), e.f6Type.rs2());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Flt_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Flt_s(e.f6Type.rd(), e.f6Type.rs1(), e.f6Type.rs2());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Feq_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Feq_s(e.f6Type.rd(), e.f6Type.rs1(), e.f6Type.rs2());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fadd_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fadd_s(e.f6rmType.rd(), e.f6rmType.rs1(), e.f6rmType.rs2(), e.f6rmType.rm());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fsub_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fsub_s(e.f6rmType.rd(), e.f6rmType.rs1(), e.f6rmType.rs2(), e.f6rmType.rm());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fmul_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fmul_s(e.f6rmType.rd(), e.f6rmType.rs1(), e.f6rmType.rs2(), e.f6rmType.rm());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fdiv_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fdiv_s(e.f6rmType.rd(), e.f6rmType.rs1(), e.f6rmType.rs2(), e.f6rmType.rm());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Flw):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Flw(e.itype.rd(), e.itype.rs1(), e.itype.iimm());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fsw):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    this->CheckStore(self.Rx(e.stype.rs1()) + e.stype.simm(), 4);
+                    self.Fsw(e.stype.rs1(), e.stype.rs2(), e.stype.simm());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fmadd_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fmadd_s(e.f7Type.rd(), e.f7Type.rs1(), e.f7Type.rs2(), e.f7Type.rs3(), e.f7Type.rm());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fmsub_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fmsub_s(e.f7Type.rd(), e.f7Type.rs1(), e.f7Type.rs2(), e.f7Type.rs3(), e.f7Type.rm());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fnmsub_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fnmsub_s(e.f7Type.rd(), e.f7Type.rs1(), e.f7Type.rs2(), e.f7Type.rs3(), e.f7Type.rm());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(Fnmadd_s):
+                if constexpr (IsRv32fHandler<T>)
+                {
+                    self.Fnmadd_s(e.f7Type.rd(), e.f7Type.rs1(), e.f7Type.rs2(), e.f7Type.rs3(), e.f7Type.rm());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+
+            // --- RV32c.
+
+            // Compressed instructions that don't behave exactly like an RV32i instruction.
+            ARVISS_REMIX_OP(C_jal):
+                if constexpr (IsRv32cHandler<T>)
+                {
+                    self.C_jal(e.jtype.jimm());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(C_jalr):
+                if constexpr (IsRv32cHandler<T>)
+                {
+                    self.C_jalr(e.f5Type.rs1());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+            ARVISS_REMIX_OP(C_jr):
+                if constexpr (IsRv32cHandler<T>)
+                {
+                    self.C_jr(e.f5Type.rs1());
+                    ARVISS_REMIX_NEXT;
+                }
+                goto transcode;
+
+            // If we don't know it then we assume it's RISC-V encoded and transcode it, which also executes it.
+            ARVISS_REMIX_TRANSCODE:
+#if !ARVISS_HAS_COMPUTED_GOTO
+            transcode:
+#endif
+                this->Transcode(code);
+                ARVISS_REMIX_NEXT;
+#if !ARVISS_HAS_COMPUTED_GOTO
+            }
+
+            if (--count == 0 || IsStopping())
+            {
+                return count;
+            }
+            code = this->Fetch();
+            e = *reinterpret_cast<Remix*>(&code);
+            }
+#endif
+        }
+        // clang-format on
+
+    public:
+        using Item = typename RemixDispatcher<T, shadowed>::Item;
+
+        // Fetches and executes up to `count` instructions, stopping early if the CPU traps or, if it has stop events,
+        // is asked to stop. Returns the number of instructions executed.
+        auto RunCounted(size_t count) -> size_t { return count - RunRemaining(count); }
+
+        // Fetches and executes up to `count` instructions, stopping early if the CPU traps.
+        auto Run(size_t count) -> void { RunRemaining(count); }
+    };
+} // namespace arviss::remix
+
+#if ARVISS_HAS_COMPUTED_GOTO && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+#undef ARVISS_NO_CROSSJUMPING
+#undef ARVISS_REMIX_OP
+#undef ARVISS_REMIX_TRANSCODE
+#undef ARVISS_REMIX_NEXT
@@ -100,6 +100,16 @@ namespace arviss
         };
     } // namespace impl
 
+    // T is a set of hooks that an executor calls as it executes instructions.
+    template<typename T>
+    concept IsExecutionHooks = requires(T t, Address a, u32 size, bool taken, TrapType type, u32 context) {
+        t.OnInstruction(a);         // Called with the pc of each instruction before it's executed.
+        t.OnLoad(a, size);          // Called with the address and size of each load.
+        t.OnStore(a, size);         // Called with the address and size of each store.
+        t.OnBranch(a, a, taken);    // Called with the pc and target of each conditional branch, and if it's taken.
+        t.OnTrap(a, type, context); // Called with the pc of each trap, and its type and context.
+    };
+
     // T is an instruction handler for Rv32i instructions.
     template<typename T>
     concept IsRv32iHandler = impl::IsNonVoidRv32iHandler<T> || impl::IsVoidRv32iHandler<T>;
@@ -8,7 +8,7 @@
 
 namespace arviss
 {
-    auto Abi(Reg r) -> const char*
+    inline auto Abi(Reg r) -> const char*
     {
         static const char* abiNames[] = {
                 "zero", "ra", "sp", "gp", "tp", "t0", "t1", "t2", "s0", "s1", "a0",  "a1",  "a2", "a3", "a4", "a5",
@@ -17,6 +17,15 @@ namespace arviss
         return abiNames[r];
     }
 
+    inline auto FAbi(Reg r) -> const char*
+    {
+        static const char* abiNames[] = {
+                "ft0", "ft1", "ft2", "ft3", "ft4", "ft5", "ft6", "ft7", "fs0", "fs1", "fa0",  "fa1",  "fa2", "fa3", "fa4",  "fa5",
+                "fa6", "fa7", "fs2", "fs3", "fs4", "fs5", "fs6", "fs7", "fs8", "fs9", "fs10", "fs11", "ft8", "ft9", "ft10", "ft11",
+        };
+        return abiNames[r];
+    }
+
     // An instruction handler for a disassembler for Rv32i instructions.
     struct Rv32iDisassemblingHandler
     {
@@ -77,7 +86,7 @@ namespace arviss
         auto C_ebreak() -> Item { return Ebreak(); }                                       // ebreak
         auto C_jr(Reg rs1n0) -> Item { return Jalr(RegNames::ZERO, rs1n0, 0); }            // jalr x0, 0(rs1)
         auto C_jalr(Reg rs1n0) -> Item { return Jalr(RegNames::RA, rs1n0, 0); }            // jalr x1, 0(rs1)
-        auto C_nop(u32 u) -> Item { return "c_nop"; }                                      // nop
+        auto C_nop(u32) -> Item { return "c_nop"; }                                        // nop
         auto C_addi16sp(u32 imm) -> Item { return Addi(RegNames::SP, RegNames::SP, imm); } // addi x2, x2, nzimm[9:4]
         auto C_sub(Reg rdrs1p, Reg rs2p) -> Item { return Sub(rdrs1p, rdrs1p, rs2p); }     // sub rdp, rdp, rs2p
         auto C_xor(Reg rdrs1p, Reg rs2p) -> Item { return Xor(rdrs1p, rdrs1p, rs2p); }     // xor rdp, rdp, rs2p
@@ -105,4 +114,70 @@ namespace arviss
 
     // A disassembler for Rv32ic instructions.
     using Rv32icDisassembler = Rv32icDispatcher<Rv32icDisassemblingHandler>;
+
+    // An instruction handler for a disassembler for Rv32im instructions.
+    struct Rv32imDisassemblingHandler : public Rv32iDisassemblingHandler
+    {
+        using Item = Rv32iDisassemblingHandler::Item;
+
+        auto Mul(Reg rd, Reg rs1, Reg rs2) -> Item { return std::format("mul\t{}, {}, {}", Abi(rd), Abi(rs1), Abi(rs2)); }
+        auto Mulh(Reg rd, Reg rs1, Reg rs2) -> Item { return std::format("mulh\t{}, {}, {}", Abi(rd), Abi(rs1), Abi(rs2)); }
+        auto Mulhsu(Reg rd, Reg rs1, Reg rs2) -> Item { return std::format("mulhsu\t{}, {}, {}", Abi(rd), Abi(rs1), Abi(rs2)); }
+        auto Mulhu(Reg rd, Reg rs1, Reg rs2) -> Item { return std::format("mulhu\t{}, {}, {}", Abi(rd), Abi(rs1), Abi(rs2)); }
+        auto Div(Reg rd, Reg rs1, Reg rs2) -> Item { return std::format("div\t{}, {}, {}", Abi(rd), Abi(rs1), Abi(rs2)); }
+        auto Divu(Reg rd, Reg rs1, Reg rs2) -> Item { return std::format("divu\t{}, {}, {}", Abi(rd), Abi(rs1), Abi(rs2)); }
+        auto Rem(Reg rd, Reg rs1, Reg rs2) -> Item { return std::format("rem\t{}, {}, {}", Abi(rd), Abi(rs1), Abi(rs2)); }
+        auto Remu(Reg rd, Reg rs1, Reg rs2) -> Item { return std::format("remu\t{}, {}, {}", Abi(rd), Abi(rs1), Abi(rs2)); }
+    };
+
+    // A disassembler for Rv32im instructions.
+    using Rv32imDisassembler = Rv32imDispatcher<Rv32imDisassemblingHandler>;
+
+    // An instruction handler for a disassembler for Rv32imf instructions. Rounding modes aren't shown.
+    struct Rv32imfDisassemblingHandler : public Rv32imDisassemblingHandler
+    {
+        using Item = Rv32imDisassemblingHandler::Item;
+
+        auto Fmv_x_w(Reg rd, Reg rs1) -> Item { return std::format("fmv.x.w\t{}, {}", Abi(rd), FAbi(rs1)); }
+        auto Fclass_s(Reg rd, Reg rs1) -> Item { return std::format("fclass.s\t{}, {}", Abi(rd), FAbi(rs1)); }
+        auto Fmv_w_x(Reg rd, Reg rs1) -> Item { return std::format("fmv.w.x\t{}, {}", FAbi(rd), Abi(rs1)); }
+        auto Fsqrt_s(Reg rd, Reg rs1, u32 /*rm*/) -> Item { return std::format("fsqrt.s\t{}, {}", FAbi(rd), FAbi(rs1)); }
+        auto Fcvt_w_s(Reg rd, Reg rs1, u32 /*rm*/) -> Item { return std::format("fcvt.w.s\t{}, {}", Abi(rd), FAbi(rs1)); }
+        auto Fcvt_wu_s(Reg rd, Reg rs1, u32 /*rm*/) -> Item { return std::format("fcvt.wu.s\t{}, {}", Abi(rd), FAbi(rs1)); }
+        auto Fcvt_s_w(Reg rd, Reg rs1, u32 /*rm*/) -> Item { return std::format("fcvt.s.w\t{}, {}", FAbi(rd), Abi(rs1)); }
+        auto Fcvt_s_wu(Reg rd, Reg rs1, u32 /*rm*/) -> Item { return std::format("fcvt.s.wu\t{}, {}", FAbi(rd), Abi(rs1)); }
+        auto Fsgnj_s(Reg rd, Reg rs1, Reg rs2) -> Item { return std::format("fsgnj.s\t{}, {}, {}", FAbi(rd), FAbi(rs1), FAbi(rs2)); }
+        auto Fsgnjn_s(Reg rd, Reg rs1, Reg rs2) -> Item { return std::format("fsgnjn.s\t{}, {}, {}", FAbi(rd), FAbi(rs1), FAbi(rs2)); }
+        auto Fsgnjx_s(Reg rd, Reg rs1, Reg rs2) -> Item { return std::format("fsgnjx.s\t{}, {}, {}", FAbi(rd), FAbi(rs1), FAbi(rs2)); }
+        auto Fmin_s(Reg rd, Reg rs1, Reg rs2) -> Item { return std::format("fmin.s\t{}, {}, {}", FAbi(rd), FAbi(rs1), FAbi(rs2)); }
+        auto Fmax_s(Reg rd, Reg rs1, Reg rs2) -> Item { return std::format("fmax.s\t{}, {}, {}", FAbi(rd), FAbi(rs1), FAbi(rs2)); }
+        auto Fle_s(Reg rd, Reg rs1, Reg rs2) -> Item { return std::format("fle.s\t{}, {}, {}", Abi(rd), FAbi(rs1), FAbi(rs2)); }
+        auto Flt_s(Reg rd, Reg rs1, Reg rs2) -> Item { return std::format("flt.s\t{}, {}, {}", Abi(rd), FAbi(rs1), FAbi(rs2)); }
+        auto Feq_s(Reg rd, Reg rs1, Reg rs2) -> Item { return std::format("feq.s\t{}, {}, {}", Abi(rd), FAbi(rs1), FAbi(rs2)); }
+        auto Fadd_s(Reg rd, Reg rs1, Reg rs2, u32 /*rm*/) -> Item { return std::format("fadd.s\t{}, {}, {}", FAbi(rd), FAbi(rs1), FAbi(rs2)); }
+        auto Fsub_s(Reg rd, Reg rs1, Reg rs2, u32 /*rm*/) -> Item { return std::format("fsub.s\t{}, {}, {}", FAbi(rd), FAbi(rs1), FAbi(rs2)); }
+        auto Fmul_s(Reg rd, Reg rs1, Reg rs2, u32 /*rm*/) -> Item { return std::format("fmul.s\t{}, {}, {}", FAbi(rd), FAbi(rs1), FAbi(rs2)); }
+        auto Fdiv_s(Reg rd, Reg rs1, Reg rs2, u32 /*rm*/) -> Item { return std::format("fdiv.s\t{}, {}, {}", FAbi(rd), FAbi(rs1), FAbi(rs2)); }
+        auto Flw(Reg rd, Reg rs1, u32 iimm) -> Item { return std::format("flw\t{}, {}({})", FAbi(rd), static_cast<i32>(iimm), Abi(rs1)); }
+        auto Fsw(Reg rs1, Reg rs2, u32 simm) -> Item { return std::format("fsw\t{}, {}({})", FAbi(rs2), static_cast<i32>(simm), Abi(rs1)); }
+        auto Fmadd_s(Reg rd, Reg rs1, Reg rs2, Reg rs3, u32 /*rm*/) -> Item
+        {
+            return std::format("fmadd.s\t{}, {}, {}, {}", FAbi(rd), FAbi(rs1), FAbi(rs2), FAbi(rs3));
+        }
+        auto Fmsub_s(Reg rd, Reg rs1, Reg rs2, Reg rs3, u32 /*rm*/) -> Item
+        {
+            return std::format("fmsub.s\t{}, {}, {}, {}", FAbi(rd), FAbi(rs1), FAbi(rs2), FAbi(rs3));
+        }
+        auto Fnmsub_s(Reg rd, Reg rs1, Reg rs2, Reg rs3, u32 /*rm*/) -> Item
+        {
+            return std::format("fnmsub.s\t{}, {}, {}, {}", FAbi(rd), FAbi(rs1), FAbi(rs2), FAbi(rs3));
+        }
+        auto Fnmadd_s(Reg rd, Reg rs1, Reg rs2, Reg rs3, u32 /*rm*/) -> Item
+        {
+            return std::format("fnmadd.s\t{}, {}, {}, {}", FAbi(rd), FAbi(rs1), FAbi(rs2), FAbi(rs3));
+        }
+    };
+
+    // A disassembler for Rv32imf instructions.
+    using Rv32imfDisassembler = Rv32imfDispatcher<Rv32imfDisassemblingHandler>;
 } // namespace arviss
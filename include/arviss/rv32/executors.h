@@ -6,30 +6,205 @@
 #include <bit>
 #include <cmath>
 #include <limits>
+#include <optional>
 
 namespace arviss
 {
+    // Execution hooks that do nothing, and compile away to nothing. Derive from this and hide the hooks that you need.
+    struct NoHooks
+    {
+        auto OnInstruction(Address /*pc*/) -> void {}
+        auto OnLoad(Address /*address*/, u32 /*size*/) -> void {}
+        auto OnStore(Address /*address*/, u32 /*size*/) -> void {}
+        auto OnBranch(Address /*pc*/, Address /*target*/, bool /*taken*/) -> void {}
+        auto OnTrap(Address /*pc*/, TrapType /*type*/, u32 /*context*/) -> void {}
+    };
+
+    static_assert(IsExecutionHooks<NoHooks>);
+
     // An Rv32i instruction handler that executes instructions on an integer core. BYO core.
-    template<IsIntegerCore T>
+    //
+    // The executor calls `Hooks` as it goes. OnInstruction() is called on each fetch, so it fires once per instruction
+    // for dispatchers that fetch one instruction at a time, including the Remix dispatchers, but the block cache also
+    // calls it once per block lookup, and the JIT and AOT tiers don't call it for native code.
+    template<IsIntegerCore T, IsExecutionHooks Hooks = NoHooks>
     class Rv32iExecutor : public T
     {
         auto Self() -> T& { return static_cast<T&>(*this); }
 
+        [[no_unique_address]] Hooks hooks_{};
+
+        // Takes a conditional branch to pc + bimm if `condition` is true.
+        auto BranchIf(bool condition, u32 bimm) -> void
+        {
+            auto& self = Self();
+            const auto target = self.Pc() + bimm;
+            hooks_.OnBranch(self.Pc(), target, condition);
+            if (condition)
+            {
+                self.SetNextPc(target);
+            }
+        }
+
         // Sign extend a byte.
         static auto SExt(u8 byte) -> i32 { return static_cast<i32>(static_cast<i16>(static_cast<i8>(byte))); }
 
         // Sign extend a halfword.
         static auto SExt(u16 halfWord) -> i32 { return static_cast<i32>(static_cast<i16>(halfWord)); }
 
+    protected:
+        // Loads and stores. If the core's memory doesn't throw then a bad access raises a LoadAccessFault or a
+        // StoreAccessFault with the address as its context, and a load returns nothing.
+
+        auto Load8(Address address) -> std::optional<u8>
+        {
+            auto& self = Self();
+            hooks_.OnLoad(address, sizeof(u8));
+            if constexpr (HasNonThrowingMemory<T>)
+            {
+                const auto byte = self.TryRead8(address);
+                if (!byte)
+                {
+                    RaiseTrap(TrapType::LoadAccessFault, address);
+                }
+                return byte;
+            }
+            else
+            {
+                return self.Read8(address);
+            }
+        }
+
+        auto Load16(Address address) -> std::optional<u16>
+        {
+            auto& self = Self();
+            hooks_.OnLoad(address, sizeof(u16));
+            if constexpr (HasNonThrowingMemory<T>)
+            {
+                const auto halfWord = self.TryRead16(address);
+                if (!halfWord)
+                {
+                    RaiseTrap(TrapType::LoadAccessFault, address);
+                }
+                return halfWord;
+            }
+            else
+            {
+                return self.Read16(address);
+            }
+        }
+
+        auto Load32(Address address) -> std::optional<u32>
+        {
+            auto& self = Self();
+            hooks_.OnLoad(address, sizeof(u32));
+            if constexpr (HasNonThrowingMemory<T>)
+            {
+                const auto word = self.TryRead32(address);
+                if (!word)
+                {
+                    RaiseTrap(TrapType::LoadAccessFault, address);
+                }
+                return word;
+            }
+            else
+            {
+                return self.Read32(address);
+            }
+        }
+
+        auto Store8(Address address, u8 byte) -> void
+        {
+            auto& self = Self();
+            hooks_.OnStore(address, sizeof(u8));
+            if constexpr (HasNonThrowingMemory<T>)
+            {
+                if (!self.TryWrite8(address, byte))
+                {
+                    RaiseTrap(TrapType::StoreAccessFault, address);
+                }
+            }
+            else
+            {
+                self.Write8(address, byte);
+            }
+        }
+
+        auto Store16(Address address, u16 halfWord) -> void
+        {
+            auto& self = Self();
+            hooks_.OnStore(address, sizeof(u16));
+            if constexpr (HasNonThrowingMemory<T>)
+            {
+                if (!self.TryWrite16(address, halfWord))
+                {
+                    RaiseTrap(TrapType::StoreAccessFault, address);
+                }
+            }
+            else
+            {
+                self.Write16(address, halfWord);
+            }
+        }
+
+        auto Store32(Address address, u32 word) -> void
+        {
+            auto& self = Self();
+            hooks_.OnStore(address, sizeof(u32));
+            if constexpr (HasNonThrowingMemory<T>)
+            {
+                if (!self.TryWrite32(address, word))
+                {
+                    RaiseTrap(TrapType::StoreAccessFault, address);
+                }
+            }
+            else
+            {
+                self.Write32(address, word);
+            }
+        }
+
     public:
         using Item = void;
 
+        // The executor's hooks.
+        auto Instrumentation() -> Hooks& { return hooks_; }
+
+        // As the core's, but tells the hooks.
+
+        auto Transfer() -> Address
+        {
+            const auto pc = T::Transfer();
+            hooks_.OnInstruction(pc);
+            return pc;
+        }
+
+        auto Fetch() -> u32
+        {
+            const auto ins = T::Fetch();
+            hooks_.OnInstruction(Self().Pc());
+            return ins;
+        }
+
+        auto Advance() -> Address
+            requires HasSequentialPc<T>
+        {
+            const auto pc = T::Advance();
+            hooks_.OnInstruction(pc);
+            return pc;
+        }
+
+        auto RaiseTrap(TrapType type, u32 context = 0) -> void
+        {
+            hooks_.OnTrap(Self().Pc(), type, context);
+            T::RaiseTrap(type, context);
+        }
+
         // Illegal instruction.
 
         auto Illegal(u32 ins) -> Item
         {
-            auto& self = Self();
-            self.RaiseTrap(TrapType::IllegalInstruction, ins);
+            RaiseTrap(TrapType::IllegalInstruction, ins);
         }
 
         // B-type instructions.
@@ -38,20 +213,14 @@ namespace arviss
         {
             // pc <- pc + ((rs1 == rs2) ? imm_b : 4)
             auto& self = Self();
-            if (self.Rx(rs1) == self.Rx(rs2))
-            {
-                self.SetNextPc(self.Pc() + bimm);
-            }
+            BranchIf(self.Rx(rs1) == self.Rx(rs2), bimm);
         }
 
         auto Bne(Reg rs1, Reg rs2, u32 bimm) -> Item
         {
             // pc <- pc + ((rs1 != rs2) ? imm_b : 4)
             auto& self = Self();
-            if (self.Rx(rs1) != self.Rx(rs2))
-            {
-                self.SetNextPc(self.Pc() + bimm);
-            }
+            BranchIf(self.Rx(rs1) != self.Rx(rs2), bimm);
         }
 
         auto Blt(Reg rs1, Reg rs2, u32 bimm) -> Item
@@ -59,10 +228,7 @@ namespace arviss
             // Signed.
             // pc <- pc + ((rs1 < rs2) ? imm_b : 4)
             auto& self = Self();
-            if (static_cast<i32>(self.Rx(rs1)) < static_cast<i32>(self.Rx(rs2)))
-            {
-                self.SetNextPc(self.Pc() + bimm);
-            }
+            BranchIf(static_cast<i32>(self.Rx(rs1)) < static_cast<i32>(self.Rx(rs2)), bimm);
         }
 
         auto Bge(Reg rs1, Reg rs2, u32 bimm) -> Item
@@ -70,10 +236,7 @@ namespace arviss
             // Signed.
             // pc <- pc + ((rs1 >= rs2) ? imm_b : 4)
             auto& self = Self();
-            if (static_cast<i32>(self.Rx(rs1)) >= static_cast<i32>(self.Rx(rs2)))
-            {
-                self.SetNextPc(self.Pc() + bimm);
-            }
+            BranchIf(static_cast<i32>(self.Rx(rs1)) >= static_cast<i32>(self.Rx(rs2)), bimm);
         }
 
         auto Bltu(Reg rs1, Reg rs2, u32 bimm) -> Item
@@ -81,10 +244,7 @@ namespace arviss
             // Unsigned.
             // pc <- pc + ((rs1 < rs2) ? imm_b : 4)
             auto& self = Self();
-            if (self.Rx(rs1) < self.Rx(rs2))
-            {
-                self.SetNextPc(self.Pc() + bimm);
-            }
+            BranchIf(self.Rx(rs1) < self.Rx(rs2), bimm);
         }
 
         auto Bgeu(Reg rs1, Reg rs2, u32 bimm) -> Item
@@ -92,10 +252,7 @@ namespace arviss
             // Unsigned.
             // pc <- pc + ((rs1 >= rs2) ? imm_b : 4)
             auto& self = Self();
-            if (self.Rx(rs1) >= self.Rx(rs2))
-            {
-                self.SetNextPc(self.Pc() + bimm);
-            }
+            BranchIf(self.Rx(rs1) >= self.Rx(rs2), bimm);
         }
 
         // I-type instructions.
@@ -105,8 +262,10 @@ namespace arviss
             // rd <- sx(m8(rs1 + imm_i)), pc += 4
             auto& self = Self();
             const auto address = self.Rx(rs1) + iimm;
-            const auto byte = self.Read8(address);
-            self.Wx(rd, static_cast<u32>(SExt(byte)));
+            if (const auto byte = Load8(address))
+            {
+                self.Wx(rd, static_cast<u32>(SExt(*byte)));
+            }
         }
 
         auto Lh(Reg rd, Reg rs1, u32 iimm) -> Item
@@ -114,8 +273,10 @@ namespace arviss
             // rd <- sx(m16(rs1 + imm_i)), pc += 4
             auto& self = Self();
             const auto address = self.Rx(rs1) + iimm;
-            const auto halfWord = self.Read16(address);
-            self.Wx(rd, static_cast<u32>(SExt(halfWord)));
+            if (const auto halfWord = Load16(address))
+            {
+                self.Wx(rd, static_cast<u32>(SExt(*halfWord)));
+            }
         }
 
         auto Lw(Reg rd, Reg rs1, u32 iimm) -> Item
@@ -123,8 +284,10 @@ namespace arviss
             // rd <- sx(m32(rs1 + imm_i)), pc += 4
             auto& self = Self();
             const auto address = self.Rx(rs1) + iimm;
-            const auto word = self.Read32(address);
-            self.Wx(rd, word);
+            if (const auto word = Load32(address))
+            {
+                self.Wx(rd, *word);
+            }
         }
 
         auto Lbu(Reg rd, Reg rs1, u32 iimm) -> Item
@@ -132,8 +295,10 @@ namespace arviss
             // rd <- zx(m8(rs1 + imm_i)), pc += 4
             auto& self = Self();
             const auto address = self.Rx(rs1) + iimm;
-            const auto byte = self.Read8(address);
-            self.Wx(rd, static_cast<u32>(byte));
+            if (const auto byte = Load8(address))
+            {
+                self.Wx(rd, static_cast<u32>(*byte));
+            }
         }
 
         auto Lhu(Reg rd, Reg rs1, u32 iimm) -> Item
@@ -141,8 +306,10 @@ namespace arviss
             // rd <- zx(m16(rs1 + imm_i)), pc += 4
             auto& self = Self();
             const auto address = self.Rx(rs1) + iimm;
-            const auto halfWord = self.Read16(address);
-            self.Wx(rd, static_cast<u32>(halfWord));
+            if (const auto halfWord = Load16(address))
+            {
+                self.Wx(rd, static_cast<u32>(*halfWord));
+            }
         }
 
         auto Addi(Reg rd, Reg rs1, u32 iimm) -> Item
@@ -206,7 +373,7 @@ namespace arviss
             // m8(rs1 + imm_s) <- rs2[7:0], pc += 4
             auto& self = Self();
             const auto address = self.Rx(rs1) + simm;
-            self.Write8(address, self.Rx(rs2) & 0xff);
+            Store8(address, self.Rx(rs2) & 0xff);
         }
 
         auto Sh(Reg rs1, Reg rs2, u32 simm) -> Item
@@ -214,7 +381,7 @@ namespace arviss
             // m16(rs1 + imm_s) <- rs2[15:0], pc += 4
             auto& self = Self();
             const auto address = self.Rx(rs1) + simm;
-            self.Write16(address, self.Rx(rs2) & 0xffff);
+            Store16(address, self.Rx(rs2) & 0xffff);
         }
 
         auto Sw(Reg rs1, Reg rs2, u32 simm) -> Item
@@ -222,7 +389,7 @@ namespace arviss
             // m32(rs1 + imm_s) <- rs2[31:0], pc += 4
             auto& self = Self();
             const auto address = self.Rx(rs1) + simm;
-            self.Write32(address, self.Rx(rs2));
+            Store32(address, self.Rx(rs2));
         }
 
         // U-type instructions.
@@ -358,25 +525,23 @@ namespace arviss
 
         auto Ecall() -> Item
         {
-            auto& self = Self();
-            self.RaiseTrap(TrapType::EnvironmentCallFromMMode);
+            RaiseTrap(TrapType::EnvironmentCallFromMMode);
         }
 
         auto Ebreak() -> Item
         {
-            auto& self = Self();
-            self.RaiseTrap(TrapType::Breakpoint);
+            RaiseTrap(TrapType::Breakpoint);
         }
     };
 
     // An Rv32im instruction handler that executes instructions on an integer core. BYO core.
-    template<IsIntegerCore T>
-    class Rv32imExecutor : public Rv32iExecutor<T>
+    template<IsIntegerCore T, IsExecutionHooks Hooks = NoHooks>
+    class Rv32imExecutor : public Rv32iExecutor<T, Hooks>
     {
         auto Self() -> T& { return static_cast<T&>(*this); }
 
     public:
-        using Item = typename Rv32iExecutor<T>::Item;
+        using Item = typename Rv32iExecutor<T, Hooks>::Item;
 
         auto Mul(Reg rd, Reg rs1, Reg rs2) -> Item
         {
@@ -464,13 +629,13 @@ namespace arviss
     };
 
     // An Rv32ic instruction handler that executes instructions on an integer core. BYO core.
-    template<IsIntegerCore T>
-    class Rv32icExecutor : public Rv32iExecutor<T>
+    template<IsIntegerCore T, IsExecutionHooks Hooks = NoHooks>
+    class Rv32icExecutor : public Rv32iExecutor<T, Hooks>
     {
         auto Self() -> T& { return static_cast<T&>(*this); }
 
     public:
-        using Item = typename Rv32iExecutor<T>::Item;
+        using Item = typename Rv32iExecutor<T, Hooks>::Item;
 
         auto C_ebreak() -> Item { this->Ebreak(); }
 
@@ -638,13 +803,13 @@ namespace arviss
     };
 
     // An Rv32imf instruction handler that executes instructions on a floating point core. BYO core.
-    template<IsFloatCore T>
-    class Rv32imfExecutor : public Rv32imExecutor<T>
+    template<IsFloatCore T, IsExecutionHooks Hooks = NoHooks>
+    class Rv32imfExecutor : public Rv32imExecutor<T, Hooks>
     {
         auto Self() -> T& { return static_cast<T&>(*this); }
 
     public:
-        using Item = typename Rv32imExecutor<T>::Item;
+        using Item = typename Rv32imExecutor<T, Hooks>::Item;
 
         auto Fmv_x_w(Reg rd, Reg rs1) -> Item
         {
@@ -877,8 +1042,10 @@ namespace arviss
             // rd <- f32(rs1 + imm_i)
             auto& self = Self();
             const auto address = self.Rx(rs1) + imm;
-            const auto word = self.Read32(address);
-            self.Wf(rd, std::bit_cast<f32>(word));
+            if (const auto word = this->Load32(address))
+            {
+                self.Wf(rd, std::bit_cast<f32>(*word));
+            }
         }
 
         auto Fsw(Reg rs1, Reg rs2, u32 imm) -> Item
@@ -887,7 +1054,7 @@ namespace arviss
             auto& self = Self();
             const auto data = std::bit_cast<u32>(self.Rf(rs2));
             const auto address = self.Rx(rs1) + imm;
-            self.Write32(address, data);
+            this->Store32(address, data);
         }
 
         auto Fmadd_s(Reg rd, Reg rs1, Reg rs2, Reg rs3, [[maybe_unused]] u32 rm) -> Item
@@ -3,6 +3,7 @@
 #include "arviss/arviss.h"
 #include "arviss/rv32/dispatchers.h"
 #include "arviss/rv32/executors.h"
+#include "arviss/rv32/table_dispatchers.h"
 
 namespace arviss
 {
@@ -16,10 +17,26 @@ namespace arviss
 
     // An RV32ic CPU implementation for an IntegerCore. BYO memory.
     template<HasMemory Mem>
-    using Rv32icCpu = Rv32icDispatcher<Rv32icExecutor<IntegerCore<Mem>>>;
+    using Rv32icCpu = Rv32icDispatcher<Rv32icExecutor<IntegerCore<Mem, true>>>;
 
     // An RV32imf CPU implementation for a FloatCore. BYO memory.
     template<HasMemory Mem>
     using Rv32imfCpu = Rv32imfDispatcher<Rv32imfExecutor<FloatCore<Mem>>>;
 
+    // As Rv32iCpu, but it decodes instructions with table lookups rather than nested switches.
+    template<HasMemory Mem>
+    using Rv32iTableCpu = Rv32iTableDispatcher<Rv32iExecutor<IntegerCore<Mem>>>;
+
+    // As Rv32imCpu, but it decodes instructions with table lookups rather than nested switches.
+    template<HasMemory Mem>
+    using Rv32imTableCpu = Rv32imTableDispatcher<Rv32imExecutor<IntegerCore<Mem>>>;
+
+    // As Rv32icCpu, but it decodes instructions with table lookups rather than nested switches.
+    template<HasMemory Mem>
+    using Rv32icTableCpu = Rv32icTableDispatcher<Rv32icExecutor<IntegerCore<Mem, true>>>;
+
+    // As Rv32imfCpu, but it decodes instructions with table lookups rather than nested switches.
+    template<HasMemory Mem>
+    using Rv32imfTableCpu = Rv32imfTableDispatcher<Rv32imfExecutor<FloatCore<Mem>>>;
+
 } // namespace arviss
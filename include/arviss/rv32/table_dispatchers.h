@@ -0,0 +1,1615 @@
+#pragma once
+
+#include "arviss/arviss.h"
+#include "arviss/rv32/concepts.h"
+#include "arviss/rv32/instruction.h"
+
+#include <array>
+
+namespace arviss
+{
+    namespace impl
+    {
+        // An entry in a first-level decode table, which is indexed by opcode[6:2] and funct3. It gives the start of the
+        // instruction's second-level table, and the one or two bit fields of the instruction that index into it.
+        struct DecodeNode
+        {
+            u16 base;
+            u16 mask1;
+            u16 mask2;
+            u8 shift1;
+            u8 width1;
+            u8 shift2;
+        };
+    } // namespace impl
+
+    // This code was generated by `tools/make_dispatcher.py --tables c++`. Do not edit.
+
+    namespace impl
+    {
+        // The decode tables for RV32I instructions.
+        // clang-format off
+        inline constexpr std::array<DecodeNode, 256> rv32iNodes{{
+            {1, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {2, 0x0, 0x0, 0, 0, 0},
+            {3, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {5, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {6, 0x1, 0x0, 30, 1, 0},
+            {8, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {9, 0x0, 0x0, 0, 0, 0},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {12, 0x1, 0x0, 20, 1, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {14, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {15, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {16, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {17, 0x0, 0x0, 0, 0, 0},
+            {8, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {18, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {19, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {20, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {21, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {22, 0x0, 0x0, 0, 0, 0},
+            {8, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {23, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {24, 0x0, 0x0, 0, 0, 0},
+            {8, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {25, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {26, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {27, 0x0, 0x0, 0, 0, 0},
+            {8, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {28, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {29, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {30, 0x1, 0x0, 30, 1, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {32, 0x1, 0x0, 30, 1, 0},
+            {8, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {34, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {35, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {36, 0x0, 0x0, 0, 0, 0},
+            {8, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {37, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {38, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {39, 0x0, 0x0, 0, 0, 0},
+            {8, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {40, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+        }};
+        inline constexpr std::array<u8, 41> rv32iOps{{
+            0, 27, 35, 11, 10, 32, 17, 18, 9, 1, 7, 8, 36, 37, 28, 38,
+            33, 19, 2, 29, 12, 34, 20, 13, 21, 30, 14, 22, 3, 31, 39, 40,
+            23, 24, 4, 15, 25, 5, 16, 26, 6,
+        }};
+        // clang-format on
+    } // namespace impl
+
+    // A table-driven dispatcher for RV32I instructions. BYO handler.
+    template<typename Handler>
+        requires IsRv32iHandler<Handler>
+    struct Rv32iTableDispatcher : public Handler
+    {
+        using Item = typename Handler::Item;
+
+        // Decodes the input word to an RV32I instruction with two table lookups and dispatches it to a handler.
+        // clang-format off
+        auto Dispatch(u32 code) -> Item
+        {
+            Handler& self = static_cast<Handler&>(*this);
+            Instruction c(code);
+
+            const auto& node = impl::rv32iNodes[((code >> 2) & 0x1f) | ((code >> 7) & 0xe0)];
+            switch (impl::rv32iOps[node.base + (((code >> node.shift1) & node.mask1) | (((code >> node.shift2) & node.mask2) << node.width1))]) {
+                case 1: return (code & 0x0000707f) == 0x00000063 ? self.Beq(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 2: return (code & 0x0000707f) == 0x00001063 ? self.Bne(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 3: return (code & 0x0000707f) == 0x00004063 ? self.Blt(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 4: return (code & 0x0000707f) == 0x00005063 ? self.Bge(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 5: return (code & 0x0000707f) == 0x00006063 ? self.Bltu(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 6: return (code & 0x0000707f) == 0x00007063 ? self.Bgeu(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 7: return (code & 0x0000707f) == 0x00000067 ? self.Jalr(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 8: return (code & 0x0000007f) == 0x0000006f ? self.Jal(c.Rd(), c.Jimmediate()) : self.Illegal(code);
+                case 9: return (code & 0x0000007f) == 0x00000037 ? self.Lui(c.Rd(), c.Uimmediate()) : self.Illegal(code);
+                case 10: return (code & 0x0000007f) == 0x00000017 ? self.Auipc(c.Rd(), c.Uimmediate()) : self.Illegal(code);
+                case 11: return (code & 0x0000707f) == 0x00000013 ? self.Addi(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 12: return (code & 0x0000707f) == 0x00002013 ? self.Slti(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 13: return (code & 0x0000707f) == 0x00003013 ? self.Sltiu(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 14: return (code & 0x0000707f) == 0x00004013 ? self.Xori(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 15: return (code & 0x0000707f) == 0x00006013 ? self.Ori(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 16: return (code & 0x0000707f) == 0x00007013 ? self.Andi(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 17: return (code & 0xfe00707f) == 0x00000033 ? self.Add(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 18: return (code & 0xfe00707f) == 0x40000033 ? self.Sub(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 19: return (code & 0xfe00707f) == 0x00001033 ? self.Sll(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 20: return (code & 0xfe00707f) == 0x00002033 ? self.Slt(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 21: return (code & 0xfe00707f) == 0x00003033 ? self.Sltu(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 22: return (code & 0xfe00707f) == 0x00004033 ? self.Xor(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 23: return (code & 0xfe00707f) == 0x00005033 ? self.Srl(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 24: return (code & 0xfe00707f) == 0x40005033 ? self.Sra(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 25: return (code & 0xfe00707f) == 0x00006033 ? self.Or(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 26: return (code & 0xfe00707f) == 0x00007033 ? self.And(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 27: return (code & 0x0000707f) == 0x00000003 ? self.Lb(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 28: return (code & 0x0000707f) == 0x00001003 ? self.Lh(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 29: return (code & 0x0000707f) == 0x00002003 ? self.Lw(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 30: return (code & 0x0000707f) == 0x00004003 ? self.Lbu(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 31: return (code & 0x0000707f) == 0x00005003 ? self.Lhu(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 32: return (code & 0x0000707f) == 0x00000023 ? self.Sb(c.Rs1(), c.Rs2(), c.Simmediate()) : self.Illegal(code);
+                case 33: return (code & 0x0000707f) == 0x00001023 ? self.Sh(c.Rs1(), c.Rs2(), c.Simmediate()) : self.Illegal(code);
+                case 34: return (code & 0x0000707f) == 0x00002023 ? self.Sw(c.Rs1(), c.Rs2(), c.Simmediate()) : self.Illegal(code);
+                case 35: return (code & 0x0000707f) == 0x0000000f ? self.Fence(c.Fm(), c.Rd(), c.Rs1()) : self.Illegal(code);
+                case 36: return (code & 0xffffffff) == 0x00000073 ? self.Ecall() : self.Illegal(code);
+                case 37: return (code & 0xffffffff) == 0x00100073 ? self.Ebreak() : self.Illegal(code);
+                case 38: return (code & 0xfe00707f) == 0x00001013 ? self.Slli(c.Rd(), c.Rs1(), c.Shamtw()) : self.Illegal(code);
+                case 39: return (code & 0xfe00707f) == 0x00005013 ? self.Srli(c.Rd(), c.Rs1(), c.Shamtw()) : self.Illegal(code);
+                case 40: return (code & 0xfe00707f) == 0x40005013 ? self.Srai(c.Rd(), c.Rs1(), c.Shamtw()) : self.Illegal(code);
+            }
+            return self.Illegal(code);
+        }
+        // clang-format on
+    };
+
+    // End of auto-generated code.
+
+    // This code was generated by `tools/make_dispatcher.py --tables -c c++`. Do not edit.
+
+    namespace impl
+    {
+        // The decode tables for RV32IC instructions.
+        // clang-format off
+        inline constexpr std::array<DecodeNode, 280> rv32icNodes{{
+            {1, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {2, 0x0, 0x0, 0, 0, 0},
+            {3, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {5, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {6, 0x1, 0x0, 30, 1, 0},
+            {8, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {9, 0x0, 0x0, 0, 0, 0},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {12, 0x1, 0x0, 20, 1, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {14, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {15, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {16, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {17, 0x0, 0x0, 0, 0, 0},
+            {8, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {18, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {19, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {20, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {21, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {22, 0x0, 0x0, 0, 0, 0},
+            {8, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {23, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {24, 0x0, 0x0, 0, 0, 0},
+            {8, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {25, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {26, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {27, 0x0, 0x0, 0, 0, 0},
+            {8, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {28, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {29, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {30, 0x1, 0x0, 30, 1, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {32, 0x1, 0x0, 30, 1, 0},
+            {8, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {34, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {35, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {36, 0x0, 0x0, 0, 0, 0},
+            {8, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {37, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {38, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {39, 0x0, 0x0, 0, 0, 0},
+            {8, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {40, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {41, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {42, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {43, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {44, 0x1f, 0x0, 7, 5, 0},
+            {76, 0x0, 0x0, 0, 0, 0},
+            {77, 0x0, 0x0, 0, 0, 0},
+            {78, 0x1f, 0x0, 7, 5, 0},
+            {110, 0x3, 0x3, 5, 2, 10},
+            {126, 0x0, 0x0, 0, 0, 0},
+            {127, 0x0, 0x0, 0, 0, 0},
+            {128, 0x0, 0x0, 0, 0, 0},
+            {129, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {130, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {131, 0x7ff, 0x0, 2, 11, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {2179, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+        }};
+        inline constexpr std::array<u8, 2180> rv32icOps{{
+            0, 27, 35, 11, 10, 32, 17, 18, 9, 1, 7, 8, 36, 37, 28, 38,
+            33, 19, 2, 29, 12, 34, 20, 13, 21, 30, 14, 22, 3, 31, 39, 40,
+            23, 24, 4, 15, 25, 5, 16, 26, 6, 41, 42, 43, 44, 45, 45, 45,
+            45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45,
+            45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 64, 46, 48, 48,
+            47, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+            48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 65, 65,
+            65, 65, 66, 66, 66, 66, 49, 49, 49, 49, 50, 51, 52, 53, 54, 55,
+            56, 67, 57, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59,
+            59, 59, 59, 60, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 61, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62, 62,
+            62, 62, 62, 63,
+        }};
+        // clang-format on
+    } // namespace impl
+
+    // A table-driven dispatcher for RV32IC instructions. BYO handler.
+    template<typename Handler>
+        requires IsRv32iHandler<Handler> && IsRv32cHandler<Handler>
+    struct Rv32icTableDispatcher : public Handler
+    {
+        using Item = typename Handler::Item;
+
+        // Decodes the input word to an RV32IC instruction with two table lookups and dispatches it to a handler.
+        // clang-format off
+        auto Dispatch(u32 code) -> Item
+        {
+            Handler& self = static_cast<Handler&>(*this);
+            Instruction c(code);
+
+            const auto& node = impl::rv32icNodes[(code & 3) == 3 ? ((code >> 2) & 0x1f) | ((code >> 7) & 0xe0) : 256 + (((code & 3) << 3) | ((code >> 13) & 7))];
+            switch (impl::rv32icOps[node.base + (((code >> node.shift1) & node.mask1) | (((code >> node.shift2) & node.mask2) << node.width1))]) {
+                case 1: return (code & 0x0000707f) == 0x00000063 ? self.Beq(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 2: return (code & 0x0000707f) == 0x00001063 ? self.Bne(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 3: return (code & 0x0000707f) == 0x00004063 ? self.Blt(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 4: return (code & 0x0000707f) == 0x00005063 ? self.Bge(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 5: return (code & 0x0000707f) == 0x00006063 ? self.Bltu(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 6: return (code & 0x0000707f) == 0x00007063 ? self.Bgeu(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 7: return (code & 0x0000707f) == 0x00000067 ? self.Jalr(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 8: return (code & 0x0000007f) == 0x0000006f ? self.Jal(c.Rd(), c.Jimmediate()) : self.Illegal(code);
+                case 9: return (code & 0x0000007f) == 0x00000037 ? self.Lui(c.Rd(), c.Uimmediate()) : self.Illegal(code);
+                case 10: return (code & 0x0000007f) == 0x00000017 ? self.Auipc(c.Rd(), c.Uimmediate()) : self.Illegal(code);
+                case 11: return (code & 0x0000707f) == 0x00000013 ? self.Addi(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 12: return (code & 0x0000707f) == 0x00002013 ? self.Slti(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 13: return (code & 0x0000707f) == 0x00003013 ? self.Sltiu(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 14: return (code & 0x0000707f) == 0x00004013 ? self.Xori(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 15: return (code & 0x0000707f) == 0x00006013 ? self.Ori(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 16: return (code & 0x0000707f) == 0x00007013 ? self.Andi(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 17: return (code & 0xfe00707f) == 0x00000033 ? self.Add(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 18: return (code & 0xfe00707f) == 0x40000033 ? self.Sub(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 19: return (code & 0xfe00707f) == 0x00001033 ? self.Sll(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 20: return (code & 0xfe00707f) == 0x00002033 ? self.Slt(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 21: return (code & 0xfe00707f) == 0x00003033 ? self.Sltu(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 22: return (code & 0xfe00707f) == 0x00004033 ? self.Xor(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 23: return (code & 0xfe00707f) == 0x00005033 ? self.Srl(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 24: return (code & 0xfe00707f) == 0x40005033 ? self.Sra(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 25: return (code & 0xfe00707f) == 0x00006033 ? self.Or(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 26: return (code & 0xfe00707f) == 0x00007033 ? self.And(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 27: return (code & 0x0000707f) == 0x00000003 ? self.Lb(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 28: return (code & 0x0000707f) == 0x00001003 ? self.Lh(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 29: return (code & 0x0000707f) == 0x00002003 ? self.Lw(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 30: return (code & 0x0000707f) == 0x00004003 ? self.Lbu(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 31: return (code & 0x0000707f) == 0x00005003 ? self.Lhu(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 32: return (code & 0x0000707f) == 0x00000023 ? self.Sb(c.Rs1(), c.Rs2(), c.Simmediate()) : self.Illegal(code);
+                case 33: return (code & 0x0000707f) == 0x00001023 ? self.Sh(c.Rs1(), c.Rs2(), c.Simmediate()) : self.Illegal(code);
+                case 34: return (code & 0x0000707f) == 0x00002023 ? self.Sw(c.Rs1(), c.Rs2(), c.Simmediate()) : self.Illegal(code);
+                case 35: return (code & 0x0000707f) == 0x0000000f ? self.Fence(c.Fm(), c.Rd(), c.Rs1()) : self.Illegal(code);
+                case 36: return (code & 0xffffffff) == 0x00000073 ? self.Ecall() : self.Illegal(code);
+                case 37: return (code & 0xffffffff) == 0x00100073 ? self.Ebreak() : self.Illegal(code);
+                case 38: return (code & 0xfe00707f) == 0x00001013 ? self.Slli(c.Rd(), c.Rs1(), c.Shamtw()) : self.Illegal(code);
+                case 39: return (code & 0xfe00707f) == 0x00005013 ? self.Srli(c.Rd(), c.Rs1(), c.Shamtw()) : self.Illegal(code);
+                case 40: return (code & 0xfe00707f) == 0x40005013 ? self.Srai(c.Rd(), c.Rs1(), c.Shamtw()) : self.Illegal(code);
+                case 41: return (code & 0xe003) == 0x0000 ? self.C_addi4spn(c.Rdp(), c.C_nzuimm10()) : self.Illegal(code);
+                case 42: return (code & 0xe003) == 0x4000 ? self.C_lw(c.Rdp(), c.Rs1p(), c.C_uimm7()) : self.Illegal(code);
+                case 43: return (code & 0xe003) == 0xc000 ? self.C_sw(c.Rs1p(), c.Rs2p(), c.C_uimm7()) : self.Illegal(code);
+                case 44: return (code & 0xef83) == 0x0001 ? self.C_nop(c.C_nzimm6()) : self.Illegal(code);
+                case 45: return (code & 0xe003) == 0x0001 ? self.C_addi(c.Rdrs1n0(), c.C_nzimm6()) : self.Illegal(code);
+                case 46: return (code & 0xe003) == 0x4001 ? self.C_li(c.Rd(), c.C_imm6()) : self.Illegal(code);
+                case 47: return (code & 0xef83) == 0x6101 ? self.C_addi16sp(c.C_nzimm10()) : self.Illegal(code);
+                case 48: return (code & 0xe003) == 0x6001 ? self.C_lui(c.Rdn2(), c.C_nzimm18()) : self.Illegal(code);
+                case 49: return (code & 0xec03) == 0x8801 ? self.C_andi(c.Rdrs1p(), c.C_imm6()) : self.Illegal(code);
+                case 50: return (code & 0xfc63) == 0x8c01 ? self.C_sub(c.Rdrs1p(), c.Rs2p()) : self.Illegal(code);
+                case 51: return (code & 0xfc63) == 0x8c21 ? self.C_xor(c.Rdrs1p(), c.Rs2p()) : self.Illegal(code);
+                case 52: return (code & 0xfc63) == 0x8c41 ? self.C_or(c.Rdrs1p(), c.Rs2p()) : self.Illegal(code);
+                case 53: return (code & 0xfc63) == 0x8c61 ? self.C_and(c.Rdrs1p(), c.Rs2p()) : self.Illegal(code);
+                case 54: return (code & 0xe003) == 0xa001 ? self.C_j(c.C_imm12()) : self.Illegal(code);
+                case 55: return (code & 0xe003) == 0xc001 ? self.C_beqz(c.Rs1p(), c.C_bimm9()) : self.Illegal(code);
+                case 56: return (code & 0xe003) == 0xe001 ? self.C_bnez(c.Rs1p(), c.C_bimm9()) : self.Illegal(code);
+                case 57: return (code & 0xe003) == 0x4002 ? self.C_lwsp(c.Rdn0(), c.C_uimm8sp()) : self.Illegal(code);
+                case 58: return (code & 0xf07f) == 0x8002 ? self.C_jr(c.Rs1n0()) : self.Illegal(code);
+                case 59: return (code & 0xf003) == 0x8002 ? self.C_mv(c.Rd(), c.Rs2n0()) : self.Illegal(code);
+                case 60: return (code & 0xffff) == 0x9002 ? self.C_ebreak() : self.Illegal(code);
+                case 61: return (code & 0xf07f) == 0x9002 ? self.C_jalr(c.Rs1n0()) : self.Illegal(code);
+                case 62: return (code & 0xf003) == 0x9002 ? self.C_add(c.Rdrs1(), c.Rs2n0()) : self.Illegal(code);
+                case 63: return (code & 0xe003) == 0xc002 ? self.C_swsp(c.C_rs2(), c.C_uimm8sp_s()) : self.Illegal(code);
+                case 64: return (code & 0xe003) == 0x2001 ? self.C_jal(c.C_imm12()) : self.Illegal(code);
+                case 65: return (code & 0xec03) == 0x8001 ? self.C_srli(c.Rdrs1p(), c.C_nzuimm6()) : self.Illegal(code);
+                case 66: return (code & 0xec03) == 0x8401 ? self.C_srai(c.Rdrs1p(), c.C_nzuimm6()) : self.Illegal(code);
+                case 67: return (code & 0xe003) == 0x0002 ? self.C_slli(c.Rdrs1n0(), c.C_nzuimm6()) : self.Illegal(code);
+            }
+            return self.Illegal(code);
+        }
+        // clang-format on
+    };
+
+    // End of auto-generated code.
+
+    // This code was generated by `tools/make_dispatcher.py --tables -m c++`. Do not edit.
+
+    namespace impl
+    {
+        // The decode tables for RV32IM instructions.
+        // clang-format off
+        inline constexpr std::array<DecodeNode, 256> rv32imNodes{{
+            {1, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {2, 0x0, 0x0, 0, 0, 0},
+            {3, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {5, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {6, 0x1, 0x1, 25, 1, 30},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {12, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {13, 0x0, 0x0, 0, 0, 0},
+            {14, 0x1, 0x0, 20, 1, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {16, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {17, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {18, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {19, 0x1, 0x0, 25, 1, 0},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {21, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {13, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {22, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {23, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {24, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {25, 0x1, 0x0, 25, 1, 0},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {13, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {27, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {28, 0x1, 0x0, 25, 1, 0},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {13, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {30, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {31, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {32, 0x1, 0x0, 25, 1, 0},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {34, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {13, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {35, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {36, 0x1, 0x0, 30, 1, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {38, 0x1, 0x1, 25, 1, 30},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {42, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {13, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {43, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {44, 0x1, 0x0, 25, 1, 0},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {46, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {13, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {47, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {48, 0x1, 0x0, 25, 1, 0},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {50, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {13, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+        }};
+        inline constexpr std::array<u8, 51> rv32imOps{{
+            0, 27, 35, 11, 10, 32, 17, 41, 18, 0, 9, 1, 7, 8, 36, 37,
+            28, 38, 33, 19, 42, 2, 29, 12, 34, 20, 43, 13, 21, 44, 30, 14,
+            22, 45, 3, 31, 39, 40, 23, 46, 24, 0, 4, 15, 25, 47, 5, 16,
+            26, 48, 6,
+        }};
+        // clang-format on
+    } // namespace impl
+
+    // A table-driven dispatcher for RV32IM instructions. BYO handler.
+    template<typename Handler>
+        requires IsRv32iHandler<Handler> && IsRv32mHandler<Handler>
+    struct Rv32imTableDispatcher : public Handler
+    {
+        using Item = typename Handler::Item;
+
+        // Decodes the input word to an RV32IM instruction with two table lookups and dispatches it to a handler.
+        // clang-format off
+        auto Dispatch(u32 code) -> Item
+        {
+            Handler& self = static_cast<Handler&>(*this);
+            Instruction c(code);
+
+            const auto& node = impl::rv32imNodes[((code >> 2) & 0x1f) | ((code >> 7) & 0xe0)];
+            switch (impl::rv32imOps[node.base + (((code >> node.shift1) & node.mask1) | (((code >> node.shift2) & node.mask2) << node.width1))]) {
+                case 1: return (code & 0x0000707f) == 0x00000063 ? self.Beq(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 2: return (code & 0x0000707f) == 0x00001063 ? self.Bne(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 3: return (code & 0x0000707f) == 0x00004063 ? self.Blt(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 4: return (code & 0x0000707f) == 0x00005063 ? self.Bge(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 5: return (code & 0x0000707f) == 0x00006063 ? self.Bltu(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 6: return (code & 0x0000707f) == 0x00007063 ? self.Bgeu(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 7: return (code & 0x0000707f) == 0x00000067 ? self.Jalr(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 8: return (code & 0x0000007f) == 0x0000006f ? self.Jal(c.Rd(), c.Jimmediate()) : self.Illegal(code);
+                case 9: return (code & 0x0000007f) == 0x00000037 ? self.Lui(c.Rd(), c.Uimmediate()) : self.Illegal(code);
+                case 10: return (code & 0x0000007f) == 0x00000017 ? self.Auipc(c.Rd(), c.Uimmediate()) : self.Illegal(code);
+                case 11: return (code & 0x0000707f) == 0x00000013 ? self.Addi(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 12: return (code & 0x0000707f) == 0x00002013 ? self.Slti(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 13: return (code & 0x0000707f) == 0x00003013 ? self.Sltiu(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 14: return (code & 0x0000707f) == 0x00004013 ? self.Xori(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 15: return (code & 0x0000707f) == 0x00006013 ? self.Ori(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 16: return (code & 0x0000707f) == 0x00007013 ? self.Andi(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 17: return (code & 0xfe00707f) == 0x00000033 ? self.Add(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 18: return (code & 0xfe00707f) == 0x40000033 ? self.Sub(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 19: return (code & 0xfe00707f) == 0x00001033 ? self.Sll(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 20: return (code & 0xfe00707f) == 0x00002033 ? self.Slt(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 21: return (code & 0xfe00707f) == 0x00003033 ? self.Sltu(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 22: return (code & 0xfe00707f) == 0x00004033 ? self.Xor(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 23: return (code & 0xfe00707f) == 0x00005033 ? self.Srl(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 24: return (code & 0xfe00707f) == 0x40005033 ? self.Sra(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 25: return (code & 0xfe00707f) == 0x00006033 ? self.Or(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 26: return (code & 0xfe00707f) == 0x00007033 ? self.And(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 27: return (code & 0x0000707f) == 0x00000003 ? self.Lb(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 28: return (code & 0x0000707f) == 0x00001003 ? self.Lh(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 29: return (code & 0x0000707f) == 0x00002003 ? self.Lw(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 30: return (code & 0x0000707f) == 0x00004003 ? self.Lbu(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 31: return (code & 0x0000707f) == 0x00005003 ? self.Lhu(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 32: return (code & 0x0000707f) == 0x00000023 ? self.Sb(c.Rs1(), c.Rs2(), c.Simmediate()) : self.Illegal(code);
+                case 33: return (code & 0x0000707f) == 0x00001023 ? self.Sh(c.Rs1(), c.Rs2(), c.Simmediate()) : self.Illegal(code);
+                case 34: return (code & 0x0000707f) == 0x00002023 ? self.Sw(c.Rs1(), c.Rs2(), c.Simmediate()) : self.Illegal(code);
+                case 35: return (code & 0x0000707f) == 0x0000000f ? self.Fence(c.Fm(), c.Rd(), c.Rs1()) : self.Illegal(code);
+                case 36: return (code & 0xffffffff) == 0x00000073 ? self.Ecall() : self.Illegal(code);
+                case 37: return (code & 0xffffffff) == 0x00100073 ? self.Ebreak() : self.Illegal(code);
+                case 38: return (code & 0xfe00707f) == 0x00001013 ? self.Slli(c.Rd(), c.Rs1(), c.Shamtw()) : self.Illegal(code);
+                case 39: return (code & 0xfe00707f) == 0x00005013 ? self.Srli(c.Rd(), c.Rs1(), c.Shamtw()) : self.Illegal(code);
+                case 40: return (code & 0xfe00707f) == 0x40005013 ? self.Srai(c.Rd(), c.Rs1(), c.Shamtw()) : self.Illegal(code);
+                case 41: return (code & 0xfe00707f) == 0x02000033 ? self.Mul(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 42: return (code & 0xfe00707f) == 0x02001033 ? self.Mulh(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 43: return (code & 0xfe00707f) == 0x02002033 ? self.Mulhsu(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 44: return (code & 0xfe00707f) == 0x02003033 ? self.Mulhu(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 45: return (code & 0xfe00707f) == 0x02004033 ? self.Div(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 46: return (code & 0xfe00707f) == 0x02005033 ? self.Divu(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 47: return (code & 0xfe00707f) == 0x02006033 ? self.Rem(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 48: return (code & 0xfe00707f) == 0x02007033 ? self.Remu(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+            }
+            return self.Illegal(code);
+        }
+        // clang-format on
+    };
+
+    // End of auto-generated code.
+
+    // This code was generated by `tools/make_dispatcher.py --tables -m -f c++`. Do not edit.
+
+    namespace impl
+    {
+        // The decode tables for RV32IMF instructions.
+        // clang-format off
+        inline constexpr std::array<DecodeNode, 256> rv32imfNodes{{
+            {1, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {2, 0x0, 0x0, 0, 0, 0},
+            {3, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {5, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {6, 0x1, 0x1, 25, 1, 30},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {12, 0x0, 0x0, 0, 0, 0},
+            {13, 0x0, 0x0, 0, 0, 0},
+            {14, 0x0, 0x0, 0, 0, 0},
+            {15, 0x1, 0x1f, 20, 1, 27},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {79, 0x0, 0x0, 0, 0, 0},
+            {80, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {81, 0x0, 0x0, 0, 0, 0},
+            {82, 0x1, 0x0, 20, 1, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {84, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {85, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {86, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {87, 0x1, 0x0, 25, 1, 0},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {12, 0x0, 0x0, 0, 0, 0},
+            {13, 0x0, 0x0, 0, 0, 0},
+            {14, 0x0, 0x0, 0, 0, 0},
+            {89, 0x1, 0x1f, 20, 1, 27},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {153, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {81, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {154, 0x0, 0x0, 0, 0, 0},
+            {155, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {156, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {157, 0x0, 0x0, 0, 0, 0},
+            {158, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {159, 0x1, 0x0, 25, 1, 0},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {12, 0x0, 0x0, 0, 0, 0},
+            {13, 0x0, 0x0, 0, 0, 0},
+            {14, 0x0, 0x0, 0, 0, 0},
+            {161, 0x1, 0x1f, 20, 1, 27},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {81, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {225, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {226, 0x1, 0x0, 25, 1, 0},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {12, 0x0, 0x0, 0, 0, 0},
+            {13, 0x0, 0x0, 0, 0, 0},
+            {14, 0x0, 0x0, 0, 0, 0},
+            {228, 0x1, 0x1f, 20, 1, 27},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {81, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {292, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {293, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {294, 0x1, 0x0, 25, 1, 0},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {12, 0x0, 0x0, 0, 0, 0},
+            {13, 0x0, 0x0, 0, 0, 0},
+            {14, 0x0, 0x0, 0, 0, 0},
+            {228, 0x1, 0x1f, 20, 1, 27},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {296, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {81, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {297, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {298, 0x1, 0x0, 30, 1, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {300, 0x1, 0x1, 25, 1, 30},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {12, 0x0, 0x0, 0, 0, 0},
+            {13, 0x0, 0x0, 0, 0, 0},
+            {14, 0x0, 0x0, 0, 0, 0},
+            {228, 0x1, 0x1f, 20, 1, 27},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {304, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {81, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {305, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {306, 0x1, 0x0, 25, 1, 0},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {12, 0x0, 0x0, 0, 0, 0},
+            {13, 0x0, 0x0, 0, 0, 0},
+            {14, 0x0, 0x0, 0, 0, 0},
+            {228, 0x1, 0x1f, 20, 1, 27},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {308, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {81, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {309, 0x0, 0x0, 0, 0, 0},
+            {4, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {310, 0x1, 0x0, 25, 1, 0},
+            {10, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {11, 0x0, 0x0, 0, 0, 0},
+            {12, 0x0, 0x0, 0, 0, 0},
+            {13, 0x0, 0x0, 0, 0, 0},
+            {14, 0x0, 0x0, 0, 0, 0},
+            {228, 0x1, 0x1f, 20, 1, 27},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {312, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {81, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+            {0, 0x0, 0x0, 0, 0, 0},
+        }};
+        inline constexpr std::array<u8, 313> rv32imfOps{{
+            0, 27, 35, 11, 10, 32, 17, 41, 18, 0, 9, 71, 72, 73, 74, 49,
+            49, 50, 50, 51, 51, 52, 52, 53, 53, 56, 56, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 58, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 59, 59, 0, 0, 0, 0, 0, 0, 62,
+            63, 0, 0, 66, 67, 0, 0, 64, 0, 0, 0, 68, 0, 0, 0, 1,
+            7, 8, 36, 37, 28, 38, 33, 19, 42, 49, 49, 50, 50, 51, 51, 52,
+            52, 54, 54, 57, 57, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 58,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 60, 60, 0, 0, 0, 0, 0, 0, 62, 63, 0, 0, 66, 67, 0,
+            0, 65, 0, 0, 0, 0, 0, 0, 0, 2, 29, 69, 12, 34, 70, 20,
+            43, 49, 49, 50, 50, 51, 51, 52, 52, 55, 55, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 58, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 61, 61, 0, 0, 0, 0, 0,
+            0, 62, 63, 0, 0, 66, 67, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 13, 21, 44, 49, 49, 50, 50, 51, 51, 52, 52, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 58, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 62, 63, 0, 0, 66, 67, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, 0, 30, 14, 22, 45, 3, 31, 39, 40, 23, 46, 24, 0,
+            4, 15, 25, 47, 5, 16, 26, 48, 6,
+        }};
+        // clang-format on
+    } // namespace impl
+
+    // A table-driven dispatcher for RV32IMF instructions. BYO handler.
+    template<typename Handler>
+        requires IsRv32iHandler<Handler> && IsRv32mHandler<Handler> && IsRv32fHandler<Handler>
+    struct Rv32imfTableDispatcher : public Handler
+    {
+        using Item = typename Handler::Item;
+
+        // Decodes the input word to an RV32IMF instruction with two table lookups and dispatches it to a handler.
+        // clang-format off
+        auto Dispatch(u32 code) -> Item
+        {
+            Handler& self = static_cast<Handler&>(*this);
+            Instruction c(code);
+
+            const auto& node = impl::rv32imfNodes[((code >> 2) & 0x1f) | ((code >> 7) & 0xe0)];
+            switch (impl::rv32imfOps[node.base + (((code >> node.shift1) & node.mask1) | (((code >> node.shift2) & node.mask2) << node.width1))]) {
+                case 1: return (code & 0x0000707f) == 0x00000063 ? self.Beq(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 2: return (code & 0x0000707f) == 0x00001063 ? self.Bne(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 3: return (code & 0x0000707f) == 0x00004063 ? self.Blt(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 4: return (code & 0x0000707f) == 0x00005063 ? self.Bge(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 5: return (code & 0x0000707f) == 0x00006063 ? self.Bltu(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 6: return (code & 0x0000707f) == 0x00007063 ? self.Bgeu(c.Rs1(), c.Rs2(), c.Bimmediate()) : self.Illegal(code);
+                case 7: return (code & 0x0000707f) == 0x00000067 ? self.Jalr(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 8: return (code & 0x0000007f) == 0x0000006f ? self.Jal(c.Rd(), c.Jimmediate()) : self.Illegal(code);
+                case 9: return (code & 0x0000007f) == 0x00000037 ? self.Lui(c.Rd(), c.Uimmediate()) : self.Illegal(code);
+                case 10: return (code & 0x0000007f) == 0x00000017 ? self.Auipc(c.Rd(), c.Uimmediate()) : self.Illegal(code);
+                case 11: return (code & 0x0000707f) == 0x00000013 ? self.Addi(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 12: return (code & 0x0000707f) == 0x00002013 ? self.Slti(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 13: return (code & 0x0000707f) == 0x00003013 ? self.Sltiu(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 14: return (code & 0x0000707f) == 0x00004013 ? self.Xori(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 15: return (code & 0x0000707f) == 0x00006013 ? self.Ori(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 16: return (code & 0x0000707f) == 0x00007013 ? self.Andi(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 17: return (code & 0xfe00707f) == 0x00000033 ? self.Add(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 18: return (code & 0xfe00707f) == 0x40000033 ? self.Sub(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 19: return (code & 0xfe00707f) == 0x00001033 ? self.Sll(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 20: return (code & 0xfe00707f) == 0x00002033 ? self.Slt(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 21: return (code & 0xfe00707f) == 0x00003033 ? self.Sltu(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 22: return (code & 0xfe00707f) == 0x00004033 ? self.Xor(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 23: return (code & 0xfe00707f) == 0x00005033 ? self.Srl(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 24: return (code & 0xfe00707f) == 0x40005033 ? self.Sra(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 25: return (code & 0xfe00707f) == 0x00006033 ? self.Or(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 26: return (code & 0xfe00707f) == 0x00007033 ? self.And(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 27: return (code & 0x0000707f) == 0x00000003 ? self.Lb(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 28: return (code & 0x0000707f) == 0x00001003 ? self.Lh(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 29: return (code & 0x0000707f) == 0x00002003 ? self.Lw(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 30: return (code & 0x0000707f) == 0x00004003 ? self.Lbu(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 31: return (code & 0x0000707f) == 0x00005003 ? self.Lhu(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 32: return (code & 0x0000707f) == 0x00000023 ? self.Sb(c.Rs1(), c.Rs2(), c.Simmediate()) : self.Illegal(code);
+                case 33: return (code & 0x0000707f) == 0x00001023 ? self.Sh(c.Rs1(), c.Rs2(), c.Simmediate()) : self.Illegal(code);
+                case 34: return (code & 0x0000707f) == 0x00002023 ? self.Sw(c.Rs1(), c.Rs2(), c.Simmediate()) : self.Illegal(code);
+                case 35: return (code & 0x0000707f) == 0x0000000f ? self.Fence(c.Fm(), c.Rd(), c.Rs1()) : self.Illegal(code);
+                case 36: return (code & 0xffffffff) == 0x00000073 ? self.Ecall() : self.Illegal(code);
+                case 37: return (code & 0xffffffff) == 0x00100073 ? self.Ebreak() : self.Illegal(code);
+                case 38: return (code & 0xfe00707f) == 0x00001013 ? self.Slli(c.Rd(), c.Rs1(), c.Shamtw()) : self.Illegal(code);
+                case 39: return (code & 0xfe00707f) == 0x00005013 ? self.Srli(c.Rd(), c.Rs1(), c.Shamtw()) : self.Illegal(code);
+                case 40: return (code & 0xfe00707f) == 0x40005013 ? self.Srai(c.Rd(), c.Rs1(), c.Shamtw()) : self.Illegal(code);
+                case 41: return (code & 0xfe00707f) == 0x02000033 ? self.Mul(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 42: return (code & 0xfe00707f) == 0x02001033 ? self.Mulh(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 43: return (code & 0xfe00707f) == 0x02002033 ? self.Mulhsu(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 44: return (code & 0xfe00707f) == 0x02003033 ? self.Mulhu(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 45: return (code & 0xfe00707f) == 0x02004033 ? self.Div(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 46: return (code & 0xfe00707f) == 0x02005033 ? self.Divu(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 47: return (code & 0xfe00707f) == 0x02006033 ? self.Rem(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 48: return (code & 0xfe00707f) == 0x02007033 ? self.Remu(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 49: return (code & 0xfe00007f) == 0x00000053 ? self.Fadd_s(c.Rd(), c.Rs1(), c.Rs2(), c.Rm()) : self.Illegal(code);
+                case 50: return (code & 0xfe00007f) == 0x08000053 ? self.Fsub_s(c.Rd(), c.Rs1(), c.Rs2(), c.Rm()) : self.Illegal(code);
+                case 51: return (code & 0xfe00007f) == 0x10000053 ? self.Fmul_s(c.Rd(), c.Rs1(), c.Rs2(), c.Rm()) : self.Illegal(code);
+                case 52: return (code & 0xfe00007f) == 0x18000053 ? self.Fdiv_s(c.Rd(), c.Rs1(), c.Rs2(), c.Rm()) : self.Illegal(code);
+                case 53: return (code & 0xfe00707f) == 0x20000053 ? self.Fsgnj_s(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 54: return (code & 0xfe00707f) == 0x20001053 ? self.Fsgnjn_s(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 55: return (code & 0xfe00707f) == 0x20002053 ? self.Fsgnjx_s(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 56: return (code & 0xfe00707f) == 0x28000053 ? self.Fmin_s(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 57: return (code & 0xfe00707f) == 0x28001053 ? self.Fmax_s(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 58: return (code & 0xfff0007f) == 0x58000053 ? self.Fsqrt_s(c.Rd(), c.Rs1(), c.Rm()) : self.Illegal(code);
+                case 59: return (code & 0xfe00707f) == 0xa0000053 ? self.Fle_s(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 60: return (code & 0xfe00707f) == 0xa0001053 ? self.Flt_s(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 61: return (code & 0xfe00707f) == 0xa0002053 ? self.Feq_s(c.Rd(), c.Rs1(), c.Rs2()) : self.Illegal(code);
+                case 62: return (code & 0xfff0007f) == 0xc0000053 ? self.Fcvt_w_s(c.Rd(), c.Rs1(), c.Rm()) : self.Illegal(code);
+                case 63: return (code & 0xfff0007f) == 0xc0100053 ? self.Fcvt_wu_s(c.Rd(), c.Rs1(), c.Rm()) : self.Illegal(code);
+                case 64: return (code & 0xfff0707f) == 0xe0000053 ? self.Fmv_x_w(c.Rd(), c.Rs1()) : self.Illegal(code);
+                case 65: return (code & 0xfff0707f) == 0xe0001053 ? self.Fclass_s(c.Rd(), c.Rs1()) : self.Illegal(code);
+                case 66: return (code & 0xfff0007f) == 0xd0000053 ? self.Fcvt_s_w(c.Rd(), c.Rs1(), c.Rm()) : self.Illegal(code);
+                case 67: return (code & 0xfff0007f) == 0xd0100053 ? self.Fcvt_s_wu(c.Rd(), c.Rs1(), c.Rm()) : self.Illegal(code);
+                case 68: return (code & 0xfff0707f) == 0xf0000053 ? self.Fmv_w_x(c.Rd(), c.Rs1()) : self.Illegal(code);
+                case 69: return (code & 0x0000707f) == 0x00002007 ? self.Flw(c.Rd(), c.Rs1(), c.Iimmediate()) : self.Illegal(code);
+                case 70: return (code & 0x0000707f) == 0x00002027 ? self.Fsw(c.Rs1(), c.Rs2(), c.Simmediate()) : self.Illegal(code);
+                case 71: return (code & 0x0600007f) == 0x00000043 ? self.Fmadd_s(c.Rd(), c.Rs1(), c.Rs2(), c.Rs3(), c.Rm()) : self.Illegal(code);
+                case 72: return (code & 0x0600007f) == 0x00000047 ? self.Fmsub_s(c.Rd(), c.Rs1(), c.Rs2(), c.Rs3(), c.Rm()) : self.Illegal(code);
+                case 73: return (code & 0x0600007f) == 0x0000004b ? self.Fnmsub_s(c.Rd(), c.Rs1(), c.Rs2(), c.Rs3(), c.Rm()) : self.Illegal(code);
+                case 74: return (code & 0x0600007f) == 0x0000004f ? self.Fnmadd_s(c.Rd(), c.Rs1(), c.Rs2(), c.Rs3(), c.Rm()) : self.Illegal(code);
+            }
+            return self.Illegal(code);
+        }
+        // clang-format on
+    };
+
+    // End of auto-generated code.
+
+} // namespace arviss
@@ -0,0 +1,448 @@
+#pragma once
+
+#include "arviss/arviss.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace arviss::sched
+{
+    namespace impl
+    {
+        template<typename T>
+        struct IsIntegerCoreType : std::false_type
+        {
+        };
+
+        template<HasMemory Mem, bool compact>
+        struct IsIntegerCoreType<IntegerCore<Mem, compact>> : std::true_type
+        {
+        };
+
+        template<typename T>
+        struct ClassOf;
+
+        template<typename C, typename R, typename... Args>
+        struct ClassOf<R (C::*)(Args...)>
+        {
+            using type = C;
+        };
+
+        // T is a dispatcher with a run loop of its own, such as the threaded Remix dispatcher or the block cache. The
+        // one that it inherits from IntegerCore doesn't count, because IntegerCore has no Dispatch() for it to call.
+        template<typename T>
+        concept HasOwnRunLoop = requires(T t, size_t count) {
+            {
+                t.Run(count)
+            } -> std::same_as<void>;
+        } && !IsIntegerCoreType<typename ClassOf<decltype(&T::Run)>::type>::value;
+
+        // T is a dispatcher whose run loop says how many instructions it executed.
+        template<typename T>
+        concept HasCountedRunLoop = requires(T t, size_t count, size_t executed) {
+            executed = t.RunCounted(count); // Runs for up to `count` instructions and returns how many it executed.
+        };
+
+        // T recovers from faults in guest memory accesses itself, e.g., flat::Memory, so it has to be run inside its
+        // Guarded(), which returns false if it had to abandon the run.
+        template<typename T>
+        concept HasGuardedAccess = requires(T t, void (*run)()) {
+            {
+                t.Guarded(t, run)
+            } -> std::same_as<bool>;
+        };
+
+        // Returns true if `cpu` should stop. A core with stop events checks for traps and stop requests in one go.
+        template<typename Cpu>
+        auto IsStopping(Cpu& cpu) -> bool
+        {
+            if constexpr (HasStopEvents<Cpu>)
+            {
+                return cpu.Events() != 0;
+            }
+            else
+            {
+                return cpu.IsTrapped();
+            }
+        }
+    } // namespace impl
+
+    // T is a CPU that the scheduler can run.
+    template<typename T>
+    concept IsSchedulable = IsIntegerCore<T> && IsDispatcher<T>;
+
+    // Why RunUntilStopped() stopped.
+    enum class StopReason
+    {
+        BudgetExhausted, // It executed all of the instructions that it was allowed to.
+        Trapped,         // The CPU trapped.
+        Requested,       // Something called RequestStop() on the CPU, and it stopped before its budget ran out.
+    };
+
+    // What RunUntilStopped() hands back.
+    struct RunResult
+    {
+        size_t retired;                // The number of instructions charged, as for RunFor().
+        StopReason reason;             // Why it stopped.
+        std::optional<TrapState> trap; // The trap that stopped it, if any.
+    };
+
+    // Runs `cpu` for up to `count` instructions, stopping early if it traps or, if it has stop events, if it's asked to
+    // stop, e.g., by another thread. A TrappedException thrown by its memory is raised on `cpu` as a trap, and so is a
+    // fault in a memory that guards its own accesses. Any stop request is cleared before it returns, and the reason is
+    // only Requested if the run stopped before using up `count`. The number of instructions retired is exact unless the
+    // CPU has a run loop of its own that doesn't count them, or its memory throws or faults part way through, in which
+    // case it's all of `count`, so such a CPU never reports Requested.
+    template<IsSchedulable Cpu>
+    auto RunUntilStopped(Cpu& cpu, size_t count) -> RunResult
+    {
+        size_t executed = 0;
+        auto run = [&] {
+            try
+            {
+                if constexpr (impl::HasCountedRunLoop<Cpu>)
+                {
+                    executed = count;
+                    executed = cpu.RunCounted(count);
+                }
+                else if constexpr (impl::HasOwnRunLoop<Cpu>)
+                {
+                    executed = count;
+                    cpu.Run(count);
+                }
+                else
+                {
+                    while (executed < count && !impl::IsStopping(cpu))
+                    {
+                        auto ins = cpu.Fetch(); // Fetch.
+                        cpu.Dispatch(ins);      // Execute.
+                        ++executed;
+                    }
+                }
+            }
+            catch (const TrappedException& e)
+            {
+                cpu.RaiseTrap(e.Reason(), e.Context());
+            }
+        };
+
+        if constexpr (impl::HasGuardedAccess<Cpu>)
+        {
+            if (!cpu.Guarded(cpu, run))
+            {
+                executed = count;
+            }
+        }
+        else
+        {
+            run();
+        }
+
+        // The request is cleared even if it came too late to stop this run, so that it doesn't stop the next one.
+        bool isStopRequested = false;
+        if constexpr (HasStopEvents<Cpu>)
+        {
+            isStopRequested = cpu.TakeStopRequest();
+        }
+        if (cpu.IsTrapped())
+        {
+            return {.retired = executed, .reason = StopReason::Trapped, .trap = cpu.TrapCause()};
+        }
+        if (isStopRequested && executed < count)
+        {
+            return {.retired = executed, .reason = StopReason::Requested, .trap = {}};
+        }
+        return {.retired = executed, .reason = StopReason::BudgetExhausted, .trap = {}};
+    }
+
+    // Runs `cpu` for up to `count` instructions, as RunUntilStopped() does, and returns the number of instructions
+    // charged.
+    template<IsSchedulable Cpu>
+    auto RunFor(Cpu& cpu, size_t count) -> size_t
+    {
+        return RunUntilStopped(cpu, count).retired;
+    }
+
+    using JobId = u64;
+
+    // What the scheduler hands back when a CPU stops, either because it trapped, because it used up its budget, or
+    // because something other than a trap was thrown while it was running.
+    template<typename Cpu>
+    struct Completion
+    {
+        JobId id;                      // The id returned by Submit().
+        std::unique_ptr<Cpu> cpu;      // The CPU, in the state that it stopped in.
+        std::optional<TrapState> trap; // The trap that stopped it, if any.
+        size_t executed;               // The number of instructions charged against its budget.
+        std::exception_ptr error;      // Anything else that was thrown while it was running.
+    };
+
+    // Runs a batch of CPUs on a pool of worker threads. Each CPU runs for a quantum of instructions at a time, then goes
+    // back on its worker's queue so that the other CPUs on that worker get a turn. Idle workers steal from the others'
+    // queues. CPUs that trap or exhaust their budget are handed back through a completion queue.
+    template<IsSchedulable Cpu>
+    class Scheduler
+    {
+        struct Job
+        {
+            JobId id;
+            std::unique_ptr<Cpu> cpu;
+            size_t budget;
+            size_t executed;
+        };
+
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<std::unique_ptr<Job>> jobs;
+            Cpu* running{}; // The CPU that the worker is running, if any, so that Preempt() can stop it.
+        };
+
+        size_t quantum_;
+        std::vector<std::unique_ptr<Worker>> workers_{};
+        std::vector<std::thread> threads_{};
+        std::atomic<size_t> queued_{}; // The number of jobs waiting on workers' queues.
+        std::atomic<size_t> nextWorker_{};
+
+        std::mutex mutex_{}; // Guards everything below.
+        std::condition_variable workAvailable_{};
+        std::condition_variable completed_{};
+        std::deque<Completion<Cpu>> completions_{};
+        size_t outstanding_{}; // Jobs that have been submitted but not yet collected.
+        JobId nextId_{};
+        std::atomic<bool> stopping_{}; // Also read by workers between quanta without the lock.
+
+        // Takes the job at the back of worker `index`'s own queue. Workers take their own jobs in turn.
+        auto Pop(size_t index) -> std::unique_ptr<Job>
+        {
+            auto& w = *workers_[index];
+            std::lock_guard lock(w.mutex);
+            if (w.jobs.empty())
+            {
+                return nullptr;
+            }
+            auto job = std::move(w.jobs.back());
+            w.jobs.pop_back();
+            --queued_;
+            return job;
+        }
+
+        // Takes the job at the front of another worker's queue.
+        auto Steal(size_t index) -> std::unique_ptr<Job>
+        {
+            for (size_t i = 1; i < workers_.size(); i++)
+            {
+                auto& w = *workers_[(index + i) % workers_.size()];
+                std::lock_guard lock(w.mutex);
+                if (!w.jobs.empty())
+                {
+                    auto job = std::move(w.jobs.front());
+                    w.jobs.pop_front();
+                    --queued_;
+                    return job;
+                }
+            }
+            return nullptr;
+        }
+
+        // Puts `job` at the front of worker `index`'s queue, so that it runs after the jobs that are already there. Wakes an
+        // idle worker if there's now more than one job for it to steal. Like Pop() and Steal(), it updates queued_ while
+        // it holds the queue's lock, so that the count can't drop below zero when another worker takes the job first.
+        auto Push(size_t index, std::unique_ptr<Job> job) -> void
+        {
+            auto& w = *workers_[index];
+            bool surplus;
+            {
+                std::lock_guard lock(w.mutex);
+                w.jobs.push_front(std::move(job));
+                ++queued_;
+                surplus = w.jobs.size() > 1;
+            }
+            if (surplus)
+            {
+                {
+                    // Taking the lock means that a worker can't miss the wakeup between checking for work and waiting.
+                    std::lock_guard lock(mutex_);
+                }
+                workAvailable_.notify_one();
+            }
+        }
+
+        auto Complete(std::unique_ptr<Job> job, std::exception_ptr error) -> void
+        {
+            auto trap = job->cpu->TrapCause();
+            {
+                std::lock_guard lock(mutex_);
+                completions_.push_back({.id = job->id, .cpu = std::move(job->cpu), .trap = trap, .executed = job->executed, .error = error});
+            }
+            completed_.notify_all();
+        }
+
+        // Takes the oldest completion. The caller must hold mutex_.
+        auto TakeCompletion() -> std::optional<Completion<Cpu>>
+        {
+            if (completions_.empty())
+            {
+                return std::nullopt;
+            }
+            auto c = std::move(completions_.front());
+            completions_.pop_front();
+            --outstanding_;
+            return c;
+        }
+
+        auto Work(size_t index) -> void
+        {
+            for (;;)
+            {
+                auto job = Pop(index);
+                if (!job)
+                {
+                    job = Steal(index);
+                }
+                if (!job)
+                {
+                    std::unique_lock lock(mutex_);
+                    workAvailable_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+                    if (stopping_)
+                    {
+                        return;
+                    }
+                    continue;
+                }
+
+                auto& w = *workers_[index];
+                {
+                    std::lock_guard lock(w.mutex);
+                    w.running = job->cpu.get();
+                }
+                std::exception_ptr error{};
+                try
+                {
+                    job->executed += RunFor(*job->cpu, std::min(quantum_, job->budget - job->executed));
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+                {
+                    // Once this is cleared, Preempt() can't touch the CPU, so it's safe to hand it back.
+                    std::lock_guard lock(w.mutex);
+                    w.running = nullptr;
+                }
+                if (error || job->cpu->IsTrapped() || job->executed >= job->budget)
+                {
+                    Complete(std::move(job), error);
+                }
+                else
+                {
+                    Push(index, std::move(job));
+                }
+                if (stopping_)
+                {
+                    return;
+                }
+            }
+        }
+
+    public:
+        // Creates a scheduler with `threads` workers that runs each CPU for `quantum` instructions at a time.
+        explicit Scheduler(size_t threads = std::thread::hardware_concurrency(), size_t quantum = 100000) : quantum_{std::max<size_t>(quantum, 1)}
+        {
+            threads = std::max<size_t>(threads, 1);
+            for (size_t i = 0; i < threads; i++)
+            {
+                workers_.push_back(std::make_unique<Worker>());
+            }
+            for (size_t i = 0; i < threads; i++)
+            {
+                threads_.emplace_back([this, i] { Work(i); });
+            }
+        }
+
+        // Stops the workers. CPUs that haven't completed are discarded. CPUs with stop events are preempted, so that
+        // the workers don't have to finish their quanta first.
+        ~Scheduler()
+        {
+            {
+                std::lock_guard lock(mutex_);
+                stopping_ = true;
+            }
+            if constexpr (HasStopEvents<Cpu>)
+            {
+                Preempt();
+            }
+            workAvailable_.notify_all();
+            for (auto& t : threads_)
+            {
+                t.join();
+            }
+        }
+
+        Scheduler(const Scheduler&) = delete;
+        auto operator=(const Scheduler&) -> Scheduler& = delete;
+
+        // Takes ownership of `cpu` and queues it to run from wherever it is now for at most `budget` instructions.
+        auto Submit(std::unique_ptr<Cpu> cpu, size_t budget) -> JobId
+        {
+            JobId id;
+            {
+                std::lock_guard lock(mutex_);
+                id = nextId_++;
+                ++outstanding_;
+            }
+            Push(nextWorker_++ % workers_.size(), std::make_unique<Job>(Job{.id = id, .cpu = std::move(cpu), .budget = budget, .executed = 0}));
+            {
+                std::lock_guard lock(mutex_); // As in Push().
+            }
+            workAvailable_.notify_one();
+            return id;
+        }
+
+        // Waits for the next CPU to complete and returns it, or returns nothing if there are none outstanding.
+        auto WaitForCompletion() -> std::optional<Completion<Cpu>>
+        {
+            std::unique_lock lock(mutex_);
+            completed_.wait(lock, [this] { return !completions_.empty() || outstanding_ == 0; });
+            return TakeCompletion();
+        }
+
+        // Returns the next CPU to complete if there is one, without waiting.
+        auto TryGetCompletion() -> std::optional<Completion<Cpu>>
+        {
+            std::lock_guard lock(mutex_);
+            return TakeCompletion();
+        }
+
+        // Asks the CPUs that are running right now to stop at their next branch or jump. They go back on their workers'
+        // queues as if their quanta had run out, so that the CPUs waiting behind them get a turn sooner.
+        auto Preempt() -> void
+            requires HasStopEvents<Cpu>
+        {
+            for (auto& w : workers_)
+            {
+                std::lock_guard lock(w->mutex);
+                if (w->running)
+                {
+                    w->running->RequestStop();
+                }
+            }
+        }
+
+        // The number of CPUs that have been submitted and not yet collected.
+        auto Outstanding() -> size_t
+        {
+            std::lock_guard lock(mutex_);
+            return outstanding_;
+        }
+    };
+} // namespace arviss::sched
@@ -0,0 +1,436 @@
+#pragma once
+
+#include "arviss/arviss.h"
+#include "arviss/remix/encoder.h"
+#include "arviss/remix/side_table.h"
+#include "arviss/rv32/dispatchers.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <optional>
+
+namespace arviss::wide
+{
+    using remix::Opcode;
+    using remix::Remix;
+
+    // An Rv32im core that runs N guests in lockstep. The guests are expected to run the same code, each on its own memory
+    // and with its own inputs, e.g., for fuzzing or for Monte Carlo runs.
+    //
+    // Integer registers are stored as structure-of-arrays, so register r of every lane is contiguous. On each step the
+    // lanes with the lowest pc execute its instruction together, and the others wait. Diverged lanes catch up as soon as
+    // the leaders reach their pc again, which for structured code is where the two sides of a branch reconverge. Each op
+    // is written as a loop over the lanes followed by a masked blend, which the compiler can turn into AVX2 or AVX-512
+    // code when the host has it. Loads, stores and traps are per lane.
+    //
+    // Instructions are transcoded to Remix once per pc, from the memory of the first lane to reach it, on the assumption
+    // that every lane has the same code and that it doesn't change.
+    template<HasMemory Mem, size_t N>
+    class WideCpu
+    {
+        static_assert(N > 0);
+
+        using Lanes = std::array<u32, N>;
+
+        static constexpr u32 notTranscoded = 0b11; // Never a Remix word, as all opcodes ending in 0b11 are for RV32.
+
+        alignas(64) std::array<Lanes, 32> xreg_{}; // Register r of lane i is xreg_[r][i].
+        alignas(64) Lanes pc_{};                   // The next instruction of each lane, or the one that trapped.
+        alignas(64) Lanes mask_{};                 // All ones for the lanes executing the current instruction.
+        std::array<std::optional<TrapState>, N> trap_{};
+        std::array<Mem, N> mem_{};
+        Rv32imDispatcher<remix::Rv32imToRemixConverter> converter_{};
+        remix::SideTable<u32, 2, notTranscoded> remixed_{}; // A Remix word for every word of code.
+
+        // rd <- op(rs1, rs2) for every lane in the mask.
+        template<typename Op>
+        auto Alu(Reg rd, Reg rs1, Reg rs2, Op op) -> void
+        {
+            if (rd == 0)
+            {
+                return;
+            }
+            Lanes result;
+            const auto& a = xreg_[rs1];
+            const auto& b = xreg_[rs2];
+            for (size_t i = 0; i < N; i++)
+            {
+                result[i] = op(a[i], b[i]);
+            }
+            Blend(xreg_[rd], result);
+        }
+
+        // rd <- op(rs1, imm) for every lane in the mask.
+        template<typename Op>
+        auto AluImm(Reg rd, Reg rs1, u32 imm, Op op) -> void
+        {
+            if (rd == 0)
+            {
+                return;
+            }
+            Lanes result;
+            const auto& a = xreg_[rs1];
+            for (size_t i = 0; i < N; i++)
+            {
+                result[i] = op(a[i], imm);
+            }
+            Blend(xreg_[rd], result);
+        }
+
+        // rd <- value for every lane in the mask.
+        auto Set(Reg rd, u32 value) -> void
+        {
+            if (rd == 0)
+            {
+                return;
+            }
+            Lanes result;
+            result.fill(value);
+            Blend(xreg_[rd], result);
+        }
+
+        auto Blend(Lanes& dest, const Lanes& result) -> void
+        {
+            for (size_t i = 0; i < N; i++)
+            {
+                dest[i] = (result[i] & mask_[i]) | (dest[i] & ~mask_[i]);
+            }
+        }
+
+        // pc <- pc + (cond(rs1, rs2) ? bimm : 4) for every lane in the mask.
+        template<typename Cond>
+        auto Branch(Address pc, Reg rs1, Reg rs2, u32 bimm, Cond cond) -> void
+        {
+            Lanes next;
+            const auto& a = xreg_[rs1];
+            const auto& b = xreg_[rs2];
+            for (size_t i = 0; i < N; i++)
+            {
+                next[i] = cond(a[i], b[i]) ? pc + bimm : pc + 4;
+            }
+            Blend(pc_, next);
+        }
+
+        // Calls `access(lane, address)` for every lane in the mask, where `address` is rs1 + imm. A TrappedException
+        // thrown by a lane's memory raises `fault` on that lane at `pc`.
+        template<typename Access>
+        auto EachAccess(Address pc, Reg rs1, u32 imm, TrapType fault, Access access) -> void
+        {
+            for (size_t i = 0; i < N; i++)
+            {
+                if (mask_[i] != 0)
+                {
+                    const Address address = xreg_[rs1][i] + imm;
+                    try
+                    {
+                        access(i, address);
+                    }
+                    catch (const TrappedException&)
+                    {
+                        Fault(i, pc, fault, address);
+                    }
+                }
+            }
+        }
+
+        template<typename Read, typename Extend>
+        auto Load(Address pc, Reg rd, Reg rs1, u32 iimm, Read read, Extend extend) -> void
+        {
+            EachAccess(pc, rs1, iimm, TrapType::LoadAccessFault, [&](size_t i, Address address) {
+                const u32 value = extend(read(mem_[i], address));
+                if (rd != 0)
+                {
+                    xreg_[rd][i] = value;
+                }
+            });
+        }
+
+        // Raises a trap on `lane`, leaving its pc at the instruction that trapped.
+        auto Fault(size_t lane, Address pc, TrapType type, u32 context = 0) -> void
+        {
+            RaiseTrap(lane, type, context);
+            pc_[lane] = pc;
+        }
+
+        // Raises a trap on every lane in the mask.
+        auto FaultAll(Address pc, TrapType type, u32 context = 0) -> void
+        {
+            for (size_t i = 0; i < N; i++)
+            {
+                if (mask_[i] != 0)
+                {
+                    Fault(i, pc, type, context);
+                }
+            }
+        }
+
+        // Returns the Remix word for the instruction at `pc`, transcoding it from `lane`'s memory if it hasn't been seen.
+        // There are no compressed instructions, so a pc that isn't word aligned throws.
+        auto Fetch(size_t lane, Address pc) -> u32
+        {
+            if ((pc & 0b11) != 0)
+            {
+                throw TrappedException(TrapType::InstructionAddressMisaligned);
+            }
+            if (const auto* r = remixed_.Find(pc); r != nullptr && *r != notTranscoded)
+            {
+                return *r;
+            }
+            const auto remixed = converter_.Dispatch(mem_[lane].Read32(pc));
+            const u32 code = *reinterpret_cast<const u32*>(&remixed);
+            remixed_.Set(pc, code);
+            return code;
+        }
+
+        // Executes the Remix word `code` at `pc` on every lane in the mask.
+        auto Execute(u32 code, Address pc, size_t lane) -> void
+        {
+            const Remix e = *reinterpret_cast<const Remix*>(&code);
+            Lanes next;
+            next.fill(pc + 4);
+            Blend(pc_, next); // Anything that traps or branches overrides this.
+
+            switch (e.f0.opc())
+            {
+            // B-type instructions.
+            case Opcode::Beq:
+                return Branch(pc, e.btype.rs1(), e.btype.rs2(), e.btype.bimm(), [](u32 a, u32 b) { return a == b; });
+            case Opcode::Bne:
+                return Branch(pc, e.btype.rs1(), e.btype.rs2(), e.btype.bimm(), [](u32 a, u32 b) { return a != b; });
+            case Opcode::Blt:
+                return Branch(pc, e.btype.rs1(), e.btype.rs2(), e.btype.bimm(), [](u32 a, u32 b) { return i32(a) < i32(b); });
+            case Opcode::Bge:
+                return Branch(pc, e.btype.rs1(), e.btype.rs2(), e.btype.bimm(), [](u32 a, u32 b) { return i32(a) >= i32(b); });
+            case Opcode::Bltu:
+                return Branch(pc, e.btype.rs1(), e.btype.rs2(), e.btype.bimm(), [](u32 a, u32 b) { return a < b; });
+            case Opcode::Bgeu:
+                return Branch(pc, e.btype.rs1(), e.btype.rs2(), e.btype.bimm(), [](u32 a, u32 b) { return a >= b; });
+
+            // I-type instructions.
+            case Opcode::Lb:
+                return Load(pc, e.itype.rd(), e.itype.rs1(), e.itype.iimm(), [](Mem& m, Address a) { return m.Read8(a); },
+                            [](u8 v) { return u32(i32(i8(v))); });
+            case Opcode::Lh:
+                return Load(pc, e.itype.rd(), e.itype.rs1(), e.itype.iimm(), [](Mem& m, Address a) { return m.Read16(a); },
+                            [](u16 v) { return u32(i32(i16(v))); });
+            case Opcode::Lw:
+                return Load(pc, e.itype.rd(), e.itype.rs1(), e.itype.iimm(), [](Mem& m, Address a) { return m.Read32(a); }, [](u32 v) { return v; });
+            case Opcode::Lbu:
+                return Load(pc, e.itype.rd(), e.itype.rs1(), e.itype.iimm(), [](Mem& m, Address a) { return m.Read8(a); }, [](u8 v) { return u32(v); });
+            case Opcode::Lhu:
+                return Load(pc, e.itype.rd(), e.itype.rs1(), e.itype.iimm(), [](Mem& m, Address a) { return m.Read16(a); }, [](u16 v) { return u32(v); });
+            case Opcode::Addi:
+                return AluImm(e.itype.rd(), e.itype.rs1(), e.itype.iimm(), [](u32 a, u32 b) { return a + b; });
+            case Opcode::Slti:
+                return AluImm(e.itype.rd(), e.itype.rs1(), e.itype.iimm(), [](u32 a, u32 b) { return u32(i32(a) < i32(b)); });
+            case Opcode::Sltiu:
+                return AluImm(e.itype.rd(), e.itype.rs1(), e.itype.iimm(), [](u32 a, u32 b) { return u32(a < b); });
+            case Opcode::Xori:
+                return AluImm(e.itype.rd(), e.itype.rs1(), e.itype.iimm(), [](u32 a, u32 b) { return a ^ b; });
+            case Opcode::Ori:
+                return AluImm(e.itype.rd(), e.itype.rs1(), e.itype.iimm(), [](u32 a, u32 b) { return a | b; });
+            case Opcode::Andi:
+                return AluImm(e.itype.rd(), e.itype.rs1(), e.itype.iimm(), [](u32 a, u32 b) { return a & b; });
+            case Opcode::Jr:
+            case Opcode::Jalr: {
+                // rd <- pc + 4, pc <- (rs1 + imm_i) & ~1, as Rv32iExecutor does it.
+                Lanes target;
+                const auto& a = xreg_[e.itype.rs1()];
+                const auto iimm = e.itype.iimm() & ~1u;
+                for (size_t i = 0; i < N; i++)
+                {
+                    target[i] = a[i] + iimm;
+                }
+                Set(e.itype.rd(), pc + 4);
+                return Blend(pc_, target);
+            }
+
+            // S-type instructions.
+            case Opcode::Sb:
+                return EachAccess(pc, e.stype.rs1(), e.stype.simm(), TrapType::StoreAccessFault,
+                                  [&](size_t i, Address a) { mem_[i].Write8(a, static_cast<u8>(xreg_[e.stype.rs2()][i])); });
+            case Opcode::Sh:
+                return EachAccess(pc, e.stype.rs1(), e.stype.simm(), TrapType::StoreAccessFault,
+                                  [&](size_t i, Address a) { mem_[i].Write16(a, static_cast<u16>(xreg_[e.stype.rs2()][i])); });
+            case Opcode::Sw:
+                return EachAccess(pc, e.stype.rs1(), e.stype.simm(), TrapType::StoreAccessFault,
+                                  [&](size_t i, Address a) { mem_[i].Write32(a, xreg_[e.stype.rs2()][i]); });
+
+            // U-type instructions.
+            case Opcode::Auipc:
+                return Set(e.utype.rd(), pc + e.utype.uimm());
+            case Opcode::Lui:
+                return Set(e.utype.rd(), e.utype.uimm());
+
+            // J-type instructions.
+            case Opcode::J:
+            case Opcode::Jal:
+                Set(e.jtype.rd(), pc + 4);
+                next.fill(pc + e.jtype.jimm());
+                return Blend(pc_, next);
+
+            // Arithmetic instructions.
+            case Opcode::Add:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(), [](u32 a, u32 b) { return a + b; });
+            case Opcode::Sub:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(), [](u32 a, u32 b) { return a - b; });
+            case Opcode::Sll:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(), [](u32 a, u32 b) { return a << (b % 32); });
+            case Opcode::Slt:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(), [](u32 a, u32 b) { return u32(i32(a) < i32(b)); });
+            case Opcode::Sltu:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(), [](u32 a, u32 b) { return u32(a < b); });
+            case Opcode::Xor:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(), [](u32 a, u32 b) { return a ^ b; });
+            case Opcode::Srl:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(), [](u32 a, u32 b) { return a >> (b % 32); });
+            case Opcode::Sra:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(), [](u32 a, u32 b) { return u32(i32(a) >> (b % 32)); });
+            case Opcode::Or:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(), [](u32 a, u32 b) { return a | b; });
+            case Opcode::And:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(), [](u32 a, u32 b) { return a & b; });
+
+            // Immediate shift instructions.
+            case Opcode::Slli:
+                return AluImm(e.immShiftType.rd(), e.immShiftType.rs1(), e.immShiftType.shamt(), [](u32 a, u32 b) { return a << b; });
+            case Opcode::Srli:
+                return AluImm(e.immShiftType.rd(), e.immShiftType.rs1(), e.immShiftType.shamt(), [](u32 a, u32 b) { return a >> b; });
+            case Opcode::Srai:
+                return AluImm(e.immShiftType.rd(), e.immShiftType.rs1(), e.immShiftType.shamt(), [](u32 a, u32 b) { return u32(i32(a) >> b); });
+
+            // System instructions.
+            case Opcode::Fence:
+                return;
+            case Opcode::Ecall:
+                return FaultAll(pc, TrapType::EnvironmentCallFromMMode);
+            case Opcode::Ebreak:
+                return FaultAll(pc, TrapType::Breakpoint);
+
+            // Instructions whose destination is x0. J and Jr still have x0 in their rd field, so they're handled above.
+            case Opcode::Nop:
+                return;
+            case Opcode::Load_x0: {
+                // The rd field holds the load's opcode. Run the load itself with x0 as its destination.
+                const auto load = remix::F2i(Opcode(e.itype.rd()), RegNames::ZERO, e.itype.rs1(), e.itype.iimm());
+                return Execute(*reinterpret_cast<const u32*>(&load), pc, lane);
+            }
+
+            // Integer multiply and divide instructions.
+            case Opcode::Mul:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(), [](u32 a, u32 b) { return a * b; });
+            case Opcode::Mulh:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(),
+                           [](u32 a, u32 b) { return u32((i64(i32(a)) * i64(i32(b))) >> 32); });
+            case Opcode::Mulhsu:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(), [](u32 a, u32 b) { return u32((i64(i32(a)) * i64(b)) >> 32); });
+            case Opcode::Mulhu:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(), [](u32 a, u32 b) { return u32((u64(a) * u64(b)) >> 32); });
+            case Opcode::Div:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(), [](u32 a, u32 b) {
+                    if (b == 0)
+                    {
+                        return std::numeric_limits<u32>::max();
+                    }
+                    return a == 0x80000000 && b == 0xffffffff ? a : u32(i32(a) / i32(b));
+                });
+            case Opcode::Divu:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(),
+                           [](u32 a, u32 b) { return b != 0 ? a / b : std::numeric_limits<u32>::max(); });
+            case Opcode::Rem:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(), [](u32 a, u32 b) {
+                    if (b == 0)
+                    {
+                        return a;
+                    }
+                    return a == 0x80000000 && b == 0xffffffff ? 0 : u32(i32(a) % i32(b));
+                });
+            case Opcode::Remu:
+                return Alu(e.arithType.rd(), e.arithType.rs1(), e.arithType.rs2(), [](u32 a, u32 b) { return b != 0 ? a % b : a; });
+
+            default:
+                // The converter has lost the original instruction, so fetch it again for the trap's context.
+                return FaultAll(pc, TrapType::IllegalInstruction, mem_[lane].Read32(pc));
+            }
+        }
+
+    public:
+        static constexpr size_t lanes = N;
+
+        // Returns a lane's memory, e.g., to load its image or its inputs.
+        auto Memory(size_t lane) -> Mem& { return mem_[lane]; }
+
+        auto Rx(size_t lane, Reg rs) const -> u32 { return xreg_[rs][lane]; }
+
+        auto Wx(size_t lane, Reg rd, u32 val) -> void
+        {
+            if (rd != 0)
+            {
+                xreg_[rd][lane] = val;
+            }
+        }
+
+        // Returns the address of a lane's next instruction, or of the instruction that trapped if it has trapped.
+        auto Pc(size_t lane) const -> Address { return pc_[lane]; }
+
+        auto SetNextPc(size_t lane, Address address) -> void { pc_[lane] = address; }
+        auto SetNextPc(Address address) -> void { pc_.fill(address); }
+
+        auto IsTrapped(size_t lane) const -> bool { return trap_[lane].has_value(); }
+        auto TrapCause(size_t lane) const -> std::optional<TrapState> { return trap_[lane]; }
+        auto RaiseTrap(size_t lane, TrapType type, u32 context = 0) { trap_[lane] = {.type_ = type, .context_ = context}; }
+        auto ClearTraps() { trap_.fill(std::nullopt); }
+
+        // Returns true if every lane has trapped.
+        auto IsTrapped() const -> bool
+        {
+            return std::all_of(trap_.begin(), trap_.end(), [](const auto& t) { return t.has_value(); });
+        }
+
+        // Executes one instruction on the lanes with the lowest pc. Returns false if every lane has trapped.
+        auto Step() -> bool
+        {
+            std::optional<Address> pc{};
+            size_t leader = 0;
+            for (size_t i = 0; i < N; i++)
+            {
+                if (!trap_[i] && (!pc || pc_[i] < *pc))
+                {
+                    pc = pc_[i];
+                    leader = i;
+                }
+            }
+            if (!pc)
+            {
+                return false;
+            }
+            for (size_t i = 0; i < N; i++)
+            {
+                mask_[i] = (!trap_[i] && pc_[i] == *pc) ? ~0u : 0u;
+            }
+
+            u32 code;
+            try
+            {
+                code = Fetch(leader, *pc);
+            }
+            catch (const TrappedException& e)
+            {
+                FaultAll(*pc, e.Reason(), *pc); // The fetch failed, so the pc is the address that faulted.
+                return true;
+            }
+            Execute(code, *pc, leader);
+            return true;
+        }
+
+        // Executes up to `count` steps, stopping early if every lane traps.
+        auto Run(size_t count) -> void
+        {
+            while (count > 0 && Step())
+            {
+                --count;
+            }
+        }
+    };
+} // namespace arviss::wide
@@ -0,0 +1,163 @@
+# Branch-heavy workload: a state machine, in the style of CoreMark's, that classifies comma separated numbers in 1KiB
+# of pseudo-random text as integers, decimals, scientific notation or invalid. Nearly every branch depends on the data.
+# It sticks to RV32I so that it can also be built for rv32ic.
+#
+# Returns a checksum in a0.
+
+    .equ    SIZE, 1024
+    .equ    PASSES, 64
+
+    # States.
+    .equ    START, 0
+    .equ    SIGN, 1
+    .equ    INT, 2
+    .equ    FLOAT, 3
+    .equ    EXP, 4
+    .equ    SCI, 5
+    .equ    INVALID, 6
+
+    .section .rodata
+alphabet:
+    .ascii  "0123456789+-.eE,"
+
+    .bss
+text:
+    .space  SIZE
+
+    .text
+    .global main
+    .type   main, @function
+
+main:
+    # Fill `text` with characters picked from `alphabet` by a xorshift32 generator.
+    la      a1, text
+    la      a2, text + SIZE
+    la      a3, alphabet
+    li      t0, 0x2545f491
+fill:
+    slli    t1, t0, 13
+    xor     t0, t0, t1
+    srli    t1, t0, 17
+    xor     t0, t0, t1
+    slli    t1, t0, 5
+    xor     t0, t0, t1
+    andi    t1, t0, 15
+    add     t1, t1, a3
+    lbu     t1, 0(t1)
+    sb      t1, 0(a1)
+    addi    a1, a1, 1
+    bne     a1, a2, fill
+
+    li      a0, 0               # a0 = checksum
+    li      a2, 0               # a2 = pass, which is also where it starts in `text`
+    li      a4, PASSES
+    la      a1, text
+    li      a5, SIZE - 1
+    li      a6, SIZE
+
+pass:
+    li      t0, START           # t0 = state
+    li      a3, 0               # a3 = i
+
+next:
+    add     t1, a3, a2          # t1 = text[(i + pass) % SIZE]
+    and     t1, t1, a5
+    add     t1, t1, a1
+    lbu     t1, 0(t1)
+
+    li      t2, ','
+    beq     t1, t2, comma
+    addi    t3, t1, -'0'        # t3 = 1 if it's a digit, otherwise 0
+    sltiu   t3, t3, 10
+    ori     t4, t1, 0x20        # t4 = 'e' for either 'e' or 'E'
+
+    beqz    t0, start
+    li      t2, SIGN
+    beq     t0, t2, sign
+    li      t2, INT
+    beq     t0, t2, int
+    li      t2, FLOAT
+    beq     t0, t2, float
+    li      t2, EXP
+    beq     t0, t2, exp
+    li      t2, SCI
+    beq     t0, t2, sci
+    j       done                # INVALID stays INVALID.
+
+start:
+    bnez    t3, to_int
+    li      t2, '+'
+    beq     t1, t2, to_sign
+    li      t2, '-'
+    beq     t1, t2, to_sign
+    li      t2, '.'
+    beq     t1, t2, to_float
+    j       to_invalid
+
+sign:
+    bnez    t3, to_int
+    li      t2, '.'
+    beq     t1, t2, to_float
+    j       to_invalid
+
+int:
+    bnez    t3, done
+    li      t2, '.'
+    beq     t1, t2, to_float
+    li      t2, 'e'
+    beq     t4, t2, to_exp
+    j       to_invalid
+
+float:
+    bnez    t3, done
+    li      t2, 'e'
+    beq     t4, t2, to_exp
+    j       to_invalid
+
+exp:
+    bnez    t3, to_sci
+    li      t2, '+'
+    beq     t1, t2, to_sci
+    li      t2, '-'
+    beq     t1, t2, to_sci
+    j       to_invalid
+
+sci:
+    bnez    t3, done
+    j       to_invalid
+
+to_sign:
+    li      t0, SIGN
+    j       done
+to_int:
+    li      t0, INT
+    j       done
+to_float:
+    li      t0, FLOAT
+    j       done
+to_exp:
+    li      t0, EXP
+    j       done
+to_sci:
+    li      t0, SCI
+    j       done
+to_invalid:
+    li      t0, INVALID
+    j       done
+
+    # End of a number, so checksum = rotl(checksum, 3) ^ state.
+comma:
+    srli    t2, a0, 29
+    slli    a0, a0, 3
+    or      a0, a0, t2
+    xor     a0, a0, t0
+    li      t0, START
+
+done:
+    addi    a3, a3, 1
+    bne     a3, a6, next
+    addi    a2, a2, 1
+    bne     a2, a4, pass
+    ret
+
+    .size   main, .-main
@@ -0,0 +1,115 @@
+# Floating point workload for rv32imf: multiplies two 16x16 matrices of floats, then sums the series 1/k^2 to estimate
+# pi. The matrices hold small integers so that their products are exact, whether or not the multiply-adds are fused.
+#
+# Returns a checksum in a0.
+
+    .equ    N, 16
+    .equ    REPEATS, 8
+    .equ    TERMS, 4000
+
+    .bss
+    .balign 4
+mat_a:
+    .space  N * N * 4
+mat_b:
+    .space  N * N * 4
+mat_c:
+    .space  N * N * 4
+
+    .text
+    .global main
+    .type   main, @function
+
+main:
+    # A[i][j] = (i + j) % 7 - 3 and B[i][j] = (i * j) % 5 - 2.
+    la      a1, mat_a
+    la      a2, mat_b
+    li      a3, N
+    li      t5, 7
+    li      t6, 5
+    li      t0, 0               # t0 = i
+fill_row:
+    li      t1, 0               # t1 = j
+fill:
+    add     t2, t0, t1
+    remu    t2, t2, t5
+    addi    t2, t2, -3
+    fcvt.s.w ft0, t2
+    fsw     ft0, 0(a1)
+    mul     t2, t0, t1
+    remu    t2, t2, t6
+    addi    t2, t2, -2
+    fcvt.s.w ft0, t2
+    fsw     ft0, 0(a2)
+    addi    a1, a1, 4
+    addi    a2, a2, 4
+    addi    t1, t1, 1
+    bne     t1, a3, fill
+    addi    t0, t0, 1
+    bne     t0, a3, fill_row
+
+    # C = A x B, repeatedly.
+    li      a4, REPEATS
+repeat:
+    la      a5, mat_c
+    li      t0, 0               # t0 = i
+row:
+    li      t1, 0               # t1 = j
+column:
+    fmv.w.x ft0, zero           # ft0 = C[i][j]
+    slli    a1, t0, 6           # a1 = &A[i][0]
+    la      t2, mat_a
+    add     a1, a1, t2
+    slli    a2, t1, 2           # a2 = &B[0][j]
+    la      t2, mat_b
+    add     a2, a2, t2
+    li      t2, N               # t2 = k
+dot:
+    flw     ft1, 0(a1)
+    flw     ft2, 0(a2)
+    fmadd.s ft0, ft1, ft2, ft0
+    addi    a1, a1, 4
+    addi    a2, a2, N * 4
+    addi    t2, t2, -1
+    bnez    t2, dot
+    fsw     ft0, 0(a5)
+    addi    a5, a5, 4
+    addi    t1, t1, 1
+    bne     t1, a3, column
+    addi    t0, t0, 1
+    bne     t0, a3, row
+    addi    a4, a4, -1
+    bnez    a4, repeat
+
+    # Sum the elements of C.
+    fmv.w.x ft0, zero
+    la      a1, mat_c
+    la      a2, mat_c + N * N * 4
+total:
+    flw     ft1, 0(a1)
+    fadd.s  ft0, ft0, ft1
+    addi    a1, a1, 4
+    bne     a1, a2, total
+    fmv.x.w a0, ft0             # a0 = checksum
+
+    # pi = sqrt(6 * sum(1 / k^2))
+    fmv.w.x ft0, zero
+    li      t0, 1
+    fcvt.s.w ft3, t0            # ft3 = 1.0
+    li      t1, TERMS + 1
+series:
+    fcvt.s.w ft1, t0
+    fmul.s  ft1, ft1, ft1
+    fdiv.s  ft1, ft3, ft1
+    fadd.s  ft0, ft0, ft1
+    addi    t0, t0, 1
+    bne     t0, t1, series
+    li      t0, 6
+    fcvt.s.w ft1, t0
+    fmul.s  ft0, ft0, ft1
+    fsqrt.s ft0, ft0
+    fmv.x.w t0, ft0
+    xor     a0, a0, t0
+    ret
+
+    .size   main, .-main
@@ -0,0 +1,61 @@
+# Integer-heavy workload: a xorshift32 generator feeding a popcount and a subtractive GCD. It sticks to RV32I so that
+# it can also be built for rv32ic.
+#
+# Returns a checksum in a0.
+
+    .text
+    .global main
+    .type   main, @function
+
+main:
+    li      a0, 0               # a0 = checksum
+    li      a1, 0x2545f491      # a1 = xorshift32 state
+    li      a2, 20000           # a2 = iterations
+
+next:
+    # Advance the generator.
+    slli    t0, a1, 13
+    xor     a1, a1, t0
+    srli    t0, a1, 17
+    xor     a1, a1, t0
+    slli    t0, a1, 5
+    xor     a1, a1, t0
+
+    # Count its set bits.
+    mv      t0, a1
+    li      t1, 0
+popcount:
+    beqz    t0, gcd_setup
+    addi    t2, t0, -1
+    and     t0, t0, t2
+    addi    t1, t1, 1
+    j       popcount
+
+    # Find the GCD of its bottom and top bytes, made odd so that neither is zero.
+gcd_setup:
+    andi    t2, a1, 0xff
+    ori     t2, t2, 1
+    srli    t0, a1, 24
+    ori     t0, t0, 1
+gcd:
+    beq     t2, t0, mix
+    bltu    t2, t0, gcd_swap
+    sub     t2, t2, t0
+    j       gcd
+gcd_swap:
+    sub     t0, t0, t2
+    j       gcd
+
+    # checksum = rotl(checksum, 1) ^ (popcount + gcd)
+mix:
+    add     t1, t1, t2
+    srli    t2, a0, 31
+    slli    a0, a0, 1
+    or      a0, a0, t2
+    xor     a0, a0, t1
+
+    addi    a2, a2, -1
+    bnez    a2, next
+    ret
+
+    .size   main, .-main
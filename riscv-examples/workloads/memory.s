@@ -0,0 +1,93 @@
+# Memory-heavy workload: fills a 4KiB buffer, then repeatedly copies it a word at a time, copies it back a byte at a
+# time rotated by one more byte on each pass, and sums it a halfword at a time. It sticks to RV32I so that it can also
+# be built for rv32ic.
+#
+# Returns a checksum in a0.
+
+    .equ    SIZE, 4096
+    .equ    PASSES, 16
+
+    .bss
+    .balign 4
+src:
+    .space  SIZE
+dst:
+    .space  SIZE
+
+    .text
+    .global main
+    .type   main, @function
+
+main:
+    # Fill `src` with the output of a xorshift32 generator.
+    la      a1, src
+    la      a2, src + SIZE
+    li      t0, 0x2545f491
+fill:
+    slli    t1, t0, 13
+    xor     t0, t0, t1
+    srli    t1, t0, 17
+    xor     t0, t0, t1
+    slli    t1, t0, 5
+    xor     t0, t0, t1
+    sw      t0, 0(a1)
+    addi    a1, a1, 4
+    bne     a1, a2, fill
+
+    li      a0, 0               # a0 = checksum
+    li      a3, 1               # a3 = rotation, 1 to PASSES
+    li      a4, PASSES + 1
+
+pass:
+    # Copy `src` to `dst` four words at a time.
+    la      a1, src
+    la      a2, dst
+    la      a5, src + SIZE
+copy_words:
+    lw      t0, 0(a1)
+    lw      t1, 4(a1)
+    lw      t2, 8(a1)
+    lw      t3, 12(a1)
+    sw      t0, 0(a2)
+    sw      t1, 4(a2)
+    sw      t2, 8(a2)
+    sw      t3, 12(a2)
+    addi    a1, a1, 16
+    addi    a2, a2, 16
+    bne     a1, a5, copy_words
+
+    # Copy `dst` back to `src` a byte at a time, i.e., src[i] = dst[(i + rotation) % SIZE].
+    la      a1, src
+    la      a2, dst
+    li      t4, SIZE - 1
+    li      a5, SIZE
+    li      t0, 0               # t0 = i
+copy_bytes:
+    add     t1, t0, a3
+    and     t1, t1, t4
+    add     t1, t1, a2
+    lbu     t2, 0(t1)
+    add     t1, t0, a1
+    sb      t2, 0(t1)
+    addi    t0, t0, 1
+    bne     t0, a5, copy_bytes
+
+    # Sum `dst` a halfword at a time.
+    la      a1, dst
+    la      a5, dst + SIZE
+sum:
+    lhu     t0, 0(a1)
+    add     a0, a0, t0
+    addi    a1, a1, 2
+    bne     a1, a5, sum
+
+    addi    a3, a3, 1
+    bne     a3, a4, pass
+
+    # Fold in the last word of `src` so that the final byte copy counts too.
+    la      a1, src + SIZE - 4
+    lw      t0, 0(a1)
+    xor     a0, a0, t0
+    ret
+
+    .size   main, .-main
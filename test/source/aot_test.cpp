@@ -0,0 +1,59 @@
+#include "workloads.h"
+
+#include "arviss/aot/runtime.h"
+#include "arviss/arviss.h"
+#include "arviss/platforms/basic/basic.h"
+#include "arviss/rv32/rv32.h"
+
+// Generated at build time by aot_translate.
+#include "branch.h"
+#include "float.h"
+#include "integer.h"
+#include "memory.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Checks that the workloads, translated ahead of time to C++ and compiled into this test, leave the checksum from
+// expected.txt in a0 and finish in the same state as they do when interpreted.
+
+using namespace arviss;
+using namespace arviss::platforms;
+
+namespace
+{
+    using Cpu = Rv32imfCpu<basic::MemoryNoIO>;
+
+    // Runs the workload called `name` with its translated `Image`.
+    template<typename Image>
+    auto CheckTranslated(const std::string& name, const std::vector<test::Workload>& workloads) -> void
+    {
+        const auto workload = std::find_if(workloads.begin(), workloads.end(), [&](const test::Workload& w) { return w.name == name; });
+        test::Expect(workload != workloads.end(), name + " is in expected.txt");
+        if (workload == workloads.end())
+        {
+            return;
+        }
+
+        auto reference = test::Run<Cpu>("Rv32imfCpu", *workload);
+        auto cpu = std::make_unique<Cpu>();
+        cpu->LoadImage(0, workload->image);
+        cpu->SetNextPc(0);
+        aot::Run<Image>(*cpu, workload->instructions + 1000);
+        test::Expect(cpu->IsTrapped() && cpu->TrapCause()->type_ == TrapType::Breakpoint, "translated " + name + " reaches its ebreak");
+        test::Expect(cpu->Rx(10) == workload->checksum, "translated " + name + " leaves the checksum in a0");
+        test::Expect(test::IsSameState(*cpu, *reference), "translated " + name + " finishes in the same state as the reference CPU");
+    }
+} // namespace
+
+auto main() -> int
+{
+    const auto workloads = test::Workloads();
+    CheckTranslated<integer_bin::Image>("integer.bin", workloads);
+    CheckTranslated<memory_bin::Image>("memory.bin", workloads);
+    CheckTranslated<branch_bin::Image>("branch.bin", workloads);
+    CheckTranslated<float_bin::Image>("float.bin", workloads);
+    return test::failures;
+}
@@ -0,0 +1,49 @@
+#include "arviss/aot/translator.h"
+#include "arviss/arviss.h"
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+// Translates a workload to C++ at build time for aot_test. It's the same as the translator example, except that it
+// writes the header to a file so that the build can depend on it.
+
+using namespace arviss;
+
+auto main(int argc, char* argv[]) -> int
+{
+    try
+    {
+        if (argc < 4)
+        {
+            std::cerr << "Usage: aot_translate <image> <namespace> <header>\n";
+            return 2;
+        }
+
+        std::ifstream image(argv[1], std::ios::in | std::ios::binary | std::ios::ate);
+        std::vector<u8> buf(static_cast<size_t>(image.tellg()));
+        image.seekg(0, std::ios::beg);
+        image.read(reinterpret_cast<char*>(buf.data()), static_cast<std::streamsize>(buf.size()));
+        if (!image)
+        {
+            std::cerr << "Can't read " << argv[1] << '\n';
+            return 1;
+        }
+
+        aot::Translator translator(0, buf);
+        std::ofstream header(argv[3], std::ios::out | std::ios::trunc);
+        translator.Emit(header, argv[2]);
+        header.close();
+        if (!header)
+        {
+            std::cerr << "Can't write " << argv[3] << '\n';
+            return 1;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Exited with: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include "workloads.h"
+
+#include "arviss/arviss.h"
+#include "arviss/blocks/blocks.h"
+#include "arviss/jit/jit.h"
+#include "arviss/platforms/basic/basic.h"
+#include "arviss/rv32/rv32.h"
+#include "arviss/sched/scheduler.h"
+
+#include <array>
+#include <memory>
+#include <span>
+#include <string>
+
+// Checks that the block cache and the JIT run the workloads to the same state as a plain RV32imf CPU, that they notice
+// when the guest overwrites code that they have already cached or compiled, and that a fused pair of instructions traps
+// exactly where the second instruction would on its own.
+
+using namespace arviss;
+using namespace arviss::platforms;
+
+namespace
+{
+    using Reference = Rv32imfCpu<basic::MemoryNoIO>;
+
+    // An RV32imf CPU with stop events, which the JIT doesn't chain blocks for.
+    template<HasMemory Mem>
+    using Rv32imfPreemptibleCpu = Rv32imfDispatcher<Rv32imfExecutor<Preemptible<FloatCore<Mem>>>>;
+
+    // Writes `program` to memory at `start` and runs it on a new `Cpu` until it stops, for up to `count` instructions.
+    template<typename Cpu>
+    auto RunProgram(Address start, std::span<const u32> program, size_t count) -> std::unique_ptr<Cpu>
+    {
+        auto cpu = std::make_unique<Cpu>();
+        for (u32 i = 0; i < program.size(); i++)
+        {
+            cpu->Write32Unprotected(start + 4 * i, program[i]);
+        }
+        cpu->SetNextPc(start);
+        sched::RunFor(*cpu, count);
+        return cpu;
+    }
+
+    // A loop that calls a function, f, 100 times, adding 1 to a1 and letting f add 1 to a0. Once both are hot, and have
+    // been compiled by the JIT, it arms two stores for a single pass of the loop. The first overwrites the instruction
+    // after it in the same block so that the loop adds 100 to a1, and the second overwrites f, on the next page, so that
+    // it adds 100 to a0, leaving 5050 in a1 and 4951 in a0.
+    constexpr Address selfModifyingStart = 0x4fa8;
+    constexpr std::array<u32, 24> selfModifying = {
+            0x00005437, // lui s0, 0x5          ; s0 = f
+            0x06400493, // li s1, 100
+            0xff842303, // lw t1, -8(s0)        ; t1 = addi a1, a1, 100
+            0xffc42383, // lw t2, -4(s0)        ; t2 = addi a0, a0, 100
+            0x00006e37, // lui t3, 0x6          ; t3 = somewhere that isn't code
+            0x00006eb7, // lui t4, 0x6          ; t4 = somewhere that isn't code
+            0x006e2023, // sw t1, 0(t3)         ; loop: when armed, overwrites the addi after it
+            0x00158593, // addi a1, a1, 1
+            0x038000ef, // jal ra, f
+            0x007ea023, // sw t2, 0(t4)         ; when armed, overwrites the addi in f
+            0x00006e37, // lui t3, 0x6          ; disarm both stores
+            0x00006eb7, // lui t4, 0x6
+            0xfff48493, // addi s1, s1, -1
+            0x00048c63, // beqz s1, done
+            0x03200293, // li t0, 50
+            0xfc549ee3, // bne s1, t0, loop
+            0xfc440e13, // addi t3, s0, -0x3c   ; arm the stores
+            0x00040e93, // mv t4, s0
+            0xfd1ff06f, // j loop
+            0x00100073, // ebreak               ; done
+            0x06458593, // addi a1, a1, 100
+            0x06450513, // addi a0, a0, 100
+            0x00150513, // addi a0, a0, 1       ; f, at 0x5000
+            0x00008067, // ret
+    };
+
+    // Checks that `Cpu` runs the self-modifying program to the same state as `reference`.
+    template<typename Cpu>
+    auto CheckSelfModifying(const std::string& name, Reference& reference) -> void
+    {
+        const auto cpu = RunProgram<Cpu>(selfModifyingStart, selfModifying, 10000);
+        test::Expect(cpu->IsTrapped() && cpu->TrapCause()->type_ == TrapType::Breakpoint, name + " reaches the ebreak in the self-modifying program");
+        test::Expect(test::IsSameState(*cpu, reference), name + " runs the self-modifying program to the same state as the reference CPU");
+    }
+
+    // A fused auipc / lw pair whose load is past the end of memory, so it traps at the lw with t0 already set.
+    constexpr std::array<u32, 3> fusedLoad = {
+            0x00008297, // auipc t0, 0x8        ; t0 = 0xc000
+            0x0002a503, // lw a0, 0(t0)
+            0x00100073, // ebreak
+    };
+
+    // Checks that `Cpu` stops between the instructions of the fused pair when its budget runs out there, and that the
+    // second instruction traps in the same state as on `reference`.
+    template<typename Cpu>
+    auto CheckFusedTrap(const std::string& name, Reference& reference) -> void
+    {
+        auto cpu = RunProgram<Cpu>(basic::RAM_START, fusedLoad, 1);
+        test::Expect(!cpu->IsTrapped() && cpu->Rx(5) == basic::RAM_START + 0x8000, name + " runs just the first instruction of a fused pair");
+        sched::RunFor(*cpu, 10);
+        test::Expect(cpu->IsTrapped() && cpu->TrapCause()->type_ == TrapType::LoadAccessFault, name + " traps at the second instruction of a fused pair");
+        test::Expect(test::IsSameState(*cpu, reference), name + " traps at the second instruction of a fused pair in the same state as the reference CPU");
+
+        cpu = RunProgram<Cpu>(basic::RAM_START, fusedLoad, 10);
+        test::Expect(cpu->IsTrapped() && cpu->TrapCause()->type_ == TrapType::LoadAccessFault, name + " traps in a fused pair");
+        test::Expect(test::IsSameState(*cpu, reference), name + " traps in a fused pair in the same state as the reference CPU");
+    }
+} // namespace
+
+auto main() -> int
+{
+    const auto workloads = test::Workloads();
+    test::Expect(!workloads.empty(), "the workloads can be found");
+    for (const auto& workload : workloads)
+    {
+        if (workload.Needs('c'))
+        {
+            continue; // Blocks assume four byte instructions.
+        }
+        auto reference = test::Run<Reference>("Rv32imf", workload);
+        test::CheckWorkload<blocks::BlockCacheDispatcher<Rv32imfCpu<basic::MemoryNoIO>>>("BlockCacheDispatcher", workload, *reference);
+        test::CheckWorkload<jit::JitDispatcher<Rv32imfCpu<basic::MemoryNoIO>>>("JitDispatcher", workload, *reference);
+        test::CheckWorkload<jit::JitDispatcher<Rv32imfPreemptibleCpu<basic::MemoryNoIO>>>("JitDispatcher<Preemptible>", workload, *reference);
+    }
+
+    const auto reference = RunProgram<Reference>(selfModifyingStart, selfModifying, 10000);
+    test::Expect(reference->Rx(10) == 4951 && reference->Rx(11) == 5050, "the reference CPU runs the self-modifying program");
+    CheckSelfModifying<blocks::BlockCacheDispatcher<Rv32imfCpu<basic::MemoryNoIO>>>("BlockCacheDispatcher", *reference);
+    CheckSelfModifying<jit::JitDispatcher<Rv32imfCpu<basic::MemoryNoIO>>>("JitDispatcher", *reference);
+    CheckSelfModifying<jit::JitDispatcher<Rv32imfPreemptibleCpu<basic::MemoryNoIO>>>("JitDispatcher<Preemptible>", *reference);
+
+    const auto trapped = RunProgram<Reference>(basic::RAM_START, fusedLoad, 10);
+    test::Expect(trapped->IsTrapped() && trapped->Pc() == basic::RAM_START + 4, "the reference CPU traps at the lw");
+    CheckFusedTrap<blocks::BlockCacheDispatcher<Rv32imfCpu<basic::MemoryNoIO>>>("BlockCacheDispatcher", *trapped);
+    CheckFusedTrap<jit::JitDispatcher<Rv32imfCpu<basic::MemoryNoIO>>>("JitDispatcher", *trapped);
+    return test::failures;
+}
@@ -0,0 +1,114 @@
+#include "workloads.h"
+
+#include "arviss/arviss.h"
+#include "arviss/platforms/basic/basic.h"
+#include "arviss/platforms/flat/flat.h"
+#include "arviss/remix/remix.h"
+#include "arviss/rv32/rv32.h"
+#include "arviss/sched/scheduler.h"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Checks that a transcoded image saved to the Remix cache loads and runs to the same state as transcoding it afresh, and
+// that a cache file for a different image, made by a different kind of CPU, or cut short is ignored.
+
+using namespace arviss;
+using namespace arviss::platforms;
+
+#if defined(__unix__) || defined(__APPLE__)
+
+namespace
+{
+    using Reference = Rv32imfCpu<basic::MemoryNoIO>;
+    using Cpu = remix::ThreadedRemixDispatcher<Rv32imfCpu<basic::MemoryNoIO>>;
+
+    // Writes the first `size` bytes of the file at `from` to `to`.
+    auto Truncate(const std::string& from, const std::string& to, std::uintmax_t size) -> void
+    {
+        std::vector<char> contents(size);
+        std::ifstream(from, std::ios::binary).read(contents.data(), static_cast<std::streamsize>(size));
+        std::ofstream(to, std::ios::binary | std::ios::trunc).write(contents.data(), static_cast<std::streamsize>(size));
+    }
+
+    // Loads the cache file at `path` into a new `C` and runs it, checking that it finishes in the same state as
+    // `reference`. Flat memory has the rest of the address space mapped first, as the file only covers the image.
+    template<typename C>
+    auto CheckLoaded(const std::string& name, const std::string& path, const test::Workload& workload, Reference& reference) -> void
+    {
+        auto cpu = std::make_unique<C>();
+#if ARVISS_HAS_FLAT_MEMORY
+        if constexpr (std::derived_from<C, flat::Memory>)
+        {
+            cpu->Map(0, basic::MEM_SIZE);
+        }
+#endif
+        const auto key = remix::CacheKey(0, workload.image);
+        test::Expect(remix::LoadTranscoded(*cpu, path.c_str(), key), name + " loads the cache file for " + workload.name);
+        cpu->SetNextPc(0);
+        sched::RunFor(*cpu, workload.instructions + 1000);
+        test::Expect(test::IsSameState(*cpu, reference), name + " runs " + workload.name + " from the cache to the same state as the reference CPU");
+    }
+
+    auto CheckCache(const test::Workload& workload, const std::string& path) -> void
+    {
+        auto reference = test::Run<Reference>("Rv32imf", workload);
+        const auto key = remix::CacheKey(0, workload.image);
+        const auto size = static_cast<u32>(workload.image.size());
+
+        auto cpu = std::make_unique<Cpu>();
+        cpu->LoadImage(0, workload.image);
+        cpu->Pretranscode(0, size);
+        test::Expect(remix::SaveTranscoded(*cpu, path.c_str(), key, 0, size), "the cache file for " + workload.name + " can be saved");
+
+        CheckLoaded<Cpu>("ThreadedRemixDispatcher", path, workload, *reference);
+        CheckLoaded<remix::TailCallRemixDispatcher<Rv32imfCpu<basic::MemoryNoIO>>>("TailCallRemixDispatcher", path, workload, *reference);
+#if ARVISS_HAS_FLAT_MEMORY
+        CheckLoaded<remix::ThreadedRemixDispatcher<Rv32imfCpu<flat::Memory>>>("ThreadedRemixDispatcher<flat::Memory>", path, workload, *reference);
+#endif
+
+        auto other = std::make_unique<Cpu>();
+        test::Expect(!remix::LoadTranscoded(*other, path.c_str(), key + 1), "a cache file for " + workload.name + " isn't loaded under a different key");
+        auto rv32im = std::make_unique<remix::ThreadedRemixDispatcher<Rv32imCpu<basic::MemoryNoIO>>>();
+        test::Expect(!remix::LoadTranscoded(*rv32im, path.c_str(), key), "a cache file for " + workload.name + " isn't loaded by an RV32im CPU");
+
+        const auto truncated = path + ".truncated";
+        const auto fileSize = std::filesystem::file_size(path);
+        for (const auto cut : {fileSize - 1, std::uintmax_t{4096}, std::uintmax_t{16}})
+        {
+            Truncate(path, truncated, cut);
+            test::Expect(!remix::LoadTranscoded(*other, truncated.c_str(), key),
+                         "a cache file for " + workload.name + " cut to " + std::to_string(cut) + " bytes isn't loaded");
+        }
+        std::filesystem::remove(truncated);
+        test::Expect(!remix::LoadTranscoded(*other, (path + ".missing").c_str(), key), "a missing cache file isn't loaded");
+    }
+} // namespace
+
+auto main() -> int
+{
+    const auto path = (std::filesystem::temp_directory_path() / ("arviss_cache_test_" + std::to_string(getpid()) + ".rmx")).string();
+    const auto workloads = test::Workloads();
+    test::Expect(!workloads.empty(), "the workloads can be found");
+    for (const auto& workload : workloads)
+    {
+        if (!workload.Needs('c'))
+        {
+            CheckCache(workload, path);
+        }
+    }
+    std::filesystem::remove(path);
+    return test::failures;
+}
+
+#else
+
+auto main() -> int
+{
+    return 0; // Cache files can only be loaded on Unix-like platforms.
+}
+
+#endif
@@ -0,0 +1,105 @@
+#include "workloads.h"
+
+#include "arviss/arviss.h"
+#include "arviss/platforms/basic/basic.h"
+#include "arviss/platforms/cow/cow.h"
+#include "arviss/remix/remix.h"
+#include "arviss/rv32/rv32.h"
+#include "arviss/sched/scheduler.h"
+
+#include <memory>
+#include <string>
+
+// Checks that a CPU with copy-on-write memory and the CPUs forked from a snapshot of it don't see each other's stores,
+// and that a fork taken part way through a workload finishes it just as the original does.
+
+using namespace arviss;
+using namespace arviss::platforms;
+
+namespace
+{
+    using Reference = Rv32imfCpu<basic::MemoryNoIO>;
+
+    constexpr Address codeStart = basic::RAM_START;
+
+    // Has the guest store `value` to `address` by running `sw a0, 0(a1)` at codeStart.
+    template<typename Cpu>
+    auto Store(Cpu& cpu, Address address, u32 value) -> void
+    {
+        cpu.ClearTraps();
+        cpu.Wx(10, value);
+        cpu.Wx(11, address);
+        cpu.SetNextPc(codeStart);
+        sched::RunFor(cpu, 10);
+    }
+
+    // Checks that stores made after a fork, by the original or by a fork, are only seen by the CPU that made them. That
+    // includes stores to the page that holds the code, and to pages that haven't been written to before.
+    template<typename Cpu>
+    auto CheckPrivateStores(const std::string& name) -> void
+    {
+        auto parent = std::make_unique<Cpu>();
+        parent->Write32Unprotected(codeStart, 0x00a5a023);     // sw a0, 0(a1)
+        parent->Write32Unprotected(codeStart + 4, 0x00100073); // ebreak
+        Store(*parent, 0x5000, 1);
+        const cow::Snapshot<Cpu> snapshot(*parent);
+        auto child = snapshot.ForkUnique();
+        auto sibling = snapshot.ForkUnique();
+
+        Store(*parent, 0x5000, 2);
+        Store(*parent, 0x6000, 2);
+        Store(*parent, codeStart + 8, 2);
+        test::Expect(parent->Read32(0x5000) == 2 && parent->Read32(0x6000) == 2 && parent->Read32(codeStart + 8) == 2, name + " sees its own stores");
+        test::Expect(child->Read32(0x5000) == 1 && child->Read32(0x6000) == 0 && child->Read32(codeStart + 8) == 0,
+                     name + " fork doesn't see the original's stores after the fork");
+
+        Store(*child, 0x5000, 3);
+        Store(*child, 0x7000, 3);
+        Store(*child, codeStart + 12, 3);
+        test::Expect(child->Read32(0x5000) == 3 && child->Read32(0x7000) == 3 && child->Read32(codeStart + 12) == 3, name + " fork sees its own stores");
+        test::Expect(parent->Read32(0x5000) == 2 && parent->Read32(0x7000) == 0 && parent->Read32(codeStart + 12) == 0,
+                     name + " original doesn't see a fork's stores");
+        test::Expect(sibling->Read32(0x5000) == 1 && sibling->Read32(0x6000) == 0 && sibling->Read32(0x7000) == 0 && sibling->Read32(codeStart + 8) == 0
+                             && sibling->Read32(codeStart + 12) == 0,
+                     name + " fork doesn't see another fork's stores");
+        test::Expect(snapshot.Fork().Read32(0x5000) == 1, name + " snapshot doesn't see anyone's stores");
+    }
+
+    // Runs `workload` half way on `Cpu`, takes a snapshot, and checks that both the original and a fork finish it in
+    // the same state as `reference`.
+    template<typename Cpu>
+    auto CheckForkedWorkload(const std::string& name, const test::Workload& workload, Reference& reference) -> void
+    {
+        auto parent = std::make_unique<Cpu>();
+        parent->LoadImage(0, workload.image);
+        parent->SetNextPc(0);
+        sched::RunFor(*parent, workload.instructions / 2);
+        const cow::Snapshot<Cpu> snapshot(*parent);
+
+        sched::RunFor(*parent, workload.instructions + 1000);
+        auto child = snapshot.ForkUnique();
+        sched::RunFor(*child, workload.instructions + 1000);
+        test::Expect(test::IsSameState(*parent, reference), name + " on " + workload.name + " finishes after a fork in the same state as the reference CPU");
+        test::Expect(test::IsSameState(*child, reference), name + " fork on " + workload.name + " finishes in the same state as the reference CPU");
+    }
+} // namespace
+
+auto main() -> int
+{
+    CheckPrivateStores<Rv32imfCpu<cow::MemoryNoIO>>("Rv32imfCpu<cow::Memory>");
+    CheckPrivateStores<remix::ThreadedRemixDispatcher<Rv32imfCpu<cow::MemoryNoIO>>>("ThreadedRemixDispatcher<cow::Memory>");
+
+    const auto workloads = test::Workloads();
+    test::Expect(!workloads.empty(), "the workloads can be found");
+    for (const auto& workload : workloads)
+    {
+        if (workload.Needs('c'))
+        {
+            continue;
+        }
+        auto reference = test::Run<Reference>("Rv32imf", workload);
+        CheckForkedWorkload<Rv32imfCpu<cow::MemoryNoIO>>("Rv32imfCpu<cow::Memory>", workload, *reference);
+        CheckForkedWorkload<remix::ThreadedRemixDispatcher<Rv32imfCpu<cow::MemoryNoIO>>>("ThreadedRemixDispatcher<cow::Memory>", workload, *reference);
+    }
+    return test::failures;
+}
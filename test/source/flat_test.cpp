@@ -0,0 +1,98 @@
+#include "workloads.h"
+
+#include "arviss/arviss.h"
+#include "arviss/platforms/flat/flat.h"
+#include "arviss/remix/remix.h"
+#include "arviss/rv32/rv32.h"
+#include "arviss/sched/scheduler.h"
+
+#include <array>
+#include <memory>
+#include <string>
+
+// Checks that a guest access that faults in flat memory is raised as a trap with the right cause and address, and that
+// the CPU can carry on from the faulting instruction once the host has dealt with it.
+
+using namespace arviss;
+
+#if ARVISS_HAS_FLAT_MEMORY
+
+using namespace arviss::platforms;
+
+namespace
+{
+    // A program in a read-only page at 0x1000 that loads from an unmapped page, stores to its own page, and then jumps
+    // to another unmapped page.
+    constexpr Address codeStart = 0x1000;
+    constexpr std::array<u32, 6> program = {
+            0x000034b7, // lui s1, 0x3          ; s1 = 0x3000, which isn't mapped yet
+            0x0004a503, // lw a0, 0(s1)
+            0x00001937, // lui s2, 0x1          ; s2 = 0x1000, which is read-only
+            0x00a92023, // sw a0, 0(s2)
+            0x000049b7, // lui s3, 0x4          ; s3 = 0x4000, which isn't mapped yet
+            0x000980e7, // jalr ra, 0(s3)
+    };
+
+    // Runs `cpu` until it stops, and checks that it trapped with `type` at `pc` with `address` as the trap's context.
+    template<typename Cpu>
+    auto ExpectTrap(Cpu& cpu, TrapType type, Address pc, Address address, const std::string& what) -> void
+    {
+        const auto result = sched::RunUntilStopped(cpu, 100);
+        test::Expect(result.reason == sched::StopReason::Trapped && result.trap && result.trap->type_ == type && result.trap->context_ == address,
+                     what + " raises the right trap");
+        test::Expect(cpu.Pc() == pc, what + " leaves the pc at the faulting instruction");
+    }
+
+    // Checks each kind of fault on `Cpu`, carrying on after each of them.
+    template<typename Cpu>
+    auto CheckFaults(const std::string& name) -> void
+    {
+        auto cpu = std::make_unique<Cpu>();
+        cpu->Map(codeStart, 0x1000, false);
+        for (u32 i = 0; i < program.size(); i++)
+        {
+            cpu->Write32Unprotected(codeStart + 4 * i, program[i]);
+        }
+        cpu->SetNextPc(codeStart);
+
+        ExpectTrap(*cpu, TrapType::LoadAccessFault, codeStart + 4, 0x3000, name + " loading from unmapped memory");
+
+        // Map the page and try the load again.
+        cpu->Map(0x3000, 0x1000);
+        cpu->Write32Unprotected(0x3000, 42);
+        cpu->ClearTraps();
+        cpu->SetNextPc(cpu->Pc());
+        ExpectTrap(*cpu, TrapType::StoreAccessFault, codeStart + 12, codeStart, name + " storing to read-only memory");
+        test::Expect(cpu->Rx(10) == 42, name + " loads from memory once it's mapped");
+
+        // Skip the store.
+        cpu->ClearTraps();
+        cpu->SetNextPc(cpu->Pc() + 4);
+        ExpectTrap(*cpu, TrapType::InstructionAccessFault, 0x4000, 0x4000, name + " jumping to unmapped memory");
+        test::Expect(cpu->Read32(codeStart) != 42, name + " doesn't store to read-only memory");
+
+        // Map an ebreak there and try the fetch again.
+        cpu->Map(0x4000, 0x1000, false);
+        cpu->Write32Unprotected(0x4000, 0x00100073);
+        cpu->ClearTraps();
+        cpu->SetNextPc(cpu->Pc());
+        ExpectTrap(*cpu, TrapType::Breakpoint, 0x4000, 0, name + " fetching from memory once it's mapped");
+    }
+} // namespace
+
+auto main() -> int
+{
+    CheckFaults<Rv32imfCpu<flat::Memory>>("Rv32imfCpu<flat::Memory>");
+    CheckFaults<remix::ThreadedRemixDispatcher<Rv32imfCpu<flat::Memory>>>("ThreadedRemixDispatcher<flat::Memory>");
+    CheckFaults<remix::TailCallRemixDispatcher<Rv32imfCpu<flat::Memory>>>("TailCallRemixDispatcher<flat::Memory>");
+    return test::failures;
+}
+
+#else
+
+auto main() -> int
+{
+    return 0; // There's no flat memory on this platform.
+}
+
+#endif // ARVISS_HAS_FLAT_MEMORY
@@ -0,0 +1,72 @@
+#include "workloads.h"
+
+#include "arviss/arviss.h"
+#include "arviss/platforms/basic/basic.h"
+#include "arviss/profile/profiler.h"
+#include "arviss/rv32/rv32.h"
+
+#include <limits>
+#include <string>
+
+// Checks that the profiler counts every instruction that the plain dispatchers retire exactly once, and that each
+// conditional branch is counted as either taken or not taken every time that it's executed.
+
+using namespace arviss;
+using namespace arviss::platforms;
+
+namespace
+{
+    using Profiler = profile::Profiler<basic::MEM_SIZE>;
+
+    template<HasMemory Mem>
+    using Rv32imfProfiledCpu = Rv32imfDispatcher<Rv32imfExecutor<FloatCore<Mem>, Profiler>>;
+
+    template<HasMemory Mem>
+    using Rv32icProfiledCpu = Rv32icDispatcher<Rv32icExecutor<IntegerCore<Mem, true>, Profiler>>;
+
+    template<typename Cpu>
+    auto CheckProfile(const std::string& name, const test::Workload& workload) -> void
+    {
+        const auto cpu = test::Run<Cpu>(name, workload);
+        const auto& profiler = cpu->Instrumentation();
+        const auto what = name + " on " + workload.name;
+
+        u64 executed = 0;
+        bool isBranchCounted = true;
+        for (Address pc = 0; pc < basic::MEM_SIZE; pc += 2)
+        {
+            const auto counts = profiler.At(pc);
+            executed += counts.executed;
+            const auto branches = counts.taken + counts.notTaken;
+            isBranchCounted = isBranchCounted && (branches == 0 || branches == counts.executed);
+        }
+        test::Expect(executed == workload.instructions, what + " counts each retired instruction once");
+        test::Expect(profiler.Executed() == workload.instructions, what + " reports the number of retired instructions");
+        test::Expect(isBranchCounted, what + " counts each conditional branch as taken or not taken");
+
+        u64 inBlocks = 0;
+        for (const auto& block : profiler.HotBlocks(std::numeric_limits<size_t>::max()))
+        {
+            inBlocks += block.instructions;
+        }
+        test::Expect(inBlocks == workload.instructions, what + " accounts for every instruction in its blocks");
+    }
+} // namespace
+
+auto main() -> int
+{
+    const auto workloads = test::Workloads();
+    test::Expect(!workloads.empty(), "the workloads can be found");
+    for (const auto& workload : workloads)
+    {
+        if (workload.Needs('c'))
+        {
+            CheckProfile<Rv32icProfiledCpu<basic::MemoryNoIO>>("Rv32icDispatcher<Profiler>", workload);
+        }
+        else
+        {
+            CheckProfile<Rv32imfProfiledCpu<basic::MemoryNoIO>>("Rv32imfDispatcher<Profiler>", workload);
+        }
+    }
+    return test::failures;
+}
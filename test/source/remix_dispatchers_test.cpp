@@ -0,0 +1,146 @@
+#include "workloads.h"
+
+#include "arviss/arviss.h"
+#include "arviss/platforms/basic/basic.h"
+#include "arviss/platforms/cow/cow.h"
+#include "arviss/platforms/flat/flat.h"
+#include "arviss/platforms/mapped/mapped.h"
+#include "arviss/remix/remix.h"
+#include "arviss/rv32/rv32.h"
+#include "arviss/sched/scheduler.h"
+
+#include <array>
+#include <memory>
+#include <string>
+
+// Checks that the Remix dispatchers, and the cores and memories that they're built on, run the workloads to the same
+// state as a plain RV32imf CPU, or a plain RV32ic CPU for compressed workloads, that they stop when they're asked to,
+// and that the shadowed ones keep their promises to self-modifying code.
+
+using namespace arviss;
+using namespace arviss::platforms;
+
+namespace
+{
+    using Reference = Rv32imfCpu<basic::MemoryNoIO>;
+
+    // An RV32imf CPU whose dispatcher advances its program counter.
+    template<HasMemory Mem>
+    using Rv32imfSequentialCpu = Rv32imfDispatcher<Rv32imfExecutor<SequentialFloatCore<Mem>>>;
+
+    // An RV32imf CPU with stop events.
+    template<HasMemory Mem>
+    using Rv32imfPreemptibleCpu = Rv32imfDispatcher<Rv32imfExecutor<Preemptible<FloatCore<Mem>>>>;
+
+    // An RV32imf CPU that doesn't keep x0 at zero, for the Remix dispatchers.
+    template<HasMemory Mem>
+    using Rv32imfZeroSinkCpu = Rv32imfDispatcher<Rv32imfExecutor<ZeroSink<FloatCore<Mem>>>>;
+
+    // Checks that `Cpu` stops when it's asked to, and that the request doesn't outlive the run that acted on it.
+    template<typename Cpu>
+    auto CheckStopRequest(const std::string& name, const test::Workload& workload) -> void
+    {
+        auto cpu = std::make_unique<Cpu>();
+        cpu->LoadImage(0, workload.image);
+        cpu->SetNextPc(0);
+
+        cpu->RequestStop();
+        auto result = sched::RunUntilStopped(*cpu, 1000);
+        test::Expect(result.reason == sched::StopReason::Requested && result.retired == 0, name + " stops when it's asked to");
+        result = sched::RunUntilStopped(*cpu, 1000);
+        test::Expect(result.reason == sched::StopReason::BudgetExhausted && result.retired == 1000, name + " runs again once it has stopped");
+
+        cpu->RequestStop();
+        result = sched::RunUntilStopped(*cpu, 0);
+        test::Expect(result.reason == sched::StopReason::BudgetExhausted, name + " doesn't report a request that didn't stop it");
+        result = sched::RunUntilStopped(*cpu, 1000);
+        test::Expect(result.reason == sched::StopReason::BudgetExhausted && result.retired == 1000, name + " clears a request that didn't stop it");
+    }
+
+    // Checks that a shadowed `Cpu` lets the guest read back its own instructions once they've been transcoded, and that
+    // it transcodes an instruction again after the guest has overwritten it.
+    template<typename Cpu>
+    auto CheckShadowedCode(const std::string& name) -> void
+    {
+        constexpr std::array<u32, 11> program = {
+                0x00004437, // lui s0, 0x4        ; s0 = RAM_START
+                0x01c000ef, // jal ra, 0x4020     ; a0 = 1
+                0x02442583, // lw a1, 0x24(s0)    ; a1 = the ret at 0x4024
+                0x02042603, // lw a2, 0x20(s0)    ; a2 = the addi at 0x4020
+                0x02842283, // lw t0, 0x28(s0)
+                0x02542023, // sw t0, 0x20(s0)    ; overwrite the addi at 0x4020
+                0x008000ef, // jal ra, 0x4020     ; a0 = 101
+                0x00100073, // ebreak
+                0x00150513, // addi a0, a0, 1     ; 0x4020
+                0x00008067, // ret
+                0x06450513, // addi a0, a0, 100   ; what replaces the addi at 0x4020
+        };
+        auto cpu = std::make_unique<Cpu>();
+        for (u32 i = 0; i < program.size(); i++)
+        {
+            cpu->Write32Unprotected(basic::RAM_START + 4 * i, program[i]);
+        }
+        cpu->SetNextPc(basic::RAM_START);
+        sched::RunFor(*cpu, 100);
+        test::Expect(cpu->IsTrapped() && cpu->TrapCause()->type_ == TrapType::Breakpoint, name + " reaches the ebreak");
+        test::Expect(cpu->Rx(11) == program[9] && cpu->Rx(12) == program[8], name + " reads back its own code as RV32 instructions");
+        test::Expect(cpu->Rx(10) == 101, name + " transcodes code again after it's overwritten");
+    }
+} // namespace
+
+auto main() -> int
+{
+    const auto workloads = test::Workloads();
+    test::Expect(!workloads.empty(), "the workloads can be found");
+    for (const auto& workload : workloads)
+    {
+        if (workload.Needs('c'))
+        {
+            // Compressed code can't be transcoded in place, so these keep their Remix words in the side table.
+            auto reference = test::Run<Rv32icCpu<basic::MemoryNoIO>>("Rv32ic", workload);
+            test::CheckWorkload<remix::RemixDispatcher<Rv32icCpu<basic::MemoryNoIO>>>("RemixDispatcher<Rv32ic>", workload, *reference);
+            test::CheckWorkload<remix::ThreadedRemixDispatcher<Rv32icCpu<basic::MemoryNoIO>>>("ThreadedRemixDispatcher<Rv32ic>", workload, *reference);
+            test::CheckWorkload<remix::TailCallRemixDispatcher<Rv32icCpu<basic::MemoryNoIO>>>("TailCallRemixDispatcher<Rv32ic>", workload, *reference);
+            continue;
+        }
+        auto reference = test::Run<Reference>("Rv32imf", workload);
+
+        test::CheckWorkload<remix::RemixDispatcher<Rv32imfCpu<basic::MemoryNoIO>>>("RemixDispatcher", workload, *reference);
+        test::CheckWorkload<remix::ThreadedRemixDispatcher<Rv32imfCpu<basic::MemoryNoIO>>>("ThreadedRemixDispatcher", workload, *reference);
+        test::CheckWorkload<remix::ThreadedRemixDispatcher<Rv32imfCpu<basic::MemoryNoIO>, true>>("ThreadedRemixDispatcher<shadowed>", workload, *reference);
+        test::CheckWorkload<remix::TailCallRemixDispatcher<Rv32imfCpu<basic::MemoryNoIO>>>("TailCallRemixDispatcher", workload, *reference);
+
+        test::CheckWorkload<Rv32imfSequentialCpu<basic::MemoryNoIO>>("Rv32imfDispatcher<SequentialCore>", workload, *reference);
+        test::CheckWorkload<remix::TailCallRemixDispatcher<Rv32imfSequentialCpu<basic::MemoryNoIO>>>("TailCallRemixDispatcher<SequentialCore>", workload,
+                                                                                                *reference);
+        test::CheckWorkload<Rv32imfPreemptibleCpu<basic::MemoryNoIO>>("Rv32imfDispatcher<Preemptible>", workload, *reference);
+        test::CheckWorkload<remix::ThreadedRemixDispatcher<Rv32imfPreemptibleCpu<basic::MemoryNoIO>>>("ThreadedRemixDispatcher<Preemptible>", workload,
+                                                                                                 *reference);
+        test::CheckWorkload<remix::TailCallRemixDispatcher<Rv32imfPreemptibleCpu<basic::MemoryNoIO>>>("TailCallRemixDispatcher<Preemptible>", workload,
+                                                                                                 *reference);
+        test::CheckWorkload<remix::ThreadedRemixDispatcher<Rv32imfZeroSinkCpu<basic::MemoryNoIO>>>("ThreadedRemixDispatcher<ZeroSink>", workload, *reference);
+        test::CheckWorkload<remix::TailCallRemixDispatcher<Rv32imfZeroSinkCpu<basic::MemoryNoIO>>>("TailCallRemixDispatcher<ZeroSink>", workload, *reference);
+
+        test::CheckWorkload<Rv32imfCpu<basic::NonThrowingMemoryNoIO>>("Rv32imfDispatcher<NonThrowingMemory>", workload, *reference);
+        test::CheckWorkload<remix::ThreadedRemixDispatcher<Rv32imfCpu<basic::NonThrowingMemoryNoIO>>>("ThreadedRemixDispatcher<NonThrowingMemory>", workload,
+                                                                                                 *reference);
+        test::CheckWorkload<remix::ThreadedRemixDispatcher<Rv32imfCpu<cow::MemoryNoIO>>>("ThreadedRemixDispatcher<cow::Memory>", workload, *reference);
+        test::CheckWorkload<remix::ThreadedRemixDispatcher<Rv32imfCpu<mapped::BasicMemoryNoIO>>>("ThreadedRemixDispatcher<mapped::BasicMemory>", workload,
+                                                                                            *reference);
+#if ARVISS_HAS_FLAT_MEMORY
+        test::CheckWorkload<remix::ThreadedRemixDispatcher<Rv32imfCpu<flat::Memory>>>("ThreadedRemixDispatcher<flat::Memory>", workload, *reference);
+#endif
+    }
+
+    CheckShadowedCode<remix::RemixDispatcher<Rv32imfCpu<basic::MemoryNoIO>, true>>("RemixDispatcher<shadowed>");
+    CheckShadowedCode<remix::ThreadedRemixDispatcher<Rv32imfCpu<basic::MemoryNoIO>, true>>("ThreadedRemixDispatcher<shadowed>");
+    CheckShadowedCode<remix::TailCallRemixDispatcher<Rv32imfCpu<basic::MemoryNoIO>, true>>("TailCallRemixDispatcher<shadowed>");
+
+    if (!workloads.empty())
+    {
+        CheckStopRequest<Rv32imfPreemptibleCpu<basic::MemoryNoIO>>("Rv32imfDispatcher<Preemptible>", workloads.front());
+        CheckStopRequest<remix::ThreadedRemixDispatcher<Rv32imfPreemptibleCpu<basic::MemoryNoIO>>>("ThreadedRemixDispatcher<Preemptible>", workloads.front());
+        CheckStopRequest<remix::TailCallRemixDispatcher<Rv32imfPreemptibleCpu<basic::MemoryNoIO>>>("TailCallRemixDispatcher<Preemptible>", workloads.front());
+    }
+    return test::failures;
+}
@@ -0,0 +1,78 @@
+#include "workloads.h"
+
+#include "arviss/arviss.h"
+#include "arviss/platforms/basic/basic.h"
+#include "arviss/rv32/rv32.h"
+#include "arviss/sched/scheduler.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+// Checks that running many CPUs on a pool of workers, with short quanta so that they're preempted, moved between
+// queues and stolen often, leaves each of them in the same state as running it on its own.
+
+using namespace arviss;
+using namespace arviss::platforms;
+
+namespace
+{
+    // An RV32imf CPU with stop events, which the scheduler preempts.
+    template<HasMemory Mem>
+    using Rv32imfPreemptibleCpu = Rv32imfDispatcher<Rv32imfExecutor<Preemptible<FloatCore<Mem>>>>;
+
+    constexpr size_t copies = 8; // How many CPUs run each workload.
+
+    // Runs `copies` of each workload on `Cpu` on a scheduler with several workers, and checks every completion against
+    // the same workload run single-threaded.
+    template<typename Cpu>
+    auto CheckScheduled(const std::string& name, const std::vector<test::Workload>& workloads) -> void
+    {
+        std::map<sched::JobId, const test::Workload*> jobs;
+        std::map<const test::Workload*, std::unique_ptr<Cpu>> references;
+        sched::Scheduler<Cpu> scheduler(4, 1000);
+        for (const auto& workload : workloads)
+        {
+            references[&workload] = test::Run<Cpu>(name, workload);
+            for (size_t i = 0; i < copies; i++)
+            {
+                auto cpu = std::make_unique<Cpu>();
+                cpu->LoadImage(0, workload.image);
+                cpu->SetNextPc(0);
+                jobs[scheduler.Submit(std::move(cpu), workload.instructions + 1000)] = &workload;
+            }
+        }
+        if constexpr (HasStopEvents<Cpu>)
+        {
+            scheduler.Preempt();
+        }
+
+        size_t completed = 0;
+        while (auto completion = scheduler.WaitForCompletion())
+        {
+            ++completed;
+            const auto& workload = *jobs.at(completion->id);
+            const auto what = name + " on " + workload.name + " (job " + std::to_string(completion->id) + ")";
+            test::Expect(!completion->error && completion->trap && completion->trap->type_ == TrapType::Breakpoint, what + " reaches its ebreak");
+            test::Expect(completion->executed == workload.instructions, what + " retires the expected number of instructions");
+            test::Expect(test::IsSameState(*completion->cpu, *references.at(&workload)), what + " finishes in the same state as a single-threaded run");
+        }
+        test::Expect(completed == jobs.size(), name + " completes every job");
+    }
+} // namespace
+
+auto main() -> int
+{
+    std::vector<test::Workload> workloads;
+    for (auto& workload : test::Workloads())
+    {
+        if (!workload.Needs('c'))
+        {
+            workloads.push_back(std::move(workload));
+        }
+    }
+    test::Expect(!workloads.empty(), "the workloads can be found");
+    CheckScheduled<Rv32imfCpu<basic::MemoryNoIO>>("Rv32imfCpu", workloads);
+    CheckScheduled<Rv32imfPreemptibleCpu<basic::MemoryNoIO>>("Rv32imfDispatcher<Preemptible>", workloads);
+    return test::failures;
+}
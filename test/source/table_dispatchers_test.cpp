@@ -0,0 +1,110 @@
+#include "workloads.h"
+
+#include "arviss/arviss.h"
+#include "arviss/blocks/decoder.h"
+#include "arviss/platforms/basic/basic.h"
+#include "arviss/rv32/disassemblers.h"
+#include "arviss/rv32/rv32.h"
+#include "arviss/sched/scheduler.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// Checks that the table-driven dispatchers decode every instruction in the same way as the cascaded ones, and that
+// CPUs built on them run the workloads to the same state.
+
+using namespace arviss;
+using namespace arviss::platforms;
+
+namespace
+{
+    using blocks::DecodedOp;
+
+    // Returns a word for every combination of opcode, funct3 and funct7, with the register fields filled in at random,
+    // followed by every 16-bit word, i.e., every compressed instruction.
+    auto Words() -> std::vector<u32>
+    {
+        std::vector<u32> words;
+        std::mt19937 random(1234);
+        for (u32 opcode = 0; opcode < 0x80; opcode++)
+        {
+            for (u32 funct3 = 0; funct3 < 8; funct3++)
+            {
+                for (u32 funct7 = 0; funct7 < 0x80; funct7++)
+                {
+                    for (int i = 0; i < 4; i++)
+                    {
+                        const auto registers = static_cast<u32>(random()) & 0x01ff8f80; // rd, rs1 and rs2.
+                        words.push_back((funct7 << 25) | (funct3 << 12) | opcode | registers);
+                    }
+                }
+            }
+        }
+        for (u32 word = 0; word < 0x10000; word++)
+        {
+            words.push_back(word);
+        }
+        return words;
+    }
+
+    auto Same(const DecodedOp& a, const DecodedOp& b) -> bool
+    {
+        return a.opc == b.opc && a.rd == b.rd && a.rs1 == b.rs1 && a.rs2 == b.rs2 && a.imm == b.imm;
+    }
+
+    // Decodes every word with both dispatchers, which must give the same result.
+    template<typename Cascaded, typename Table>
+    auto CheckDecoding(const std::string& name, const std::vector<u32>& words, auto same) -> void
+    {
+        Cascaded cascaded;
+        Table table;
+        size_t mismatches = 0;
+        for (const auto word : words)
+        {
+            if (!same(cascaded.Dispatch(word), table.Dispatch(word)) && ++mismatches <= 10)
+            {
+                test::Expect(false, name + " decodes " + std::to_string(word) + " differently");
+            }
+        }
+        test::Expect(mismatches == 0, name + " has " + std::to_string(mismatches) + " mismatches");
+    }
+
+    // Runs `workload` on both CPUs, which must finish in the same state.
+    template<typename Cascaded, typename Table>
+    auto CheckWorkload(const std::string& name, const test::Workload& workload) -> void
+    {
+        const auto cascaded = test::Run<Cascaded>(name, workload);
+        test::CheckWorkload<Table>(name + " (table)", workload, *cascaded);
+    }
+} // namespace
+
+auto main() -> int
+{
+    const auto words = Words();
+    CheckDecoding<Rv32iDispatcher<blocks::Rv32iPredecoder>, Rv32iTableDispatcher<blocks::Rv32iPredecoder>>("Rv32i", words, Same);
+    CheckDecoding<Rv32imDispatcher<blocks::Rv32imPredecoder>, Rv32imTableDispatcher<blocks::Rv32imPredecoder>>("Rv32im", words, Same);
+    CheckDecoding<Rv32imfDispatcher<blocks::Rv32imfPredecoder>, Rv32imfTableDispatcher<blocks::Rv32imfPredecoder>>("Rv32imf", words, Same);
+    CheckDecoding<Rv32icDispatcher<Rv32icDisassemblingHandler>, Rv32icTableDispatcher<Rv32icDisassemblingHandler>>(
+            "Rv32ic", words, [](const std::string& a, const std::string& b) { return a == b; });
+
+    const auto workloads = test::Workloads();
+    test::Expect(!workloads.empty(), "the workloads can be found");
+    for (const auto& workload : workloads)
+    {
+        if (workload.Needs('c'))
+        {
+            CheckWorkload<Rv32icCpu<basic::MemoryNoIO>, Rv32icTableCpu<basic::MemoryNoIO>>("Rv32ic", workload);
+            continue;
+        }
+        if (!workload.Needs('f'))
+        {
+            CheckWorkload<Rv32iCpu<basic::MemoryNoIO>, Rv32iTableCpu<basic::MemoryNoIO>>("Rv32i", workload);
+            CheckWorkload<Rv32imCpu<basic::MemoryNoIO>, Rv32imTableCpu<basic::MemoryNoIO>>("Rv32im", workload);
+            CheckWorkload<Rv32icCpu<basic::MemoryNoIO>, Rv32icTableCpu<basic::MemoryNoIO>>("Rv32ic", workload);
+        }
+        CheckWorkload<Rv32imfCpu<basic::MemoryNoIO>, Rv32imfTableCpu<basic::MemoryNoIO>>("Rv32imf", workload);
+    }
+    return test::failures;
+}
@@ -0,0 +1,81 @@
+#include "workloads.h"
+
+#include "arviss/arviss.h"
+#include "arviss/platforms/basic/basic.h"
+#include "arviss/rv32/rv32.h"
+#include "arviss/wide/wide.h"
+
+#include <memory>
+#include <string>
+
+// Checks that every lane of a wide CPU runs the workloads to the same state as a plain RV32im CPU, and that a lane that
+// jumps to an address that isn't word aligned traps.
+
+using namespace arviss;
+using namespace arviss::platforms;
+
+namespace
+{
+    using Wide = wide::WideCpu<basic::MemoryNoIO, 4>;
+
+    // Runs `workload` on every lane and compares each of them with `reference`.
+    auto CheckWorkload(const test::Workload& workload, Rv32imCpu<basic::MemoryNoIO>& reference) -> void
+    {
+        auto cpu = std::make_unique<Wide>();
+        for (size_t lane = 0; lane < Wide::lanes; lane++)
+        {
+            cpu->Memory(lane).LoadImage(0, workload.image);
+        }
+        cpu->SetNextPc(0);
+        cpu->Run(workload.instructions + 1000);
+        for (size_t lane = 0; lane < Wide::lanes; lane++)
+        {
+            const auto what = "lane " + std::to_string(lane) + " on " + workload.name;
+            test::Expect(cpu->IsTrapped(lane) && cpu->TrapCause(lane)->type_ == TrapType::Breakpoint, what + " reaches its ebreak");
+            bool same = cpu->Pc(lane) == reference.Pc();
+            for (Reg r = 0; r < 32; r++)
+            {
+                same = same && cpu->Rx(lane, r) == reference.Rx(r);
+            }
+            test::Expect(same, what + " finishes in the same state as the reference CPU");
+        }
+    }
+
+    // Only the lanes whose x1 is odd jump to a halfword boundary, and only they trap on it.
+    auto CheckMisalignedJump() -> void
+    {
+        constexpr u32 jalr = 0x00008067; // jalr x0, 0(x1)
+        constexpr u32 ebreak = 0x00100073;
+        auto cpu = std::make_unique<Wide>();
+        for (size_t lane = 0; lane < Wide::lanes; lane++)
+        {
+            cpu->Memory(lane).Write32Unprotected(0x100, jalr);
+            cpu->Memory(lane).Write32Unprotected(0x104, ebreak);
+            cpu->Wx(lane, 1, lane % 2 == 0 ? 0x104 : 0x106);
+        }
+        cpu->SetNextPc(0x100);
+        cpu->Run(10);
+        for (size_t lane = 0; lane < Wide::lanes; lane++)
+        {
+            const auto expected = lane % 2 == 0 ? TrapType::Breakpoint : TrapType::InstructionAddressMisaligned;
+            test::Expect(cpu->IsTrapped(lane) && cpu->TrapCause(lane)->type_ == expected, "lane " + std::to_string(lane) + " traps as expected after jalr");
+        }
+    }
+} // namespace
+
+auto main() -> int
+{
+    const auto workloads = test::Workloads();
+    test::Expect(!workloads.empty(), "the workloads can be found");
+    for (const auto& workload : workloads)
+    {
+        if (workload.Needs('c') || workload.Needs('f'))
+        {
+            continue;
+        }
+        auto reference = test::Run<Rv32imCpu<basic::MemoryNoIO>>("Rv32im", workload);
+        CheckWorkload(workload, *reference);
+    }
+    CheckMisalignedJump();
+    return test::failures;
+}
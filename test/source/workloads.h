@@ -0,0 +1,122 @@
+#pragma once
+
+#include "arviss/arviss.h"
+#include "arviss/platforms/basic/basic.h"
+#include "arviss/platforms/flat/flat.h"
+#include "arviss/sched/scheduler.h"
+
+#include <bit>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace arviss::test
+{
+    // A prebuilt workload from riscv-examples/images. It's loaded at address 0, and it ends with an ebreak, leaving a
+    // checksum in a0.
+    struct Workload
+    {
+        std::string name;
+        std::string needs;      // The smallest instruction set that will run it, e.g., "rv32ic".
+        u32 checksum;           // What it leaves in a0.
+        size_t instructions;    // How many instructions it retires to get there, including the ebreak.
+        std::vector<u8> image;  // The image itself.
+
+        auto Needs(char extension) const -> bool { return needs.find(extension, 4) != std::string::npos; }
+    };
+
+    // Returns the workloads listed in ARVISS_WORKLOADS_DIR/expected.txt.
+    inline auto Workloads() -> std::vector<Workload>
+    {
+        const std::string dir = ARVISS_WORKLOADS_DIR;
+        std::vector<Workload> workloads;
+        std::ifstream expected(dir + "/expected.txt");
+        std::string line;
+        while (std::getline(expected, line))
+        {
+            std::istringstream fields(line);
+            Workload workload;
+            if (line.starts_with('#') || !(fields >> workload.name >> workload.needs >> std::hex >> workload.checksum >> std::dec >> workload.instructions))
+            {
+                continue;
+            }
+            std::ifstream file(dir + "/" + workload.name, std::ios::binary | std::ios::ate);
+            workload.image.resize(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(workload.image.data()), static_cast<std::streamsize>(workload.image.size()));
+            workloads.push_back(std::move(workload));
+        }
+        return workloads;
+    }
+
+    // The number of checks that have failed so far. A test returns it from main() so that CTest sees the failure.
+    inline int failures = 0;
+
+    // Reports `what` if `ok` is false.
+    inline auto Expect(bool ok, std::string_view what) -> void
+    {
+        if (!ok)
+        {
+            std::cerr << "FAILED: " << what << '\n';
+            ++failures;
+        }
+    }
+
+    // Loads `workload` into a new `Cpu` and runs it to its ebreak, checking its result, and returns the CPU. Flat
+    // memory is mapped first, as it has nothing mapped to begin with. The number of instructions retired is only checked
+    // if `Cpu` counts them.
+    template<typename Cpu>
+    auto Run(const std::string& name, const Workload& workload) -> std::unique_ptr<Cpu>
+    {
+        auto cpu = std::make_unique<Cpu>();
+#if ARVISS_HAS_FLAT_MEMORY
+        if constexpr (std::derived_from<Cpu, platforms::flat::Memory>)
+        {
+            cpu->Map(0, platforms::basic::MEM_SIZE);
+        }
+#endif
+        cpu->LoadImage(0, workload.image);
+        cpu->SetNextPc(0);
+        const auto retired = sched::RunFor(*cpu, workload.instructions + 1000);
+        const auto what = name + " on " + workload.name;
+        Expect(cpu->IsTrapped() && cpu->TrapCause()->type_ == TrapType::Breakpoint, what + " reaches its ebreak");
+        Expect(cpu->Rx(10) == workload.checksum, what + " leaves the checksum in a0");
+        if constexpr (!sched::impl::HasOwnRunLoop<Cpu> || sched::impl::HasCountedRunLoop<Cpu>)
+        {
+            Expect(retired == workload.instructions, what + " retires the expected number of instructions");
+        }
+        return cpu;
+    }
+
+    // Returns true if `cpu` has the same pc and registers as `reference`. Float registers are only compared if both
+    // have them.
+    template<typename Cpu, typename Reference>
+    auto IsSameState(Cpu& cpu, Reference& reference) -> bool
+    {
+        bool same = cpu.Pc() == reference.Pc();
+        for (Reg r = 0; r < 32; r++)
+        {
+            same = same && cpu.Rx(r) == reference.Rx(r);
+        }
+        if constexpr (IsFloatCore<Cpu> && IsFloatCore<Reference>)
+        {
+            for (Reg r = 0; r < 32; r++)
+            {
+                same = same && std::bit_cast<u32>(cpu.Rf(r)) == std::bit_cast<u32>(reference.Rf(r));
+            }
+        }
+        return same;
+    }
+
+    // Runs `workload` on `Cpu`, which must finish in the same state as `reference` did.
+    template<typename Cpu, typename Reference>
+    auto CheckWorkload(const std::string& name, const Workload& workload, Reference& reference) -> void
+    {
+        const auto cpu = Run<Cpu>(name, workload);
+        Expect(IsSameState(*cpu, reference), name + " on " + workload.name + " finishes in the same state as the reference CPU");
+    }
+} // namespace arviss::test
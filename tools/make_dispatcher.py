@@ -369,6 +369,23 @@ where
     print(postamble)
 
 
+def cpp_handler_call(operator: str, operands: Tuple[str]) -> str:
+    """Returns the C++ expression that calls the handler for an instruction."""
+
+    operator = operator.replace(".", "_")
+    parts = operator.split(".")
+    parts[-1] = parts[-1].capitalize()
+    operator = ".".join(parts)
+
+    operands = lut.get(" ".join(operands), "")
+    operands = ", ".join(
+        ["c." + op.capitalize() for op in operands.split(", ")]
+        if len(operands) > 0
+        else []
+    )
+    return f"self.{operator}({operands})"
+
+
 def generate_cpp(specs: List[Spec], extensions: str):
     """Generates a C++ dispatcher that uses switch statements."""
 
@@ -431,26 +448,196 @@ struct Rv32{extensions}Dispatcher : public Handler
         for value, operator, operands in v:
             match_value = make_bitpattern(k, value)
 
-            operator = operator.replace(".", "_")
-            parts = operator.split(".")
-            parts[-1] = parts[-1].capitalize()
-            operator = ".".join(parts)
-
-            operands = lut.get(" ".join(operands), "")
-            operands = ", ".join(
-                ["c." + op.capitalize() for op in operands.split(", ")]
-                if len(operands) > 0
-                else []
-            )
             width = 8 if (match_value & 3) == 3 else 4
             print(
-                f"            case 0x{match_value:0{width}x}: return self.{operator}({operands});"
+                f"            case 0x{match_value:0{width}x}: return {cpp_handler_call(operator, operands)};"
             )
         # print("            _ => {}")
         print("        }")
     print(postamble)
 
 
+def fixed_bits(spec: Spec) -> Tuple[int, int]:
+    """Returns the mask of the bits that are fixed by a spec's bit patterns, and the values of those bits."""
+
+    bits = tuple((pattern.hi, pattern.lo) for pattern in spec.patterns)
+    values = tuple(pattern.value for pattern in spec.patterns)
+    return make_bitmask(bits), make_bitpattern(bits, values)
+
+
+def bit_fields(bits: List[int], max_fields: int) -> List[Tuple[int, int]]:
+    """Turns a set of bit positions into at most `max_fields` contiguous (hi, lo) fields, widening them if necessary."""
+
+    fields = []
+    for bit in sorted(bits):
+        if fields and fields[-1][0] == bit - 1:
+            fields[-1] = (bit, fields[-1][1])
+        else:
+            fields.append((bit, bit))
+    while len(fields) > max_fields:
+        # Merge the two fields with the smallest gap between them.
+        gaps = [fields[i + 1][1] - fields[i][0] for i in range(len(fields) - 1)]
+        i = gaps.index(min(gaps))
+        fields[i : i + 2] = [(fields[i + 1][0], fields[i][1])]
+    return fields
+
+
+def field_value(code: int, fields: List[Tuple[int, int]]) -> int:
+    """Extracts the given fields from an instruction, concatenating them with the lowest field in the lowest bits."""
+
+    result, width = 0, 0
+    for hi, lo in fields:
+        result |= ((code >> lo) & ((1 << (hi - lo + 1)) - 1)) << width
+        width += hi - lo + 1
+    return result
+
+
+def make_decode_table(candidates: List[Tuple[int, int, int, int]], level1_mask: int):
+    """
+    Builds the second-level table for the instructions in a single first-level bucket. Each candidate is a tuple of
+    (priority, index, mask, match). The table is indexed by just enough bits to pick the candidate that the cascaded
+    switch dispatcher would pick, so that a leaf only has to confirm the instruction's remaining fixed bits.
+    """
+
+    # Start with the bits where the candidates disagree.
+    key = set()
+    for _, _, mask_a, match_a in candidates:
+        for _, _, mask_b, match_b in candidates:
+            key |= {n for n in range(32) if (mask_a & mask_b & (match_a ^ match_b) & ~level1_mask) >> n & 1}
+
+    while True:
+        fields = bit_fields(key, 2)
+        key_bits = make_bitmask(fields)
+        table_size = 1 << sum(hi - lo + 1 for hi, lo in fields)
+        table = []
+        extra = set()
+        for value in range(table_size):
+            # Find the candidates whose fixed key bits match this entry.
+            code = 0
+            for bit in range(32):
+                if key_bits >> bit & 1:
+                    code |= (value >> sum(1 for b in range(bit) if key_bits >> b & 1) & 1) << bit
+            matching = sorted(c for c in candidates if (code & c[2] & key_bits) == (c[3] & key_bits))
+            if not matching:
+                table.append(None)
+                continue
+            top = matching[0]
+            for other in matching[1:]:
+                # If the top candidate can fail on a bit that the other one would accept, then that bit has to be in the
+                # key too, otherwise the other candidate would never be dispatched.
+                undecided = top[2] & ~key_bits & ~level1_mask & ~(other[2] & ~(top[3] ^ other[3]))
+                extra |= {n for n in range(32) if undecided >> n & 1}
+            table.append(top)
+        if not extra:
+            return fields, table
+        key |= extra
+
+
+def generate_cpp_tables(specs: List[Spec], extensions: str):
+    """Generates a C++ dispatcher that decodes with two constexpr table lookups."""
+
+    command_line = " ".join(sys.argv[0:])
+    name = f"rv32{extensions}"
+    requirements = " && ".join(f"IsRv32{x}Handler<Handler>" for x in extensions)
+
+    # The cascaded dispatcher tries bit patterns with the most fixed bits first, so use the same priority here.
+    groups = sorted(
+        {tuple((p.hi, p.lo) for p in spec.patterns) for spec in specs},
+        key=lambda x: (-count_bits(x), [tuple((p.hi, p.lo) for p in s.patterns) for s in specs].index(x)),
+    )
+    candidates = []
+    for index, spec in enumerate(specs):
+        priority = groups.index(tuple((p.hi, p.lo) for p in spec.patterns))
+        mask, match = fixed_bits(spec)
+        candidates.append((priority, index, mask, match))
+
+    # The first-level table is indexed by opcode[6:2] and funct3 for 32-bit instructions, followed by entries indexed by
+    # quadrant and funct3 for compressed instructions.
+    has_compressed = "c" in extensions
+    buckets = []
+    for index in range(256):
+        code = 0x3 | ((index & 0x1F) << 2) | ((index >> 5) << 12)
+        buckets.append((code, 0x707F))
+    if has_compressed:
+        for index in range(24):
+            code = (index >> 3) | ((index & 7) << 13)
+            buckets.append((code, 0xE003))
+
+    nodes = []
+    leaves = [None]  # Op 0 is illegal.
+    tables = dict()
+    for code, level1_mask in buckets:
+        matching = [c for c in candidates if (code & c[2] & level1_mask) == (c[3] & level1_mask)]
+        if not matching:
+            nodes.append((0, []))
+            continue
+        fields, table = make_decode_table(matching, level1_mask)
+        key = (tuple(fields), tuple(t[1] if t else None for t in table))
+        if key not in tables:
+            tables[key] = len(leaves)
+            leaves.extend(table)
+        nodes.append((tables[key], fields))
+
+    print(f"// This code was generated by `{command_line}`. Do not edit.")
+    print()
+    print("namespace impl")
+    print("{")
+    print(f"    // The decode tables for {name.upper()} instructions.")
+    print("    // clang-format off")
+    print(f"    inline constexpr std::array<DecodeNode, {len(nodes)}> {name}Nodes{{{{")
+    for node in nodes:
+        base, fields = node[0], node[1]
+        (hi1, lo1), (hi2, lo2) = (fields + [(-1, 0), (-1, 0)])[:2]
+        mask1, mask2 = (1 << (hi1 - lo1 + 1)) - 1, (1 << (hi2 - lo2 + 1)) - 1
+        print(f"        {{{base}, 0x{mask1:x}, 0x{mask2:x}, {lo1}, {hi1 - lo1 + 1}, {lo2}}},")
+    print("    }};")
+    print(f"    inline constexpr std::array<u8, {len(leaves)}> {name}Ops{{{{")
+    for i in range(0, len(leaves), 16):
+        row = ", ".join(str(leaf[1] + 1) if leaf else "0" for leaf in leaves[i : i + 16])
+        print(f"        {row},")
+    print("    }};")
+    print("    // clang-format on")
+    print("} // namespace impl")
+    print()
+
+    if has_compressed:
+        level1 = "(code & 3) == 3 ? ((code >> 2) & 0x1f) | ((code >> 7) & 0xe0) : 256 + (((code & 3) << 3) | ((code >> 13) & 7))"
+    else:
+        level1 = "((code >> 2) & 0x1f) | ((code >> 7) & 0xe0)"
+
+    print(f"""\
+// A table-driven dispatcher for RV32{extensions.upper()} instructions. BYO handler.
+template<typename Handler>
+    requires {requirements}
+struct Rv32{extensions}TableDispatcher : public Handler
+{{
+    using Item = typename Handler::Item;
+
+    // Decodes the input word to an RV32{extensions.upper()} instruction with two table lookups and dispatches it to a handler.
+    // clang-format off
+    auto Dispatch(u32 code) -> Item
+    {{
+        Handler& self = static_cast<Handler&>(*this);
+        Instruction c(code);
+
+        const auto& node = impl::{name}Nodes[{level1}];
+        switch (impl::{name}Ops[node.base + (((code >> node.shift1) & node.mask1) | (((code >> node.shift2) & node.mask2) << node.width1))]) {{""")
+    for index, spec in enumerate(specs):
+        # The tables only pick the instruction, so check the rest of its fixed bits here.
+        mask, match = fixed_bits(spec)
+        width = 8 if (match & 3) == 3 else 4
+        call = cpp_handler_call(spec.operator, spec.operands)
+        print(f"            case {index + 1}: return (code & 0x{mask:0{width}x}) == 0x{match:0{width}x} ? {call} : self.Illegal(code);")
+    print("""\
+        }
+        return self.Illegal(code);
+    }
+    // clang-format on
+};
+
+// End of auto-generated code.""")
+
+
 def parse_command_line():
     parser = argparse.ArgumentParser(
         description="Generate a RISC-V instruction dispatcher for the RV32I base ISA plus extensions."
@@ -476,6 +663,12 @@ def parse_command_line():
         action="append_const",
         const="m",
     )
+    parser.add_argument(
+        "--tables",
+        dest="tables",
+        help="Generate a dispatcher that decodes with constexpr lookup tables instead of cascaded switches (C++ only)",
+        action="store_true",
+    )
     parser.add_argument(
         dest="language",
         choices=["c++", "rust"],
@@ -503,7 +696,9 @@ def main():
     opcodes_to_parse = "\n".join(dispatchers[x] for x in args.extensions)
 
     specs = parse(opcodes_to_parse)
-    if args.language == "c++":
+    if args.language == "c++" and args.tables:
+        generate_cpp_tables(specs, args.extensions)
+    elif args.language == "c++":
         generate_cpp(specs, args.extensions)
     elif args.language == "rust":
         generate_rust(specs, args.extensions)